@@ -1,9 +1,12 @@
 #include "constants/TableConstants.hpp"
 #include "db/Database.hpp" // DatabaseException, std::string, std::vector, std::ostream (specialized by fmt to use operator<< with Database), std::span
+#include "db/HandStore.hpp"   // HandStore
 #include "db/SqlInsertor.hpp" // Game
+#include "db/SqlProfiler.hpp" // SqlProfiler, SqlStatementProfile
 #include "db/SqlSelector.hpp"
 #include "db/sqlQueries.hpp" // all the SQL queries
 #include "entities/Action.hpp"
+#include "entities/Card.hpp"
 #include "entities/Game.hpp" // Cashgame, Limit, Time, Tournament, Variant
 #include "entities/GameType.hpp"
 #include "entities/Hand.hpp" // std::array
@@ -12,6 +15,9 @@
 #include "filesystem/FileUtils.hpp" // phud::filesystem
 #include "language/Validator.hpp"
 #include "log/Logger.hpp" // fmt::format(), CURRENT_FILE_NAME
+#include "log/MemoryAccounting.hpp" // MemoryAccounting
+#include "log/Metrics.hpp" // Metrics
+#include "log/Tracer.hpp" // TraceSpan
 #include "statistics/PlayerStatistics.hpp"
 #include "statistics/TableStatistics.hpp"
 #include "threads/ThreadPool.hpp" // ThreadPool, Future
@@ -19,9 +25,13 @@
 #include <gsl/gsl>                       // gsl::not_null
 #include <sqlite3.h>                     // sqlite3*
 #include <stlab/concurrency/utility.hpp> // stlab::await
+#include <chrono>
+#include <cstdlib> // std::atoi
+#include <fstream> // std::ofstream
+#include <map>
 #include <mutex>
+#include <optional>
 #include <ranges>
-#include <utility> // std::forward
 
 // from sqlite3.h: 'The application does not need to worry about freeing the result.' So no need to
 // free the char* returned by sqlite3_errmsg().
@@ -29,8 +39,9 @@
 // FUTURE: the read query name, content, entity type, and callback should be linked.
 // FUTURE: use a cache
 
-static Logger& LOG() {
-  static auto logger = Logger(CURRENT_FILE_NAME);
+// hot path: the logging calls below PHUD_HOT_PATH_LOGGING_LEVEL are not compiled
+static MinLevelLogger<PHUD_HOT_PATH_LOGGING_LEVEL>& LOG() {
+  static auto logger = MinLevelLogger<PHUD_HOT_PATH_LOGGING_LEVEL>(CURRENT_FILE_NAME);
   return logger;
 }
 
@@ -73,6 +84,28 @@ namespace {
     }
   }
 
+  /**
+   * @returns the first column of the first row of the query result, as an int, 0 if there is none
+   * @throws DatabaseException if an error occurs
+   */
+  [[nodiscard]] int readInt(const gsl::not_null<sqlite3*> pDb, std::string_view sql) {
+    int ret = 0;
+    const auto readFirstColumn = [](void* pRet, int nbColumns, char** values, char**) {
+      if (0 < nbColumns and nullptr != values[0]) {
+        *static_cast<int*>(pRet) = std::atoi(values[0]);
+      }
+
+      return 0;
+    };
+
+    if (SQLITE_OK != sqlite3_exec(pDb, sql.data(), readFirstColumn, &ret, /*errorMsg*/ nullptr)) {
+      throw DatabaseException(fmt::format("Can't execute the query\n{}\nerror message:\n{}\n", sql,
+                                          sqlite3_errmsg(pDb)));
+    }
+
+    return ret;
+  }
+
   /**
    * @throws DatabaseException in case of problem getting the query SQL code or opening the database
    * file
@@ -97,6 +130,13 @@ namespace {
       std::ranges::for_each(phud::sql::CREATE_QUERIES,
                             [pDb](const auto& query) { executeSql(pDb, query); });
       LOG().info<"database created">();
+    } else {
+      executeSql(pDb, phud::sql::CREATE_HISTORY_FILE);
+
+      if (0 != readInt(pDb, phud::sql::IS_MISSING_UNIQUE_INDEXES)) {
+        LOG().info<"Removing the rows saved several times from the database {}">(name);
+        executeSql(pDb, phud::sql::CREATE_UNIQUE_INDEXES_AND_DELETE_DUPLICATES);
+      }
     }
 
     return pDb;
@@ -109,50 +149,53 @@ namespace {
           {{GameType::cashGame, phud::sql::INSERT_CASHGAME_HAND},
            {GameType::tournament, phud::sql::INSERT_TOURNAMENT_HAND}})};
 
-  void insertGame(const gsl::not_null<sqlite3*> db, const auto& g) {
+  // the SQL inserts of a game, built before taking the database lock
+  struct [[nodiscard]] GameInserts final {
+    // Memory layout optimized: largest to smallest to minimize padding
+    std::vector<std::string> m_queries {};
+    std::string m_gameId {};
+    std::size_t m_nbHands = 0;
+  }; // struct GameInserts
+
+  [[nodiscard]] std::string buildGameInsert(const auto& g) {
     static_assert(ps::contains(phud::sql::INSERT_GAME, '?'), "ill-formed SQL template");
-    executeSql(db, SqlInsertor(phud::sql::INSERT_GAME)
-                       .gameId(g.getId()) // use the tournament ID for the Game
-                       .siteName(g.getSiteName())
-                       .gameName(g.getName())
-                       .variant(g.getVariant())
-                       .limitType(g.getLimitType())
-                       .isRealMoney(g.isRealMoney())
-                       .nbMaxSeats(g.getMaxNbSeats())
-                       .startDate(g.getStartDate().toSqliteDate())
-                       .build());
-  }
-
-  void insertSpecificGame(const gsl::not_null<sqlite3*> db, const Tournament& t) {
+    return SqlInsertor(phud::sql::INSERT_GAME)
+        .gameId(g.getId()) // use the tournament ID for the Game
+        .siteName(g.getSiteName())
+        .gameName(g.getName())
+        .variant(g.getVariant())
+        .limitType(g.getLimitType())
+        .isRealMoney(g.isRealMoney())
+        .nbMaxSeats(g.getMaxNbSeats())
+        .startDate(g.getStartDate().toSqliteDate())
+        .build();
+  }
+
+  [[nodiscard]] std::string buildSpecificGameInsert(const Tournament& t) {
     LOG().info<"saving the tournament with id={}">(t.getId());
     static_assert(ps::contains(phud::sql::INSERT_TOURNAMENT, '?'), "ill-formed SQL template");
-    executeSql(db, SqlInsertor(phud::sql::INSERT_TOURNAMENT)
-                       .tournamentId(t.getId())
-                       .buyIn(t.getBuyIn())
-                       .build());
+    return SqlInsertor(phud::sql::INSERT_TOURNAMENT)
+        .tournamentId(t.getId())
+        .buyIn(t.getBuyIn())
+        .build();
   }
 
-  /**
-   * @throws DatabaseException if an error occurs during the insert
-   */
-  void insertSpecificGame(const gsl::not_null<sqlite3*> db, const CashGame& cg) {
+  [[nodiscard]] std::string buildSpecificGameInsert(const CashGame& cg) {
     LOG().info<"saving the cash game with id={}">(cg.getId());
     static_assert(ps::contains(phud::sql::INSERT_CASHGAME, '?'), "ill-formed SQL template");
-    executeSql(db, SqlInsertor(phud::sql::INSERT_CASHGAME)
-                       .cashGameId(cg.getId())
-                       .smallBlind(cg.getSmallBlind())
-                       .bigBlind(cg.getBigBlind())
-                       .build());
+    return SqlInsertor(phud::sql::INSERT_CASHGAME)
+        .cashGameId(cg.getId())
+        .smallBlind(cg.getSmallBlind())
+        .bigBlind(cg.getBigBlind())
+        .build();
   }
 
-  /**
-   * @throws DatabaseException if an error occurs during the insert
-   */
-  void saveActions(const gsl::not_null<sqlite3*> db, std::span<const Action* const> actions) {
+  void addActionsInsert(std::vector<std::string>& queries, const auto& actions) {
     if (actions.empty()) {
       return;
     }
 
+    const TraceSpan span {"saveActions"};
     static_assert(ps::contains(phud::sql::INSERT_ACTION, '?'), "ill-formed SQL template");
     SqlInsertor query {phud::sql::INSERT_ACTION};
     std::ranges::for_each(actions, [&query](const auto& pAction) {
@@ -164,33 +207,160 @@ namespace {
           .betAmount(pAction->getBetAmount())
           .newInsert();
     });
-    executeSql(db, query.build());
+    queries.push_back(query.build());
+  }
+
+  void insertHand(SqlInsertor& handInsert, const Hand& hand) {
+    handInsert.handId(hand.getId())
+        .siteName(hand.getSiteName())
+        .tableName(hand.getTableName())
+        .buttonSeat(hand.getButtonSeat())
+        .maxSeats(hand.getMaxSeats())
+        .level(hand.getLevel())
+        .ante(hand.getAnte())
+        .startDate(hand.getStartDate().toSqliteDate())
+        .heroCard1(hand.getHeroCard1())
+        .heroCard2(hand.getHeroCard2())
+        .heroCard3(hand.getHeroCard3())
+        .heroCard4(hand.getHeroCard4())
+        .heroCard5(hand.getHeroCard5())
+        .boardCard1(hand.getBoardCard1())
+        .boardCard2(hand.getBoardCard2())
+        .boardCard3(hand.getBoardCard3())
+        .boardCard4(hand.getBoardCard4())
+        .boardCard5(hand.getBoardCard5())
+        .newInsert();
   }
 
   /**
-   * @throws DatabaseException if an error occurs during the insert
+   * @throws IllegalArgumentException if a hand has no players
    */
-  void saveGame(const gsl::not_null<sqlite3*> db, const auto& game) {
+  void addHandsInserts(std::vector<std::string>& queries, std::string_view gameId,
+                       const auto& hands) {
+    if (hands.empty()) {
+      return;
+    }
+
+    const TraceSpan span {"saveHands"};
+    LOG().trace<"create insert queries">();
+    static_assert(ps::contains(phud::sql::INSERT_HAND, '?'), "ill-formed SQL template");
+    SqlInsertor handInsert {phud::sql::INSERT_HAND};
+    static_assert(ps::contains(phud::sql::INSERT_HAND_PLAYER, '?'), "ill-formed SQL template");
+    SqlInsertor handPlayerInsert {phud::sql::INSERT_HAND_PLAYER};
+    SqlInsertor gameHandInsert {
+        GAME_TYPE_TO_ID_AND_COLUMN_NAME.find(hands.front()->getGameType())->second};
+    std::ranges::for_each(hands, [&](const auto& pHand) {
+      insertHand(handInsert, *pHand);
+      const auto seats = pHand->getSeats();
+      validation::require(!std::ranges::all_of(seats, [](const auto& p) { return p.empty(); }),
+                          "trying to save a hand with no players");
+      std::ranges::for_each(seats | std::views::enumerate,
+                            [pHand, &handPlayerInsert](const auto& indexedPlayer) {
+                              const auto [index, playerName] = indexedPlayer;
+                              // we suppose the Player has been saved before this call
+                              if (!playerName.empty()) {
+                                handPlayerInsert.handId(pHand->getId())
+                                    .playerName(playerName)
+                                    .playerSeat(tableSeat::fromArrayIndex(index))
+                                    .isWinner(pHand->isWinner(playerName))
+                                    .newInsert();
+                              }
+                            });
+      gameHandInsert.gameId(gameId).handId(pHand->getId()).newInsert();
+    });
+    LOG().info<"insert hands for table {}">(hands.front()->getTableName());
+    queries.push_back(handInsert.build());
+    queries.push_back(handPlayerInsert.build());
+    queries.push_back(gameHandInsert.build());
+  }
+
+  /**
+   * @throws IllegalArgumentException if a hand has no players
+   */
+  [[nodiscard]] GameInserts buildGameInserts(const auto& game) {
     const auto hands = game.viewHands();
-    const auto gameId = game.getId();
-    insertGame(db, game);
-    insertSpecificGame(db, game);
-    LOG().info<"saving {} hands from the game with id={}">(hands.size(), gameId);
-    saveHands(db, gameId, hands);
-    std::ranges::for_each(hands, [db](const auto& h) {
+    GameInserts ret {.m_queries = {}, .m_gameId = game.getId(), .m_nbHands = hands.size()};
+    ret.m_queries.push_back(buildGameInsert(game));
+    ret.m_queries.push_back(buildSpecificGameInsert(game));
+    LOG().info<"saving {} hands from the game with id={}">(hands.size(), ret.m_gameId);
+    addHandsInserts(ret.m_queries, ret.m_gameId, hands);
+    std::ranges::for_each(hands, [&ret](const auto& h) {
       LOG().trace<"saving {} actions from hand with id={}">(h->viewActions().size(), h->getId());
-      saveActions(db, h->viewActions());
+      addActionsInsert(ret.m_queries, h->viewActions());
     });
+    return ret;
+  }
+
+  /**
+   * To be called with the database lock.
+   * @throws DatabaseException if an error occurs during the insert
+   */
+  void executeGameInserts(const gsl::not_null<sqlite3*> db, const GameInserts& inserts) {
+    std::ranges::for_each(inserts.m_queries, [db](const auto& query) { executeSql(db, query); });
+    Metrics::getNbHandsInserted().increment(inserts.m_nbHands);
+  }
+} // anonymous namespace
+
+namespace {
+  [[nodiscard]] std::unique_ptr<HandStore> newHandStore(std::string_view dbName) {
+    return (IN_MEMORY == dbName) ? nullptr
+                                 : std::make_unique<HandStore>(fs::path(dbName).concat(".hands"));
+  }
+
+  // the logical statements recorded by the SQL profiler
+  constexpr std::array<SqlProfiler::NamedStatement, 16> PROFILED_STATEMENTS {{
+      {"INSERT_SITE", phud::sql::INSERT_SITE},
+      {"INSERT_GAME", phud::sql::INSERT_GAME},
+      {"INSERT_TOURNAMENT", phud::sql::INSERT_TOURNAMENT},
+      {"INSERT_CASHGAME", phud::sql::INSERT_CASHGAME},
+      {"INSERT_TOURNAMENT_HAND", phud::sql::INSERT_TOURNAMENT_HAND},
+      {"INSERT_CASHGAME_HAND", phud::sql::INSERT_CASHGAME_HAND},
+      {"INSERT_HAND", phud::sql::INSERT_HAND},
+      {"INSERT_ACTION", phud::sql::INSERT_ACTION},
+      {"INSERT_PLAYER", phud::sql::INSERT_PLAYER},
+      {"INSERT_HAND_PLAYER", phud::sql::INSERT_HAND_PLAYER},
+      {"GET_STATS_BY_SITE_AND_PLAYER_NAME", phud::sql::GET_STATS_BY_SITE_AND_PLAYER_NAME},
+      {"GET_PREFLOP_STATS_BY_SITE_AND_TABLE_NAME",
+       phud::sql::GET_PREFLOP_STATS_BY_SITE_AND_TABLE_NAME},
+      {"GET_MAX_SEATS_BY_SITE_AND_TABLE_NAME", phud::sql::GET_MAX_SEATS_BY_SITE_AND_TABLE_NAME},
+      {"GET_HANDS_FOR_HAND_STORE", phud::sql::GET_HANDS_FOR_HAND_STORE},
+      {"GET_HAND_PLAYERS_FOR_HAND_STORE", phud::sql::GET_HAND_PLAYERS_FOR_HAND_STORE},
+      {"GET_ACTIONS_FOR_HAND_STORE", phud::sql::GET_ACTIONS_FOR_HAND_STORE}}};
+
+  void writeSqlProfiles(const SqlProfiler& profiler, std::string_view dbName) {
+    const auto report {profiler.toString()};
+    LOG().info<"SQL statements profile:\n{}">(report);
+
+    if (IN_MEMORY != dbName) {
+      const auto file {fs::path(dbName).concat(".sqlprofile.txt")};
+      std::ofstream os {file, std::ios::trunc};
+      os << report;
+
+      if (!os.flush()) {
+        LOG().error<"Couldn't write the SQL profile file {}">(file.string());
+      }
+    }
   }
 } // anonymous namespace
 
 struct [[nodiscard]] Database::Implementation final {
   std::string m_dbName;
   gsl::not_null<sqlite3*> m_database;
+  std::unique_ptr<HandStore> m_pHandStore;
+  std::unique_ptr<SqlProfiler> m_pSqlProfiler {};
+  // the observer id -> the observer
+  std::map<std::size_t, SiteObserverCallback> m_siteObservers {};
+  std::size_t m_nextSiteObserverId = 0;
+  // the connection is shared, so every statement of the public operations is run under this lock,
+  // the inserts of a site are built before taking it
+  std::mutex m_mutex {};
+  // held while the observers are called, so that a removed observer is not called anymore
+  std::mutex m_siteObserversMutex {};
 
   explicit Implementation(std::string_view dbName)
     : m_dbName {dbName},
-      m_database {createDatabase(dbName)} {}
+      m_database {createDatabase(dbName)},
+      m_pHandStore {newHandStore(dbName)} {}
 }; // struct  Database::Implementation
 
 class [[nodiscard]] Transaction final {
@@ -237,6 +407,17 @@ Database::Database(std::string_view name)
   : m_pImpl {std::make_unique<Implementation>(name)} {}
 
 Database::~Database() {
+  if (m_pImpl->m_pSqlProfiler) {
+    try {
+      writeSqlProfiles(*m_pImpl->m_pSqlProfiler, m_pImpl->m_dbName);
+    } catch (...) { // can't throw in a destructor
+      LOG().error<"Unknown error when writing the SQL profile.">();
+    }
+
+    // detaches the profiler from the connection before closing it
+    m_pImpl->m_pSqlProfiler.reset();
+  }
+
   if (SQLITE_OK != sqlite3_close(m_pImpl->m_database)) {
     LOG().error<"Unknown error when closing the database. Fetching the error message...">();
     try {
@@ -252,19 +433,24 @@ Database::~Database() {
  * @throws DatabaseException if an error occurs during the insert
  */
 void Database::save(const CashGame& game) const {
-  saveGame(m_pImpl->m_database, game);
+  const auto inserts {buildGameInserts(game)};
+  const std::scoped_lock lock {m_pImpl->m_mutex};
+  executeGameInserts(m_pImpl->m_database, inserts);
 }
 
 /**
  * @throws DatabaseException if an error occurs during the insert
  */
 void Database::save(const Tournament& game) const {
-  saveGame(m_pImpl->m_database, game);
+  const auto inserts {buildGameInserts(game)};
+  const std::scoped_lock lock {m_pImpl->m_mutex};
+  executeGameInserts(m_pImpl->m_database, inserts);
 }
 
-void Database::save(std::span<const Player* const> players) const {
+// @returns nothing if there is no player
+static std::string buildPlayersInsert(const auto& players) {
   if (players.empty()) {
-    return;
+    return {};
   }
 
   static_assert(ps::contains(phud::sql::INSERT_PLAYER, '?'), "ill-formed SQL template");
@@ -276,7 +462,17 @@ void Database::save(std::span<const Player* const> players) const {
         .comments(p->getComments())
         .newInsert();
   });
-  executeSql(m_pImpl->m_database, query.build());
+  return query.build();
+}
+
+/**
+ * @throws DatabaseException if an error occurs during the insert
+ */
+void Database::save(std::span<const Player* const> players) const {
+  if (const auto query {buildPlayersInsert(players)}; !query.empty()) {
+    const std::scoped_lock lock {m_pImpl->m_mutex};
+    executeSql(m_pImpl->m_database, query);
+  }
 }
 
 /**
@@ -288,107 +484,108 @@ static void saveSite(const gsl::not_null<sqlite3*> pDb, const Site& s) {
   executeSql(pDb, SqlInsertor(phud::sql::INSERT_SITE).siteName(s.getName()).build());
 }
 
-template <typename T>
-static std::vector<Future<void>> saveGamesAsync(std::span<const T* const> games, Database& self) {
-  std::vector<Future<void>> ret;
+// the inserts are built in parallel, without the database lock, the games that can't be saved are
+// logged and skipped
+static std::vector<Future<std::optional<GameInserts>>> buildGameInsertsAsync(const auto& games) {
+  std::vector<Future<std::optional<GameInserts>>> ret;
   ret.reserve(games.size());
-  std::transform(games.cbegin(), games.cend(), std::back_inserter(ret), [&self](const auto& pGame) {
-    return ThreadPool::submit([pGame, &self]() {
-      const auto gameId = pGame->getId();
-
-      try {
-        self.save(*pGame);
-      } catch (const std::exception& e) {
-        LOG().error<"Couldn't save the game with id='{}': {}">(gameId, e.what());
-      } catch (...) {
-        LOG().error<"Couldn't save the game with id='{}': unknown error">(gameId);
-      }
-    });
+  std::ranges::transform(games, std::back_inserter(ret), [](const auto& pGame) {
+    return ThreadPool::submit(
+        ThreadPool::TaskCategory::dbSave, [pGame]() -> std::optional<GameInserts> {
+          try {
+            return buildGameInserts(*pGame);
+          } catch (const std::exception& e) {
+            LOG().error<"Couldn't save the game with id='{}': {}">(pGame->getId(), e.what());
+          } catch (...) {
+            LOG().error<"Couldn't save the game with id='{}': unknown error">(pGame->getId());
+          }
+          return std::nullopt;
+        });
   });
   return ret;
 }
 
-/**
- * @throws DatabaseException if an error occurs during the insert
- */
-void Database::save(const Site& site) {
-  Transaction transaction {m_pImpl->m_database};
-  saveSite(m_pImpl->m_database, site);
-  save(site.viewPlayers());
-  const auto cashGames = site.viewCashGames();
-  const auto tournaments = site.viewTournaments();
-  auto tasks1 = saveGamesAsync(std::span {cashGames}, *this);
-  auto tasks2 = saveGamesAsync(std::span {tournaments}, *this);
-  std::ranges::for_each(tasks1,
-                        [](auto&& task) { stlab::await(std::forward<Future<void>>(task)); });
-  std::ranges::for_each(tasks2,
-                        [](auto&& task) { stlab::await(std::forward<Future<void>>(task)); });
-  transaction.commit();
-}
+// To be called with the database lock, in the transaction of the site.
+static void executeGameInserts(const gsl::not_null<sqlite3*> db,
+                               std::span<const std::optional<GameInserts>> games) {
+  std::ranges::for_each(games, [db](const auto& inserts) {
+    if (!inserts.has_value()) {
+      return;
+    }
 
-static void insertHand(SqlInsertor& handInsert, const Hand& hand) {
-  handInsert.handId(hand.getId())
-      .siteName(hand.getSiteName())
-      .tableName(hand.getTableName())
-      .buttonSeat(hand.getButtonSeat())
-      .maxSeats(hand.getMaxSeats())
-      .level(hand.getLevel())
-      .ante(hand.getAnte())
-      .startDate(hand.getStartDate().toSqliteDate())
-      .heroCard1(hand.getHeroCard1())
-      .heroCard2(hand.getHeroCard2())
-      .heroCard3(hand.getHeroCard3())
-      .heroCard4(hand.getHeroCard4())
-      .heroCard5(hand.getHeroCard5())
-      .boardCard1(hand.getBoardCard1())
-      .boardCard2(hand.getBoardCard2())
-      .boardCard3(hand.getBoardCard3())
-      .boardCard4(hand.getBoardCard4())
-      .boardCard5(hand.getBoardCard5())
-      .newInsert();
+    try {
+      executeGameInserts(db, *inserts);
+    } catch (const std::exception& e) {
+      LOG().error<"Couldn't save the game with id='{}': {}">(inserts->m_gameId, e.what());
+    }
+  });
 }
 
 /**
  * @throws DatabaseException if an error occurs during the insert
  */
-static void saveHands(const gsl::not_null<sqlite3*> db, std::string_view gameId,
-                      std::span<const Hand* const> hands) {
-  if (hands.empty()) {
-    return;
-  }
+void Database::save(const Site& site) {
+  const TraceSpan span {"Database::save"};
+  // builds the inserts before taking the lock, so that the lock is never held while waiting for
+  // the thread pool
+  auto tasks1 = buildGameInsertsAsync(site.viewCashGames());
+  auto tasks2 = buildGameInsertsAsync(site.viewTournaments());
+  std::vector<std::optional<GameInserts>> games;
+  games.reserve(tasks1.size() + tasks2.size());
+  std::ranges::for_each(std::array {&tasks1, &tasks2}, [&games](auto* pTasks) {
+    std::ranges::transform(*pTasks, std::back_inserter(games), [](auto& task) {
+      return stlab::await(std::move(task));
+    });
+  });
+  const auto players {buildPlayersInsert(site.viewPlayers())};
+  {
+    const std::scoped_lock lock {m_pImpl->m_mutex};
+    const auto start {std::chrono::steady_clock::now()};
+    Transaction transaction {m_pImpl->m_database};
+    saveSite(m_pImpl->m_database, site);
+
+    if (!players.empty()) {
+      executeSql(m_pImpl->m_database, players);
+    }
+
+    executeGameInserts(m_pImpl->m_database, games);
+    transaction.commit();
+    Metrics::getDbTransactionLatency().observe(std::chrono::steady_clock::now() - start);
+    MemoryAccounting::set(MemorySubsystem::sqlite,
+                          {.m_nbBytes = static_cast<std::size_t>(sqlite3_memory_used()),
+                           .m_nbObjects = 0});
 
-  LOG().trace<"create insert queries">();
-  static_assert(ps::contains(phud::sql::INSERT_HAND, '?'), "ill-formed SQL template");
-  SqlInsertor handInsert {phud::sql::INSERT_HAND};
-  static_assert(ps::contains(phud::sql::INSERT_HAND_PLAYER, '?'), "ill-formed SQL template");
-  SqlInsertor handPlayerInsert {phud::sql::INSERT_HAND_PLAYER};
-  SqlInsertor gameHandInsert {
-      GAME_TYPE_TO_ID_AND_COLUMN_NAME.find(gsl::at(hands, 0)->getGameType())->second};
-  std::ranges::for_each(hands, [&](const auto& pHand) {
-    insertHand(handInsert, *pHand);
-    const auto seats = pHand->getSeats();
-    validation::require(!std::ranges::all_of(seats, [](const auto& p) { return p.empty(); }),
-                        "trying to save a hand with no players");
-    std::ranges::for_each(seats | std::views::enumerate,
-                          [pHand, &handPlayerInsert](const auto& indexedPlayer) {
-                            const auto [index, playerName] = indexedPlayer;
-                            // we suppose the Player has been saved before this call
-                            if (!playerName.empty()) {
-                              handPlayerInsert.handId(pHand->getId())
-                                  .playerName(playerName)
-                                  .playerSeat(tableSeat::fromArrayIndex(index))
-                                  .isWinner(pHand->isWinner(playerName))
-                                  .newInsert();
-                            }
-                          });
-    gameHandInsert.gameId(gameId).handId(pHand->getId()).newInsert();
+    // the hand store is a cache that can be rebuilt, so its errors do not fail the save
+    if (m_pImpl->m_pHandStore) {
+      try {
+        m_pImpl->m_pHandStore->append(site);
+      } catch (const std::exception& e) {
+        LOG().error<"Couldn't write the hand store {}: {}">(
+            m_pImpl->m_pHandStore->getFile().string(), e.what());
+      }
+    }
+  }
+  // the observers are called without the database lock, so that they don't delay the other saves
+  const std::scoped_lock lock {m_pImpl->m_siteObserversMutex};
+  std::ranges::for_each(m_pImpl->m_siteObservers | std::views::values, [&site](const auto& cb) {
+    try {
+      cb(site);
+    } catch (const std::exception& e) {
+      LOG().error<"A site observer failed: {}">(e.what());
+    }
   });
-  LOG().trace<"run insert queries">();
-  LOG().info<"insert hands for table {}">(hands.front()->getTableName());
-  executeSql(db, handInsert.build());
-  executeSql(db, handPlayerInsert.build());
-  executeSql(db, gameHandInsert.build());
-  LOG().trace<"exit saveHands()">();
+}
+
+/*[[nodiscard]]*/ std::size_t Database::addSiteObserver(SiteObserverCallback observerCb) {
+  const std::scoped_lock lock {m_pImpl->m_siteObserversMutex};
+  const auto ret {m_pImpl->m_nextSiteObserverId++};
+  m_pImpl->m_siteObservers.emplace(ret, std::move(observerCb));
+  return ret;
+}
+
+void Database::removeSiteObserver(std::size_t observerId) {
+  const std::scoped_lock lock {m_pImpl->m_siteObserversMutex};
+  m_pImpl->m_siteObservers.erase(observerId);
 }
 
 enum class /*[[nodiscard]]*/ QueryResult : std::uint8_t { NO_MORE_ROWS, ONE_ROW_OR_MORE };
@@ -453,6 +650,10 @@ public:
     return sqlite3_column_int(m_pStatement, column);
   }
 
+  [[nodiscard]] std::int64_t getColumnAsInt64(int column) const noexcept {
+    return sqlite3_column_int64(m_pStatement, column);
+  }
+
   [[nodiscard]] double getColumnAsDouble(int column) const noexcept {
     return sqlite3_column_double(m_pStatement, column);
   }
@@ -468,16 +669,22 @@ public:
   [[nodiscard]] bool getColumnAsBool(int column) const noexcept {
     return 0 != getColumnAsInt(column);
   }
+
+  [[nodiscard]] bool isColumnNull(int column) const noexcept {
+    return SQLITE_NULL == sqlite3_column_type(m_pStatement, column);
+  }
 }; // class PreparedStatement
 
-Seat Database::getTableMaxSeat(std::string_view site, std::string_view table) const {
+// To be called with the database lock.
+static Seat readTableMaxSeat(const gsl::not_null<sqlite3*> db, std::string_view site,
+                            std::string_view table) {
   static_assert(ps::contains(phud::sql::GET_MAX_SEATS_BY_SITE_AND_TABLE_NAME, '?'),
                 "ill-formed SQL template");
   const auto& sql {SqlSelector(phud::sql::GET_MAX_SEATS_BY_SITE_AND_TABLE_NAME)
                        .site(site)
                        .table(table)
                        .toString()};
-  PreparedStatement p {m_pImpl->m_database, sql};
+  PreparedStatement p {db, sql};
 
   if (QueryResult::NO_MORE_ROWS == p.execute()) {
     return Seat::seatUnknown;
@@ -488,6 +695,11 @@ Seat Database::getTableMaxSeat(std::string_view site, std::string_view table) co
   return tableSeat::fromInt(p.getColumnAsInt(0));
 }
 
+Seat Database::getTableMaxSeat(std::string_view site, std::string_view table) const {
+  const std::scoped_lock lock {m_pImpl->m_mutex};
+  return readTableMaxSeat(m_pImpl->m_database, site, table);
+}
+
 static std::array<std::unique_ptr<PlayerStatistics>, TableConstants::MAX_SEATS>
 readTableStatisticsQuery(PreparedStatement& p) {
   static_assert(ps::contains(phud::sql::GET_PREFLOP_STATS_BY_SITE_AND_TABLE_NAME, '?'),
@@ -533,6 +745,7 @@ Database::readPlayerStatistics(std::string_view site, std::string_view playerNam
                        .site(site)
                        .player(playerName)
                        .toString()};
+  const std::scoped_lock lock {m_pImpl->m_mutex};
   PreparedStatement p {m_pImpl->m_database, sql};
 
   if (QueryResult::NO_MORE_ROWS == p.execute()) {
@@ -554,12 +767,168 @@ Database::readPlayerStatistics(std::string_view site, std::string_view playerNam
 }
 
 TableStatistics Database::readTableStatistics(std::string_view site, std::string_view table) const {
+  const TraceSpan span {"readTableStatistics"};
   const auto& sql {SqlSelector(phud::sql::GET_PREFLOP_STATS_BY_SITE_AND_TABLE_NAME)
                        .site(site)
                        .table(table)
                        .toString()};
+  const std::scoped_lock lock {m_pImpl->m_mutex};
   PreparedStatement p {m_pImpl->m_database, sql};
-  return TableStatistics {site, table, getTableMaxSeat(site, table), readTableStatisticsQuery(p)};
+  return TableStatistics {site, table, readTableMaxSeat(m_pImpl->m_database, site, table),
+                         readTableStatisticsQuery(p)};
+}
+
+static Card getColumnAsCard(PreparedStatement& p, int column) {
+  return p.isColumnNull(column) ? Card::none : toCard(p.getColumnAsString(column));
+}
+
+static HandStore::HandRecord toHandRecord(PreparedStatement& hands, std::string_view handId) {
+  const auto startDate = hands.getColumnAsString(5);
+  const auto toCards = [&hands](int firstColumn) {
+    std::array<std::uint8_t, TableConstants::MAX_CARDS> ret {};
+    std::ranges::generate(ret, [&hands, column = firstColumn]() mutable {
+      return static_cast<std::uint8_t>(getColumnAsCard(hands, column++));
+    });
+    return ret;
+  };
+  HandStore::HandRecord ret {
+      .m_handIdHash = HandStore::hashHandId(handId),
+      .m_firstAction = 0,
+      .m_startDate = Time({.strTime = startDate, .format = SQLITE_DATE_FORMAT}).toEpochSeconds(),
+      .m_ante = hands.getColumnAsInt(4),
+      .m_seatPlayers = {},
+      .m_level = hands.getColumnAsInt(3),
+      .m_nbActions = 0,
+      .m_winners = 0,
+      .m_heroCards = toCards(6),
+      .m_boardCards = toCards(11),
+      .m_buttonSeat = static_cast<std::uint8_t>(tableSeat::fromInt(hands.getColumnAsInt(1))),
+      .m_maxSeats = static_cast<std::uint8_t>(tableSeat::fromInt(hands.getColumnAsInt(2))),
+      .m_gameType = static_cast<std::uint8_t>(hands.getColumnAsBool(16) ? GameType::tournament
+                                                                         : GameType::cashGame),
+      .m_reserved = {}};
+  ret.m_seatPlayers.fill(HandStore::NO_PLAYER);
+  return ret;
+}
+
+std::size_t Database::rebuildHandStore() {
+  validation::require(nullptr != m_pImpl->m_pHandStore, "an in memory database has no hand store");
+  const std::scoped_lock lock {m_pImpl->m_mutex};
+  const auto file = m_pImpl->m_pHandStore->getFile();
+  LOG().info<"Rebuilding the hand store {}">(file.string());
+  m_pImpl->m_pHandStore.reset();
+  HandStore::remove(file);
+  m_pImpl->m_pHandStore = std::make_unique<HandStore>(file);
+  auto& store = *m_pImpl->m_pHandStore;
+  // the 3 queries are ordered by hand id, so they are read side by side in a single pass
+  PreparedStatement hands {m_pImpl->m_database, phud::sql::GET_HANDS_FOR_HAND_STORE};
+  PreparedStatement handPlayers {m_pImpl->m_database, phud::sql::GET_HAND_PLAYERS_FOR_HAND_STORE};
+  PreparedStatement actions {m_pImpl->m_database, phud::sql::GET_ACTIONS_FOR_HAND_STORE};
+  auto hasHandPlayer = QueryResult::ONE_ROW_OR_MORE == handPlayers.execute();
+  auto hasAction = QueryResult::ONE_ROW_OR_MORE == actions.execute();
+  std::vector<HandStore::ActionRecord> actionRecords;
+
+  while (QueryResult::ONE_ROW_OR_MORE == hands.execute()) {
+    const auto handId = hands.getColumnAsString(0);
+    auto hand = toHandRecord(hands, handId);
+
+    for (; hasHandPlayer and handPlayers.getColumnAsString(0) <= handId;
+         hasHandPlayer = QueryResult::ONE_ROW_OR_MORE == handPlayers.execute()) {
+      if (handPlayers.getColumnAsString(0) == handId) {
+        const auto seatIndex =
+            tableSeat::toArrayIndex(tableSeat::fromInt(handPlayers.getColumnAsInt(2)));
+        hand.m_seatPlayers.at(seatIndex) = store.getPlayerId(handPlayers.getColumnAsString(1));
+
+        if (handPlayers.getColumnAsBool(3)) {
+          hand.m_winners = gsl::narrow_cast<std::uint16_t>(hand.m_winners | (1U << seatIndex));
+        }
+      }
+    }
+
+    actionRecords.clear();
+
+    for (; hasAction and actions.getColumnAsString(0) <= handId;
+         hasAction = QueryResult::ONE_ROW_OR_MORE == actions.execute()) {
+      if (actions.getColumnAsString(0) == handId) {
+        actionRecords.push_back(HandStore::ActionRecord {
+            .m_betAmount = HandStore::toAmount(actions.getColumnAsDouble(5)),
+            .m_player = store.getPlayerId(actions.getColumnAsString(1)),
+            .m_index = gsl::narrow_cast<std::uint16_t>(actions.getColumnAsInt(4)),
+            .m_street = static_cast<std::uint8_t>(toStreet(actions.getColumnAsString(2))),
+            .m_type = static_cast<std::uint8_t>(toActionType(actions.getColumnAsString(3)))});
+      }
+    }
+
+    store.append(hand, actionRecords);
+  }
+
+  store.flush();
+  LOG().info<"{} hands in the hand store {}">(store.getNbHands(), file.string());
+  return store.getNbHands();
+}
+
+void Database::save(std::span<const HistoryFileStamp> stamps) {
+  if (stamps.empty()) {
+    return;
+  }
+
+  static_assert(ps::contains(phud::sql::INSERT_HISTORY_FILE, '?'), "ill-formed SQL template");
+  SqlInsertor query {phud::sql::INSERT_HISTORY_FILE};
+  std::ranges::for_each(stamps, [&query](const auto& stamp) {
+    query.fileName(stamp.m_fileName)
+        .fileSize(stamp.m_size)
+        .lastWriteTime(stamp.m_lastWriteTime)
+        .newInsert();
+  });
+  const std::scoped_lock lock {m_pImpl->m_mutex};
+  executeSql(m_pImpl->m_database, query.build());
+}
+
+std::vector<HistoryFileStamp> Database::readHistoryFileStamps() const {
+  const std::scoped_lock lock {m_pImpl->m_mutex};
+  PreparedStatement p {m_pImpl->m_database, phud::sql::GET_HISTORY_FILES};
+  std::vector<HistoryFileStamp> ret;
+
+  while (QueryResult::ONE_ROW_OR_MORE == p.execute()) {
+    ret.push_back({.m_fileName = p.getColumnAsString(0),
+                   .m_size = p.getColumnAsInt64(1),
+                   .m_lastWriteTime = p.getColumnAsInt64(2)});
+  }
+
+  return ret;
+}
+
+std::size_t Database::getNbHands() const {
+  const std::scoped_lock lock {m_pImpl->m_mutex};
+  PreparedStatement p {m_pImpl->m_database, phud::sql::GET_NB_HANDS};
+  return QueryResult::ONE_ROW_OR_MORE == p.execute()
+             ? static_cast<std::size_t>(p.getColumnAsInt64(0))
+             : 0;
+}
+
+std::size_t Database::getNbActions() const {
+  const std::scoped_lock lock {m_pImpl->m_mutex};
+  PreparedStatement p {m_pImpl->m_database, phud::sql::GET_NB_ACTIONS};
+  return QueryResult::ONE_ROW_OR_MORE == p.execute()
+             ? static_cast<std::size_t>(p.getColumnAsInt64(0))
+             : 0;
+}
+
+fs::path Database::getHandStoreFile() const {
+  return m_pImpl->m_pHandStore ? m_pImpl->m_pHandStore->getFile() : fs::path();
+}
+
+void Database::enableSqlProfiling() {
+  if (!m_pImpl->m_pSqlProfiler) {
+    LOG().info<"Profiling the SQL statements of the database {}">(m_pImpl->m_dbName);
+    m_pImpl->m_pSqlProfiler =
+        std::make_unique<SqlProfiler>(m_pImpl->m_database, PROFILED_STATEMENTS);
+  }
+}
+
+std::vector<SqlStatementProfile> Database::getSqlProfiles() const {
+  return m_pImpl->m_pSqlProfiler ? m_pImpl->m_pSqlProfiler->getProfiles()
+                                 : std::vector<SqlStatementProfile>();
 }
 
 std::string Database::getDbName() const noexcept {
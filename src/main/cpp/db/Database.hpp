@@ -1,8 +1,13 @@
 #pragma once
 
 #include "language/PhudException.hpp" // std::string_view
+#include <cstdint>                    // std::int64_t
+#include <filesystem>                 // std::filesystem::path
+#include <functional>                 // std::function
 #include <memory>
 #include <span>
+#include <string>
+#include <vector>
 
 // forward declarations
 class CashGame;
@@ -11,10 +16,24 @@ class PlayerStatistics;
 class Site;
 class Tournament;
 enum class Seat : short;
+struct SqlStatementProfile;
 struct TableStatistics;
 
 /**
- * The database where each entity is persisted.
+ * The state of a history file when it was imported, to tell whether it changed since.
+ */
+struct [[nodiscard]] HistoryFileStamp final {
+  // Memory layout optimized: largest to smallest to minimize padding
+  std::string m_fileName;
+  std::int64_t m_size;
+  std::int64_t m_lastWriteTime; // in the file clock ticks
+
+  [[nodiscard]] bool operator==(const HistoryFileStamp&) const = default;
+}; // struct HistoryFileStamp
+
+/**
+ * The database where each entity is persisted. Every operation can be called from several threads:
+ * their statements are run one after the other.
  */
 class [[nodiscard]] Database final {
 private:
@@ -22,6 +41,8 @@ private:
   std::unique_ptr<Implementation> m_pImpl;
 
 public:
+  using SiteObserverCallback = std::function<void(const Site&)>;
+
   /**
    * Creates a data access layer object, in memory: no file is created.
    * The database will be deleted when the created object is destroyed.
@@ -45,6 +66,10 @@ public:
   Database& operator=(Database&&) = delete;
 
   ~Database();
+  /**
+   * Saves the site, then calls the site observers from the saving thread.
+   * @throws DatabaseException if an error occurs during the insert
+   */
   void save(const Site& site);
   void save(const CashGame& game) const;
   void save(const Tournament& game) const;
@@ -57,6 +82,50 @@ public:
    */
   [[nodiscard]] TableStatistics readTableStatistics(std::string_view site,
                                                     std::string_view table) const;
+  /**
+   * Records the state of the given history files, once their hands are saved.
+   * @throws DatabaseException if an error occurs during the insert
+   */
+  void save(std::span<const HistoryFileStamp> stamps);
+  /**
+   * @returns the state of the history files recorded by save()
+   */
+  [[nodiscard]] std::vector<HistoryFileStamp> readHistoryFileStamps() const;
+  [[nodiscard]] std::size_t getNbHands() const;
+  [[nodiscard]] std::size_t getNbActions() const;
+  /**
+   * @returns the file of the binary hand store written alongside the database by save(), or an
+   * empty path for an in memory database.
+   */
+  [[nodiscard]] std::filesystem::path getHandStoreFile() const;
+  /**
+   * Recreates the binary hand store from the hands saved in the database. Waits for the running
+   * save() if any.
+   * @returns the number of hands in the hand store.
+   * @throws DatabaseException if an error occurs during the database reading
+   */
+  std::size_t rebuildHandStore();
+  /**
+   * Calls the given callback each time a site is saved, whatever the saving service, so that the
+   * data kept in memory can be fed with the new hands.
+   * @returns the id to give to removeSiteObserver()
+   */
+  [[nodiscard]] std::size_t addSiteObserver(SiteObserverCallback observerCb);
+  /**
+   * Waits for the running calls of the given observer, then forgets it.
+   */
+  void removeSiteObserver(std::size_t observerId);
+  /**
+   * Starts recording, for each logical SQL statement, the number of calls and rows, the total and
+   * p99 durations and the SQLite statement counters. The profiles are logged when the database is
+   * closed, and written to '<database file>.sqlprofile.txt' for a database file.
+   */
+  void enableSqlProfiling();
+  /**
+   * @returns the statement profiles recorded since enableSqlProfiling(), the longest total time
+   * first, or nothing if the profiling is not enabled.
+   */
+  [[nodiscard]] std::vector<SqlStatementProfile> getSqlProfiles() const;
   [[nodiscard]] std::string getDbName() const noexcept;
   [[nodiscard]] bool isInMemory() const noexcept;
 
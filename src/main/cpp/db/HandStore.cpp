@@ -0,0 +1,398 @@
+#include "db/HandStore.hpp" // HandStore, std::filesystem::path, std::span, std::vector
+#include "entities/Action.hpp"
+#include "entities/Card.hpp"
+#include "entities/Game.hpp" // CashGame, Tournament
+#include "entities/GameType.hpp"
+#include "entities/Hand.hpp"
+#include "entities/Seat.hpp"
+#include "entities/Site.hpp"
+#include "filesystem/FileUtils.hpp" // phud::filesystem
+#include "log/Logger.hpp"           // CURRENT_FILE_NAME, fmt::format
+#include <gsl/gsl>                  // gsl::narrow_cast
+#include <cmath>                    // std::llround
+#include <fstream>                  // std::ifstream, std::ofstream
+#include <mutex>
+#include <numeric>                  // std::transform_reduce
+#include <unordered_map>
+#include <unordered_set>
+
+static Logger& LOG() {
+  static auto logger = Logger(CURRENT_FILE_NAME);
+  return logger;
+}
+
+namespace fs = std::filesystem;
+namespace pf = phud::filesystem;
+
+static_assert(std::is_trivially_copyable_v<HandStore::HandRecord>);
+static_assert(std::is_trivially_copyable_v<HandStore::ActionRecord>);
+static_assert(96 == sizeof(HandStore::HandRecord), "the hand file layout has changed");
+static_assert(16 == sizeof(HandStore::ActionRecord), "the action file layout has changed");
+
+namespace {
+  [[nodiscard]] fs::path toActionFile(const fs::path& file) {
+    return fs::path(file).concat(".actions");
+  }
+
+  [[nodiscard]] fs::path toPlayerFile(const fs::path& file) {
+    return fs::path(file).concat(".players");
+  }
+
+  /**
+   * @returns the number of complete records in the given file, without modifying it: the
+   * incomplete record a crash or a running append may have left at its end is ignored.
+   */
+  template <typename RECORD>
+  [[nodiscard]] std::size_t countWholeRecords(const fs::path& file) {
+    return pf::isFile(file) ? fs::file_size(file) / sizeof(RECORD) : 0;
+  }
+
+  /**
+   * Removes the incomplete record a crash may have left at the end of the given file. Only done by
+   * the writer, a reader could cut the record being appended.
+   * @returns the number of complete records in the file.
+   */
+  template <typename RECORD>
+  std::size_t truncateToWholeRecords(const fs::path& file) {
+    if (!pf::isFile(file)) {
+      return 0;
+    }
+
+    const auto size = fs::file_size(file);
+
+    if (0 != size % sizeof(RECORD)) {
+      LOG().warn<"Removing an incomplete record at the end of {}">(file.string());
+      fs::resize_file(file, size - size % sizeof(RECORD));
+    }
+
+    return size / sizeof(RECORD);
+  }
+
+  // removes the records after the given number of records
+  template <typename RECORD>
+  void truncateToRecords(const fs::path& file, std::size_t nbRecords) {
+    if (pf::isFile(file) and nbRecords * sizeof(RECORD) < fs::file_size(file)) {
+      LOG().warn<"Removing the records without their actions at the end of {}">(file.string());
+      fs::resize_file(file, nbRecords * sizeof(RECORD));
+    }
+  }
+
+  /**
+   * @throws HandStoreException if the file can't be read
+   */
+  template <typename RECORD>
+  [[nodiscard]] std::vector<RECORD> readRecords(const fs::path& file) {
+    std::vector<RECORD> ret(countWholeRecords<RECORD>(file));
+
+    if (ret.empty()) {
+      return ret;
+    }
+
+    std::ifstream in {file, std::ios::binary};
+    in.read(reinterpret_cast<char*>(ret.data()),
+            gsl::narrow_cast<std::streamsize>(ret.size() * sizeof(RECORD)));
+
+    if (!in) {
+      throw HandStoreException(fmt::format("Can't read the hand store file '{}'", file.string()));
+    }
+
+    return ret;
+  }
+
+  /**
+   * Reads the records of the given file by chunks, to bound the memory usage.
+   * @throws HandStoreException if the file can't be read
+   */
+  template <typename RECORD>
+  void forEachRecord(const fs::path& file, auto&& onRecord) {
+    constexpr std::size_t CHUNK_SIZE {4096};
+    std::size_t nbRecordsLeft {countWholeRecords<RECORD>(file)};
+
+    if (0 == nbRecordsLeft) {
+      return;
+    }
+
+    std::ifstream in {file, std::ios::binary};
+    std::vector<RECORD> chunk(std::min(CHUNK_SIZE, nbRecordsLeft));
+
+    while (0 < nbRecordsLeft) {
+      const auto nbRecords = std::min(chunk.size(), nbRecordsLeft);
+
+      if (!in.read(reinterpret_cast<char*>(chunk.data()),
+                   gsl::narrow_cast<std::streamsize>(nbRecords * sizeof(RECORD)))) {
+        throw HandStoreException(fmt::format("Can't read the hand store file '{}'", file.string()));
+      }
+
+      std::ranges::for_each(std::span(chunk).first(nbRecords), onRecord);
+      nbRecordsLeft -= nbRecords;
+    }
+  }
+
+  [[nodiscard]] std::vector<std::string> readPlayerNames(const fs::path& file) {
+    std::vector<std::string> ret;
+
+    if (!pf::isFile(file)) {
+      return ret;
+    }
+
+    std::ifstream in {file, std::ios::binary};
+
+    for (std::string line; std::getline(in, line);) {
+      if (in.eof()) { // a crash may have left a player name without its end of line
+        break;
+      }
+
+      ret.push_back(std::move(line));
+    }
+
+    return ret;
+  }
+
+  // removes the incomplete player name a crash may have left at the end of the given file
+  void truncateToWholeLines(const fs::path& file, std::span<const std::string> playerNames) {
+    const auto size {std::transform_reduce(playerNames.begin(), playerNames.end(),
+                                           std::uintmax_t {0}, std::plus {},
+                                           [](const auto& name) { return name.size() + 1; })};
+
+    if (pf::isFile(file) and size < fs::file_size(file)) {
+      LOG().warn<"Removing an incomplete player name at the end of {}">(file.string());
+      fs::resize_file(file, size);
+    }
+  }
+
+  template <typename RECORD>
+  void write(std::ofstream& out, std::span<const RECORD> records) {
+    out.write(reinterpret_cast<const char*>(records.data()),
+              gsl::narrow_cast<std::streamsize>(records.size_bytes()));
+  }
+
+  [[nodiscard]] std::array<std::uint8_t, TableConstants::MAX_CARDS>
+  toCardValues(Card c1, Card c2, Card c3, Card c4, Card c5) noexcept {
+    return {static_cast<std::uint8_t>(c1), static_cast<std::uint8_t>(c2),
+            static_cast<std::uint8_t>(c3), static_cast<std::uint8_t>(c4),
+            static_cast<std::uint8_t>(c5)};
+  }
+} // anonymous namespace
+
+struct [[nodiscard]] HandStore::Implementation final {
+  std::mutex m_mutex {};
+  fs::path m_file;
+  std::unordered_map<std::string, PlayerId> m_playerIds {};
+  std::unordered_set<std::uint64_t> m_handIdHashes {};
+  std::ofstream m_hands {};
+  std::ofstream m_actions {};
+  std::ofstream m_players {};
+  std::uint64_t m_nbActions = 0;
+
+  explicit Implementation(const fs::path& file)
+    : m_file {file} {
+    const auto playerNames = readPlayerNames(toPlayerFile(m_file));
+    truncateToWholeLines(toPlayerFile(m_file), playerNames);
+    m_playerIds.reserve(playerNames.size());
+
+    for (PlayerId id = 0; const auto& name : playerNames) {
+      m_playerIds.emplace(name, id++);
+    }
+
+    m_nbActions = truncateToWholeRecords<ActionRecord>(toActionFile(m_file));
+    // a crash may have left hands whose actions were not written, they are the last ones as the
+    // actions are written first. They are removed, else they would reference the next actions.
+    std::size_t nbHands = 0;
+    bool isBacked = true;
+    forEachRecord<HandRecord>(m_file, [this, &nbHands, &isBacked](const auto& h) {
+      isBacked = isBacked and h.m_firstAction + h.m_nbActions <= m_nbActions;
+
+      if (isBacked) {
+        m_handIdHashes.insert(h.m_handIdHash);
+        ++nbHands;
+      }
+    });
+    truncateToRecords<HandRecord>(m_file, nbHands);
+  }
+
+  // the files are only created on the 1st write
+  void openFilesIfNeeded() {
+    if (m_hands.is_open()) {
+      return;
+    }
+
+    constexpr auto mode = std::ios::binary | std::ios::app;
+    m_players.open(toPlayerFile(m_file), mode);
+    m_actions.open(toActionFile(m_file), mode);
+    m_hands.open(m_file, mode);
+
+    if (!m_players or !m_actions or !m_hands) {
+      throw HandStoreException(
+          fmt::format("Can't open the hand store file '{}' for writing", m_file.string()));
+    }
+  }
+
+  [[nodiscard]] PlayerId getPlayerIdLocked(std::string_view playerName) {
+    if (playerName.empty()) {
+      return NO_PLAYER;
+    }
+
+    if (const auto it = m_playerIds.find(std::string(playerName)); m_playerIds.end() != it) {
+      return it->second;
+    }
+
+    openFilesIfNeeded();
+    const auto id = gsl::narrow_cast<PlayerId>(m_playerIds.size());
+    m_playerIds.emplace(playerName, id);
+    m_players << playerName << '\n';
+    return id;
+  }
+
+  void appendLocked(HandRecord hand, std::span<const ActionRecord> actions) {
+    if (!m_handIdHashes.insert(hand.m_handIdHash).second) {
+      return; // already stored
+    }
+
+    openFilesIfNeeded();
+    hand.m_firstAction = m_nbActions;
+    hand.m_nbActions = gsl::narrow_cast<std::uint16_t>(actions.size());
+    // the actions are written before the hand that references them
+    write(m_actions, actions);
+    write(m_hands, std::span<const HandRecord>(&hand, 1));
+    m_nbActions += actions.size();
+  }
+
+  void appendLocked(const Hand& hand) {
+    HandRecord record {.m_handIdHash = hashHandId(hand.getId()),
+                       .m_firstAction = 0,
+                       .m_startDate = hand.getStartDate().toEpochSeconds(),
+                       .m_ante = hand.getAnte(),
+                       .m_seatPlayers = {},
+                       .m_level = hand.getLevel(),
+                       .m_nbActions = 0,
+                       .m_winners = 0,
+                       .m_heroCards = toCardValues(hand.getHeroCard1(), hand.getHeroCard2(),
+                                                   hand.getHeroCard3(), hand.getHeroCard4(),
+                                                   hand.getHeroCard5()),
+                       .m_boardCards = toCardValues(hand.getBoardCard1(), hand.getBoardCard2(),
+                                                    hand.getBoardCard3(), hand.getBoardCard4(),
+                                                    hand.getBoardCard5()),
+                       .m_buttonSeat = static_cast<std::uint8_t>(hand.getButtonSeat()),
+                       .m_maxSeats = static_cast<std::uint8_t>(hand.getMaxSeats()),
+                       .m_gameType = static_cast<std::uint8_t>(hand.getGameType()),
+                       .m_reserved = {}};
+    const auto& seats = hand.getSeats();
+
+    for (std::size_t i = 0; i < seats.size(); ++i) {
+      record.m_seatPlayers.at(i) = getPlayerIdLocked(seats.at(i));
+
+      if (!seats.at(i).empty() and hand.isWinner(seats.at(i))) {
+        record.m_winners = gsl::narrow_cast<std::uint16_t>(record.m_winners | (1U << i));
+      }
+    }
+
+    std::vector<ActionRecord> actions;
+    std::ranges::transform(hand.viewActions(), std::back_inserter(actions), [this](auto pAction) {
+      return ActionRecord {.m_betAmount = toAmount(pAction->getBetAmount()),
+                           .m_player = getPlayerIdLocked(pAction->getPlayerName()),
+                           .m_index = gsl::narrow_cast<std::uint16_t>(pAction->getIndex()),
+                           .m_street = static_cast<std::uint8_t>(pAction->getStreet()),
+                           .m_type = static_cast<std::uint8_t>(pAction->getType())};
+    });
+    appendLocked(record, actions);
+  }
+
+  void flushLocked() {
+    if (m_hands.is_open()) {
+      // flush in the reference order, so that a crash leaves no dangling reference
+      m_players.flush();
+      m_actions.flush();
+      m_hands.flush();
+    }
+  }
+}; // struct HandStore::Implementation
+
+HandStore::HandStore(const fs::path& file)
+  : m_pImpl {std::make_unique<Implementation>(file)} {}
+
+HandStore::~HandStore() {
+  try {
+    flush();
+  } catch (...) { // can't throw in a destructor
+    LOG().error<"Unknown Error when flushing the hand store.">();
+  }
+}
+
+void HandStore::append(const Site& site) {
+  const std::scoped_lock lock {m_pImpl->m_mutex};
+  const auto appendGame = [this](const auto* pGame) {
+    std::ranges::for_each(pGame->viewHands(),
+                          [this](auto pHand) { m_pImpl->appendLocked(*pHand); });
+  };
+  std::ranges::for_each(site.viewCashGames(), appendGame);
+  std::ranges::for_each(site.viewTournaments(), appendGame);
+  m_pImpl->flushLocked();
+}
+
+void HandStore::append(const HandRecord& hand, std::span<const ActionRecord> actions) {
+  const std::scoped_lock lock {m_pImpl->m_mutex};
+  m_pImpl->appendLocked(hand, actions);
+}
+
+HandStore::PlayerId HandStore::getPlayerId(std::string_view playerName) {
+  const std::scoped_lock lock {m_pImpl->m_mutex};
+  return m_pImpl->getPlayerIdLocked(playerName);
+}
+
+void HandStore::flush() {
+  const std::scoped_lock lock {m_pImpl->m_mutex};
+  m_pImpl->flushLocked();
+}
+
+std::size_t HandStore::getNbHands() const {
+  const std::scoped_lock lock {m_pImpl->m_mutex};
+  return m_pImpl->m_handIdHashes.size();
+}
+
+fs::path HandStore::getFile() const {
+  return m_pImpl->m_file;
+}
+
+/*static*/ std::uint64_t HandStore::hashHandId(std::string_view handId) noexcept {
+  // FNV-1a
+  std::uint64_t hash {14695981039346656037ULL};
+
+  for (const auto c : handId) {
+    hash = (hash ^ static_cast<unsigned char>(c)) * 1099511628211ULL;
+  }
+
+  return hash;
+}
+
+/*static*/ std::int64_t HandStore::toAmount(double amount) noexcept {
+  return std::llround(amount * AMOUNT_SCALE);
+}
+
+/*static*/ void HandStore::remove(const fs::path& file) {
+  std::error_code ec;
+  fs::remove(file, ec);
+  fs::remove(toActionFile(file), ec);
+  fs::remove(toPlayerFile(file), ec);
+}
+
+HandStore::Reader::Reader(const fs::path& file)
+  : m_hands {readRecords<HandRecord>(file)},
+    m_actions {readRecords<ActionRecord>(toActionFile(file))},
+    m_playerNames {readPlayerNames(toPlayerFile(file))} {
+  // the files are read in the reverse order of their writing, so that the hands appended meanwhile
+  // have their actions and players. A crash may have left hands whose actions were not written.
+  std::erase_if(m_hands, [this](const auto& h) {
+    return h.m_firstAction + h.m_nbActions > m_actions.size();
+  });
+  LOG().info<"{} hands and {} actions read from the hand store {}">(m_hands.size(),
+                                                                   m_actions.size(), file.string());
+}
+
+std::span<const HandStore::ActionRecord>
+HandStore::Reader::viewActions(const HandRecord& hand) const {
+  return std::span(m_actions).subspan(hand.m_firstAction, hand.m_nbActions);
+}
+
+std::string_view HandStore::Reader::getPlayerName(PlayerId id) const {
+  return (id < m_playerNames.size()) ? std::string_view(m_playerNames[id]) : std::string_view();
+}
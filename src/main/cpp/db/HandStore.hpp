@@ -0,0 +1,136 @@
+#pragma once
+
+#include "constants/TableConstants.hpp" // TableConstants::MAX_SEATS, MAX_CARDS
+#include "language/PhudException.hpp"   // PhudException, std::string_view
+#include <array>
+#include <cstdint>    // std::uint32_t, std::int64_t
+#include <filesystem> // std::filesystem::path
+#include <memory>     // std::unique_ptr
+#include <span>
+#include <string>
+#include <vector>
+
+// forward declarations
+class Site;
+
+/**
+ * An append-only binary copy of the hands, made of fixed layout records, used as a fast cache
+ * under the SQL database to compute statistics in bulk.
+ * The store is made of 3 files:
+ * - <file>: the hand records
+ * - <file>.actions: the action records, the actions of a hand being contiguous
+ * - <file>.players: the player names, one per line, the line index being the player id
+ * The record files have no header, so they can be mapped in memory as arrays of records.
+ */
+class [[nodiscard]] HandStore final {
+private:
+  struct Implementation;
+  std::unique_ptr<Implementation> m_pImpl;
+
+public:
+  using PlayerId = std::uint32_t;
+  static constexpr PlayerId NO_PLAYER {0xFFFFFFFF};
+  // amounts are stored as integers, in hundredths of the currency or chip unit
+  static constexpr std::int64_t AMOUNT_SCALE {100};
+
+  struct [[nodiscard]] HandRecord final {
+    // Memory layout optimized: largest to smallest to minimize padding
+    std::uint64_t m_handIdHash;  // to skip the hands already stored
+    std::uint64_t m_firstAction; // index of the 1st action of the hand in the actions file
+    std::int64_t m_startDate;    // seconds since epoch, UTC
+    std::int64_t m_ante;
+    std::array<PlayerId, TableConstants::MAX_SEATS> m_seatPlayers; // NO_PLAYER for empty seats
+    std::int32_t m_level;
+    std::uint16_t m_nbActions;
+    std::uint16_t m_winners; // bit i set if the player on the seat of index i won
+    std::array<std::uint8_t, TableConstants::MAX_CARDS> m_heroCards;  // Card values
+    std::array<std::uint8_t, TableConstants::MAX_CARDS> m_boardCards; // Card values
+    std::uint8_t m_buttonSeat; // Seat value
+    std::uint8_t m_maxSeats;   // Seat value
+    std::uint8_t m_gameType;   // GameType value
+    std::array<std::uint8_t, 3> m_reserved;
+  }; // struct HandRecord
+
+  struct [[nodiscard]] ActionRecord final {
+    // Memory layout optimized: largest to smallest to minimize padding
+    std::int64_t m_betAmount; // in AMOUNT_SCALE units
+    PlayerId m_player;
+    std::uint16_t m_index;
+    std::uint8_t m_street; // Street value
+    std::uint8_t m_type;   // ActionType value
+  }; // struct ActionRecord
+
+  /**
+   * The whole store loaded in memory, to iterate over the hands without any allocation. The files
+   * are not modified, so that they can be read while a HandStore appends to them.
+   */
+  class [[nodiscard]] Reader final {
+  private:
+    std::vector<HandRecord> m_hands;
+    std::vector<ActionRecord> m_actions;
+    std::vector<std::string> m_playerNames;
+
+  public:
+    /**
+     * @throws HandStoreException if a file of the store can't be read
+     */
+    explicit Reader(const std::filesystem::path& file);
+    explicit Reader(auto) = delete; // use only std::filesystem::path
+    [[nodiscard]] std::span<const HandRecord> viewHands() const noexcept { return m_hands; }
+    [[nodiscard]] std::span<const ActionRecord> viewActions(const HandRecord& hand) const;
+    [[nodiscard]] std::string_view getPlayerName(PlayerId id) const;
+    [[nodiscard]] std::size_t getNbPlayers() const noexcept { return m_playerNames.size(); }
+  }; // class Reader
+
+  /**
+   * Opens the store made of the given file and its companion files, which are created on the 1st
+   * append.
+   * @throws HandStoreException if an existing file of the store can't be read
+   */
+  explicit HandStore(const std::filesystem::path& file);
+  explicit HandStore(auto) = delete; // use only std::filesystem::path
+  HandStore(const HandStore&) = delete;
+  HandStore(HandStore&&) = delete;
+  HandStore& operator=(const HandStore&) = delete;
+  HandStore& operator=(HandStore&&) = delete;
+  ~HandStore();
+
+  /**
+   * Appends the hands of the given site that are not already stored. Thread safe.
+   * @throws HandStoreException if a file of the store can't be written
+   */
+  void append(const Site& site);
+
+  /**
+   * Appends the given hand if it is not already stored. m_firstAction and m_nbActions are set by
+   * the store. Thread safe.
+   * @throws HandStoreException if a file of the store can't be written
+   */
+  void append(const HandRecord& hand, std::span<const ActionRecord> actions);
+
+  /**
+   * @returns the id of the given player, adding it to the store if needed. Thread safe.
+   */
+  [[nodiscard]] PlayerId getPlayerId(std::string_view playerName);
+
+  /**
+   * Writes the pending records to the disk.
+   */
+  void flush();
+
+  [[nodiscard]] std::size_t getNbHands() const;
+  [[nodiscard]] std::filesystem::path getFile() const;
+
+  [[nodiscard]] static std::uint64_t hashHandId(std::string_view handId) noexcept;
+  [[nodiscard]] static std::int64_t toAmount(double amount) noexcept;
+
+  /**
+   * Deletes the files of the store made of the given file.
+   */
+  static void remove(const std::filesystem::path& file);
+}; // class HandStore
+
+class [[nodiscard]] HandStoreException final : public PhudException {
+public:
+  using PhudException::PhudException;
+};
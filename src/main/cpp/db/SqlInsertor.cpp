@@ -40,6 +40,11 @@ inline std::string toString<std::size_t>(std::size_t s) {
   return std::to_string(s);
 }
 
+template <>
+inline std::string toString<std::int64_t>(std::int64_t s) {
+  return std::to_string(s);
+}
+
 template <>
 inline std::string toString<double>(double s) {
   return std::to_string(s);
@@ -202,6 +207,18 @@ SqlInsertor& SqlInsertor::smallBlind(double value) {
 SqlInsertor& SqlInsertor::bigBlind(double value) {
   REPLACE_IN_VALUES("?bigBlind");
 }
+SqlInsertor& SqlInsertor::fileName(std::string_view fileName) {
+  // a file name can contain quotes
+  const auto escaped {ps::replaceAll(fileName, "'", "''")};
+  const std::string_view value {escaped};
+  REPLACE_IN_VALUES("?fileName");
+}
+SqlInsertor& SqlInsertor::fileSize(std::int64_t value) {
+  REPLACE_IN_VALUES("?fileSize");
+}
+SqlInsertor& SqlInsertor::lastWriteTime(std::int64_t value) {
+  REPLACE_IN_VALUES("?lastWriteTime");
+}
 
 #undef REPLACE_IN_VALUES
 
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint> // std::int64_t
 #include <string>
 #include <string_view>
 
@@ -79,6 +80,9 @@ public:
   [[nodiscard]] SqlInsertor& cashGameId(std::string_view value);
   [[nodiscard]] SqlInsertor& smallBlind(double value);
   [[nodiscard]] SqlInsertor& bigBlind(double value);
+  [[nodiscard]] SqlInsertor& fileName(std::string_view value);
+  [[nodiscard]] SqlInsertor& fileSize(std::int64_t value);
+  [[nodiscard]] SqlInsertor& lastWriteTime(std::int64_t value);
 }; // class SqlInsertor
 
 [[nodiscard]] std::string formatSQL(std::string_view sql);
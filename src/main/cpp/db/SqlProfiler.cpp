@@ -0,0 +1,211 @@
+#include "db/SqlProfiler.hpp"       // SqlProfiler, SqlStatementProfile, std::span, std::string_view
+#include "log/Logger.hpp"          // fmt::format_to
+#include "strings/StringUtils.hpp" // phud::strings::trim
+#include <sqlite3.h>               // sqlite3_trace_v2, sqlite3_stmt_status
+#include <array>
+#include <bit>        // std::bit_width
+#include <functional> // std::less, std::greater
+#include <map>
+#include <mutex>
+#include <unordered_map>
+
+namespace ps = phud::strings;
+
+namespace {
+  // the durations are counted in buckets: 8 buckets per power of 2 of nanoseconds
+  constexpr std::size_t NB_SUB_BUCKETS {8};
+  constexpr std::size_t NB_SUB_BUCKET_BITS {3};
+  constexpr std::size_t NB_BUCKETS {(64 - 2) * NB_SUB_BUCKETS};
+
+  [[nodiscard]] constexpr std::size_t toBucket(std::uint64_t nanos) noexcept {
+    if (nanos < NB_SUB_BUCKETS) {
+      return static_cast<std::size_t>(nanos);
+    }
+
+    const auto log2 {static_cast<std::size_t>(std::bit_width(nanos)) - 1};
+    const auto subBucket {(nanos >> (log2 - NB_SUB_BUCKET_BITS)) & (NB_SUB_BUCKETS - 1)};
+    return (log2 - 2) * NB_SUB_BUCKETS + static_cast<std::size_t>(subBucket);
+  }
+
+  // @returns the lowest duration of the given bucket
+  [[nodiscard]] constexpr std::uint64_t toNanos(std::size_t bucket) noexcept {
+    if (bucket < NB_SUB_BUCKETS) {
+      return bucket;
+    }
+
+    const auto log2 {bucket / NB_SUB_BUCKETS + 2};
+    return (NB_SUB_BUCKETS + bucket % NB_SUB_BUCKETS) << (log2 - NB_SUB_BUCKET_BITS);
+  }
+
+  static_assert(toBucket(7) == 7 and toBucket(8) == 8 and toBucket(15) == 15);
+  static_assert(toBucket(16) == 16 and toBucket(17) == 16 and toBucket(18) == 17);
+  static_assert(toNanos(toBucket(1'000'000)) <= 1'000'000);
+  static_assert(toNanos(toBucket(1'000'000) + 1) > 1'000'000);
+
+  struct [[nodiscard]] StatementStats final {
+    // Memory layout optimized: largest to smallest to minimize padding
+    std::array<std::uint64_t, NB_BUCKETS> m_durationBuckets {};
+    std::uint64_t m_totalNanos {0};
+    std::uint64_t m_nbCalls {0};
+    std::uint64_t m_nbRows {0};
+    std::uint64_t m_nbFullScanSteps {0};
+    std::uint64_t m_nbSorts {0};
+    std::uint64_t m_nbAutoIndexes {0};
+
+    [[nodiscard]] std::uint64_t getP99Nanos() const noexcept {
+      // the smallest duration greater than 99% of the durations
+      const auto threshold {m_nbCalls - m_nbCalls / 100};
+      std::uint64_t nbCalls {0};
+
+      for (std::size_t bucket = 0; bucket < m_durationBuckets.size(); ++bucket) {
+        nbCalls += m_durationBuckets[bucket];
+
+        if (nbCalls >= threshold) {
+          return toNanos(bucket + 1);
+        }
+      }
+
+      return m_totalNanos;
+    }
+  }; // struct StatementStats
+
+  [[nodiscard]] std::string_view getFirstLine(std::string_view sql) {
+    const auto trimmed {ps::trim(sql)};
+    return trimmed.substr(0, trimmed.find('\n'));
+  }
+
+  // the start of the template, up to its 1st parameter
+  [[nodiscard]] std::string_view getTemplatePrefix(std::string_view sqlTemplate) {
+    const auto trimmed {ps::trim(sqlTemplate)};
+    return trimmed.substr(0, trimmed.find('?'));
+  }
+} // anonymous namespace
+
+struct [[nodiscard]] SqlProfiler::Implementation final {
+  std::map<std::string, StatementStats, std::less<>> m_statsByName {};
+  std::unordered_map<const sqlite3_stmt*, std::uint64_t> m_nbRowsByStatement {};
+  std::vector<NamedStatement> m_templatePrefixes {};
+  mutable std::mutex m_mutex {};
+  sqlite3* m_pDatabase;
+
+  Implementation(sqlite3* pDatabase, std::span<const NamedStatement> namedStatements)
+    : m_pDatabase {pDatabase} {
+    std::ranges::transform(namedStatements, std::back_inserter(m_templatePrefixes),
+                           [](const auto& namedStatement) {
+                             return NamedStatement {namedStatement.first,
+                                                    getTemplatePrefix(namedStatement.second)};
+                           });
+  }
+
+  [[nodiscard]] std::string_view getName(std::string_view sql) const {
+    const auto trimmed {ps::trim(sql)};
+    const auto it {std::ranges::find_if(m_templatePrefixes, [trimmed](const auto& namedPrefix) {
+      return trimmed.starts_with(namedPrefix.second);
+    })};
+    return m_templatePrefixes.end() == it ? getFirstLine(sql) : it->first;
+  }
+
+  void onRow(const sqlite3_stmt* pStatement) {
+    const std::scoped_lock lock {m_mutex};
+    ++m_nbRowsByStatement[pStatement];
+  }
+
+  void onProfile(sqlite3_stmt* pStatement, std::uint64_t nanos) {
+    // the counters are reset as a prepared statement can be run several times
+    const auto nbFullScanSteps {
+        sqlite3_stmt_status(pStatement, SQLITE_STMTSTATUS_FULLSCAN_STEP, /*reset*/ 1)};
+    const auto nbSorts {sqlite3_stmt_status(pStatement, SQLITE_STMTSTATUS_SORT, 1)};
+    const auto nbAutoIndexes {sqlite3_stmt_status(pStatement, SQLITE_STMTSTATUS_AUTOINDEX, 1)};
+    const auto isReadOnly {0 != sqlite3_stmt_readonly(pStatement)};
+    const auto nbChanges {isReadOnly ? 0 : sqlite3_changes(m_pDatabase)};
+    const auto name {getName(sqlite3_sql(pStatement))};
+    const std::scoped_lock lock {m_mutex};
+    auto it {m_statsByName.find(name)};
+
+    if (m_statsByName.end() == it) {
+      it = m_statsByName.emplace(std::string(name), StatementStats {}).first;
+    }
+
+    auto& stats {it->second};
+    ++stats.m_durationBuckets[std::min(toBucket(nanos), NB_BUCKETS - 1)];
+    stats.m_totalNanos += nanos;
+    ++stats.m_nbCalls;
+    stats.m_nbFullScanSteps += static_cast<std::uint64_t>(nbFullScanSteps);
+    stats.m_nbSorts += static_cast<std::uint64_t>(nbSorts);
+    stats.m_nbAutoIndexes += static_cast<std::uint64_t>(nbAutoIndexes);
+
+    if (isReadOnly) {
+      if (const auto rowsIt {m_nbRowsByStatement.find(pStatement)};
+          m_nbRowsByStatement.end() != rowsIt) {
+        stats.m_nbRows += rowsIt->second;
+        m_nbRowsByStatement.erase(rowsIt);
+      }
+    } else {
+      stats.m_nbRows += static_cast<std::uint64_t>(nbChanges);
+    }
+  }
+}; // struct SqlProfiler::Implementation
+
+SqlProfiler::SqlProfiler(sqlite3* pDatabase, std::span<const NamedStatement> namedStatements)
+  : m_pImpl {std::make_unique<Implementation>(pDatabase, namedStatements)} {
+  // a lambda in a member function can access the private Implementation
+  constexpr auto onTrace = [](unsigned int type, void* pContext, void* p, void* x) {
+    auto* pImpl {static_cast<Implementation*>(pContext)};
+
+    try {
+      if (SQLITE_TRACE_ROW == type) {
+        pImpl->onRow(static_cast<const sqlite3_stmt*>(p));
+      } else if (SQLITE_TRACE_PROFILE == type) {
+        const auto nanos {*static_cast<const sqlite3_int64*>(x)};
+        pImpl->onProfile(static_cast<sqlite3_stmt*>(p), static_cast<std::uint64_t>(nanos));
+      }
+    } catch (...) { // can't throw in a C callback
+    }
+
+    return 0;
+  };
+  sqlite3_trace_v2(pDatabase, SQLITE_TRACE_PROFILE | SQLITE_TRACE_ROW, onTrace, m_pImpl.get());
+}
+
+SqlProfiler::~SqlProfiler() {
+  sqlite3_trace_v2(m_pImpl->m_pDatabase, 0, nullptr, nullptr);
+}
+
+std::vector<SqlStatementProfile> SqlProfiler::getProfiles() const {
+  std::vector<SqlStatementProfile> ret;
+  {
+    const std::scoped_lock lock {m_pImpl->m_mutex};
+    ret.reserve(m_pImpl->m_statsByName.size());
+    std::ranges::transform(
+        m_pImpl->m_statsByName, std::back_inserter(ret), [](const auto& nameAndStats) {
+          const auto& [name, stats] {nameAndStats};
+          return SqlStatementProfile {
+              .m_name = name,
+              .m_totalTime = std::chrono::nanoseconds(stats.m_totalNanos),
+              .m_p99Time = std::chrono::nanoseconds(stats.getP99Nanos()),
+              .m_nbCalls = stats.m_nbCalls,
+              .m_nbRows = stats.m_nbRows,
+              .m_nbFullScanSteps = stats.m_nbFullScanSteps,
+              .m_nbSorts = stats.m_nbSorts,
+              .m_nbAutoIndexes = stats.m_nbAutoIndexes};
+        });
+  }
+  std::ranges::sort(ret, std::greater {}, &SqlStatementProfile::m_totalTime);
+  return ret;
+}
+
+std::string SqlProfiler::toString() const {
+  std::string ret;
+  auto out {std::back_inserter(ret)};
+  fmt::format_to(out, "{:<40} {:>8} {:>10} {:>12} {:>10} {:>12} {:>6} {:>10}\n", "statement",
+                 "calls", "rows", "total (ms)", "p99 (ms)", "full scans", "sorts", "autoindex");
+  std::ranges::for_each(getProfiles(), [&out](const auto& p) {
+    const auto toMillis = [](std::chrono::nanoseconds ns) {
+      return std::chrono::duration<double, std::milli>(ns).count();
+    };
+    fmt::format_to(out, "{:<40} {:>8} {:>10} {:>12.3f} {:>10.3f} {:>12} {:>6} {:>10}\n",
+                   p.m_name.substr(0, 40), p.m_nbCalls, p.m_nbRows, toMillis(p.m_totalTime),
+                   toMillis(p.m_p99Time), p.m_nbFullScanSteps, p.m_nbSorts, p.m_nbAutoIndexes);
+  });
+  return ret;
+}
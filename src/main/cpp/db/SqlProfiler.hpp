@@ -0,0 +1,65 @@
+#pragma once
+
+#include <chrono>  // std::chrono::nanoseconds
+#include <cstdint> // std::uint64_t
+#include <memory>  // std::unique_ptr
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility> // std::pair
+#include <vector>
+
+// forward declarations
+struct sqlite3;
+
+/**
+ * What the SqlProfiler recorded for a logical SQL statement.
+ */
+struct [[nodiscard]] SqlStatementProfile final {
+  // Memory layout optimized: largest to smallest to minimize padding
+  std::string m_name;
+  std::chrono::nanoseconds m_totalTime;
+  std::chrono::nanoseconds m_p99Time; // rounded up, with a precision of 12.5%
+  std::uint64_t m_nbCalls;
+  std::uint64_t m_nbRows; // rows affected by the modifications, rows returned by the queries
+  std::uint64_t m_nbFullScanSteps;
+  std::uint64_t m_nbSorts;
+  std::uint64_t m_nbAutoIndexes;
+}; // struct SqlStatementProfile
+
+/**
+ * Records the duration, number of rows and SQLite counters of each statement run by a database
+ * connection, through the SQLite trace hooks.
+ * The statements are grouped by logical statement: the statements starting like the SQL template
+ * of a named statement, up to its 1st parameter, are recorded under its name. The other ones are
+ * recorded under their 1st line.
+ * Note that SQLite measures the durations with the resolution of its OS clock, usually 1 ms.
+ */
+class [[nodiscard]] SqlProfiler final {
+private:
+  struct Implementation;
+  std::unique_ptr<Implementation> m_pImpl;
+
+public:
+  using NamedStatement = std::pair<std::string_view, std::string_view>; // name, SQL template
+
+  /**
+   * Starts recording the statements of the given connection, until destruction.
+   */
+  SqlProfiler(sqlite3* pDatabase, std::span<const NamedStatement> namedStatements);
+  SqlProfiler(const SqlProfiler&) = delete;
+  SqlProfiler(SqlProfiler&&) = delete;
+  SqlProfiler& operator=(const SqlProfiler&) = delete;
+  SqlProfiler& operator=(SqlProfiler&&) = delete;
+  ~SqlProfiler();
+
+  /**
+   * @returns the profiles of the recorded statements, the longest total time first. Thread safe.
+   */
+  [[nodiscard]] std::vector<SqlStatementProfile> getProfiles() const;
+
+  /**
+   * @returns the profiles as a text table, one line per statement.
+   */
+  [[nodiscard]] std::string toString() const;
+}; // class SqlProfiler
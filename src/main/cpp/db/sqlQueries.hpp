@@ -136,6 +136,49 @@ CREATE TABLE HandPlayer (
   FOREIGN KEY(handId) REFERENCES Hand(handId), 
   FOREIGN KEY(playerName) REFERENCES Player(playerName)
 );
+)raw";
+
+  // created on the opening of the databases which predate it
+  static constexpr std::string_view CREATE_HISTORY_FILE = R"raw(
+CREATE TABLE IF NOT EXISTS HistoryFile (
+  fileName TEXT NOT NULL, 
+  fileSize INTEGER NOT NULL, 
+  lastWriteTime INTEGER NOT NULL, 
+  PRIMARY KEY(fileName)
+);
+)raw";
+
+  // the rows with a generated key saved again are ignored, as their natural key is unique
+  static constexpr std::string_view CREATE_UNIQUE_INDEXES = R"raw(
+CREATE UNIQUE INDEX IF NOT EXISTS ActionByHand ON Action (handId, street, actionIndex);
+CREATE UNIQUE INDEX IF NOT EXISTS CashGameHandByHand ON CashGameHand (cashGameId, handId);
+CREATE UNIQUE INDEX IF NOT EXISTS TournamentHandByHand ON TournamentHand (tournamentId, handId);
+)raw";
+
+  // 1 if the Action table exists without its unique index, 0 otherwise
+  static constexpr std::string_view IS_MISSING_UNIQUE_INDEXES = R"raw(
+SELECT COUNT(*) FROM sqlite_master WHERE type = 'table' AND name = 'Action' AND NOT EXISTS (
+  SELECT 1 FROM sqlite_master WHERE type = 'index' AND name = 'ActionByHand'
+);
+)raw";
+
+  // run on the opening of the databases which predate the unique indexes: keeps the first copy of
+  // the rows saved several times
+  static constexpr std::string_view CREATE_UNIQUE_INDEXES_AND_DELETE_DUPLICATES = R"raw(
+BEGIN TRANSACTION;
+DELETE FROM Action WHERE actionId NOT IN (
+  SELECT MIN(actionId) FROM Action GROUP BY handId, street, actionIndex
+);
+DELETE FROM CashGameHand WHERE cashGameHandId NOT IN (
+  SELECT MIN(cashGameHandId) FROM CashGameHand GROUP BY cashGameId, handId
+);
+DELETE FROM TournamentHand WHERE tournamentHandId NOT IN (
+  SELECT MIN(tournamentHandId) FROM TournamentHand GROUP BY tournamentId, handId
+);
+CREATE UNIQUE INDEX IF NOT EXISTS ActionByHand ON Action (handId, street, actionIndex);
+CREATE UNIQUE INDEX IF NOT EXISTS CashGameHandByHand ON CashGameHand (cashGameId, handId);
+CREATE UNIQUE INDEX IF NOT EXISTS TournamentHandByHand ON TournamentHand (tournamentId, handId);
+END TRANSACTION;
 )raw";
 
   static constexpr std::string_view INSERT_SITE = R"raw(
@@ -275,7 +318,47 @@ WHERE
 ORDER BY h.startDate DESC limit 1
 )raw";
 
-  static constexpr std::array<std::string_view, 10> CREATE_QUERIES = {CREATE_SITE,
+  /**
+   * These queries read all the hands, ordered by hand id, to rebuild the binary hand store.
+   */
+  static constexpr std::string_view GET_HANDS_FOR_HAND_STORE = R"raw(
+SELECT
+  h.handId, h.buttonSeat, h.maxSeats, h.level, h.ante, h.startDate,
+  h.heroCard1, h.heroCard2, h.heroCard3, h.heroCard4, h.heroCard5,
+  h.boardCard1, h.boardCard2, h.boardCard3, h.boardCard4, h.boardCard5,
+  EXISTS (SELECT 1 FROM TournamentHand th WHERE th.handId = h.handId) AS isTournament
+FROM Hand h
+ORDER BY h.handId;
+)raw";
+
+  static constexpr std::string_view GET_HAND_PLAYERS_FOR_HAND_STORE = R"raw(
+SELECT handId, playerName, playerSeat, isWinner FROM HandPlayer ORDER BY handId;
+)raw";
+
+  static constexpr std::string_view GET_ACTIONS_FOR_HAND_STORE = R"raw(
+SELECT handId, playerName, street, actionType, actionIndex, betAmount
+FROM Action
+ORDER BY handId, actionId;
+)raw";
+
+  static constexpr std::string_view INSERT_HISTORY_FILE = R"raw(
+INSERT OR REPLACE INTO HistoryFile (fileName, fileSize, lastWriteTime)
+VALUES ('?fileName', ?fileSize, ?lastWriteTime);
+)raw";
+
+  static constexpr std::string_view GET_HISTORY_FILES = R"raw(
+SELECT fileName, fileSize, lastWriteTime FROM HistoryFile;
+)raw";
+
+  static constexpr std::string_view GET_NB_HANDS = R"raw(
+SELECT COUNT(*) FROM Hand;
+)raw";
+
+  static constexpr std::string_view GET_NB_ACTIONS = R"raw(
+SELECT COUNT(*) FROM Action;
+)raw";
+
+  static constexpr std::array<std::string_view, 12> CREATE_QUERIES = {CREATE_SITE,
                                                                       CREATE_HAND,
                                                                       CREATE_GAME,
                                                                       CREATE_CASH_GAME,
@@ -284,6 +367,8 @@ ORDER BY h.startDate DESC limit 1
                                                                       CREATE_TOURNAMENT_HAND,
                                                                       CREATE_ACTION,
                                                                       CREATE_PLAYER,
-                                                                      CREATE_HAND_PLAYER};
+                                                                      CREATE_HAND_PLAYER,
+                                                                      CREATE_HISTORY_FILE,
+                                                                      CREATE_UNIQUE_INDEXES};
 
 } // namespace phud::sql
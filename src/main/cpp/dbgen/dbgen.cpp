@@ -1,10 +1,19 @@
-#include "db/Database.hpp" // std::string
+#include "constants/ProgramInfos.hpp" // DATABASE_NAME
+#include "db/Database.hpp"              // std::string
 #include "entities/Site.hpp"
 #include "filesystem/FileUtils.hpp"     // phud::filesystem::*
+#include "history/ImportReport.hpp"     // ImportReport
 #include "history/PokerSiteHistory.hpp" // std::filesystem::path
+#include "history/WinamaxHistoryStream.hpp" // WinamaxHistoryStream
 #include "language/limits.hpp"          // toSizeT
 #include "log/Logger.hpp"               // CURRENT_FILE_NAME
+#include "strings/StringUtils.hpp"      // phud::strings::plural
+#include <algorithm> // std::ranges::any_of, std::ranges::transform
+#include <chrono>
+#include <iostream> // std::cin
 #include <optional>
+#include <unordered_map>
+#include <unordered_set>
 #include <utility> // std::pair
 
 static Logger& LOG() {
@@ -13,6 +22,7 @@ static Logger& LOG() {
 }
 
 namespace fs = std::filesystem;
+namespace ps = phud::strings;
 
 namespace {
   struct [[nodiscard]] MyLoggingConfig final {
@@ -20,16 +30,229 @@ namespace {
     ~MyLoggingConfig() { Logger::shutdownLogging(); }
   }; // struct MyLoggingConfig
 
+  constexpr std::string_view STDIN_FLAG {"--stdin"};
+  constexpr std::string_view REBUILD_HAND_STORE_FLAG {"--rebuild-hand-store"};
+  constexpr std::string_view REPORT_FLAG {"--report"};
+  constexpr std::string_view APPEND_FLAG {"--append"};
+  // number of hands saved in each transaction when reading from the standard input
+  constexpr std::size_t STDIN_NB_HANDS_PER_BATCH {1000};
+
+  void printUsage(std::string_view programName) {
+    LOG().error<"{} -b <database file name> -d <history directory> [{} <csv file name>]">(
+        programName, REPORT_FLAG);
+    LOG().error<"{} -b <database file name> -d <history directory> {}">(programName, APPEND_FLAG);
+    LOG().error<"{} [-b <database file name>] --stdin">(programName);
+    LOG().error<"{} -b <database file name> {}\n">(programName, REBUILD_HAND_STORE_FLAG);
+  }
+
+  [[nodiscard]] bool isRebuildHandStoreMode(std::span<const char* const> args) {
+    return 3 < args.size() and REBUILD_HAND_STORE_FLAG == args[3];
+  }
+
+  // accepts '-b <db> --rebuild-hand-store', the database must exist
+  [[nodiscard]] std::optional<fs::path>
+  getOptionalDbForRebuild(std::span<const char* const> args) {
+    if (const std::string_view flag1 = args[1]; 4 != args.size() or "-b" != flag1) {
+      LOG().error<"Wrong arguments.">();
+      printUsage(args[0]);
+      return {};
+    }
+
+    if (const fs::path dbFile = args[2]; phud::filesystem::isFile(dbFile)) {
+      return dbFile;
+    }
+
+    LOG().error<"The database file\n{}\ndoes not exist.">(args[2]);
+    return {};
+  }
+
+  [[nodiscard]] bool isStdinMode(std::span<const char* const> args) {
+    return std::ranges::any_of(args, [](std::string_view arg) { return STDIN_FLAG == arg; });
+  }
+
+  // accepts '--stdin', '-b <db> --stdin' and '--stdin -b <db>'. The database may already exist.
+  [[nodiscard]] std::optional<fs::path> getOptionalDbForStdin(std::span<const char* const> args) {
+    if (2 == args.size()) {
+      return fs::path(ProgramInfos::DATABASE_NAME);
+    }
+
+    if (4 == args.size()) {
+      if (const std::string_view flag1 = args[1]; "-b" == flag1 and STDIN_FLAG == args[3]) {
+        return fs::path(args[2]);
+      }
+
+      if (const std::string_view flag2 = args[2]; STDIN_FLAG == args[1] and "-b" == flag2) {
+        return fs::path(args[3]);
+      }
+    }
+
+    LOG().error<"Wrong arguments.">();
+    printUsage(args[0]);
+    return {};
+  }
+
+  /**
+   * Saves the hands read from the standard input in bounded transactions, so that the memory usage
+   * stays constant whatever the amount of piped data.
+   */
+  void importFromStdin(const fs::path& dbFile) {
+    auto db = Database(dbFile.string());
+    std::ios_base::sync_with_stdio(false);
+    const auto nbHands = WinamaxHistoryStream::parse(std::cin, STDIN_NB_HANDS_PER_BATCH,
+                                                     [&db](Site& batch) { db.save(batch); });
+    LOG().warn<"{} hand{} read from the standard input.">(nbHands, ps::plural(nbHands));
+  }
+
+  // accepts '... --report <csv file>' after the database and the history directory
+  [[nodiscard]] std::optional<fs::path> getOptionalReportFile(std::span<const char* const> args) {
+    if (7 == args.size() and REPORT_FLAG == args[5]) {
+      return fs::path(args[6]);
+    }
+
+    return {};
+  }
+
+  [[nodiscard]] HistoryFileStamp getStamp(const fs::path& file) {
+    return {.m_fileName = file.filename().string(),
+            .m_size = static_cast<std::int64_t>(fs::file_size(file)),
+            .m_lastWriteTime = fs::last_write_time(file).time_since_epoch().count()};
+  }
+
+  [[nodiscard]] std::vector<HistoryFileStamp> getStamps(const fs::path& historyDir) {
+    const auto files {phud::filesystem::listTxtFilesInDir(historyDir / "history")};
+    std::vector<HistoryFileStamp> ret;
+    ret.reserve(files.size());
+    std::ranges::transform(files, std::back_inserter(ret), getStamp);
+    return ret;
+  }
+
+  /**
+   * Loads the history, saving each batch of parsed files as soon as it is done, then saves what was
+   * not handed over. Once a batch can't be saved, the next ones are not saved either, so that the
+   * history files are not recorded as imported.
+   * @returns false if a batch couldn't be saved
+   */
+  [[nodiscard]] bool loadAndSave(PokerSiteHistory& history, const fs::path& historyDir,
+                                 Database& db, ImportReport* pReport) {
+    std::optional<std::string> oError {};
+    const auto pSite {history.load(historyDir, nullptr, nullptr, ImportOrder::directory,
+                                   [&db, &oError](Site& batch) {
+      if (oError.has_value()) {
+        return;
+      }
+
+      try {
+        db.save(batch);
+      } catch (const std::exception& e) { oError = e.what(); }
+    })};
+
+    if (oError.has_value()) {
+      LOG().error<"Couldn't save the history {}: {}">(historyDir.string(), oError.value());
+      return false;
+    }
+
+    const auto start {std::chrono::steady_clock::now()};
+    db.save(*pSite); // what was not handed over
+
+    if (nullptr != pReport) {
+      pReport->addInsertTime(std::chrono::steady_clock::now() - start);
+    }
+
+    return true;
+  }
+
+  /**
+   * Imports the history by batches, as phud does, recording the cost of each file and of each
+   * phase. The report is written in the given CSV file and its summary is printed.
+   */
+  [[nodiscard]] bool importWithReport(const fs::path& dbFile, const fs::path& historyDir,
+                                      const fs::path& reportFile) {
+    auto pReport {std::make_shared<ImportReport>()};
+    auto db = Database(dbFile.string());
+    const auto stamps {getStamps(historyDir)};
+    const auto pHistory {PokerSiteHistory::newInstance(historyDir)};
+    pHistory->setImportReport(pReport);
+
+    if (!loadAndSave(*pHistory, historyDir, db, pReport.get())) {
+      return false;
+    }
+
+    db.save(stamps);
+    pReport->stop();
+    LOG().warn<"{}">(pReport->toString());
+    return pReport->writeCsv(reportFile);
+  }
+
+  // accepts '... --append' after the database and the history directory
+  [[nodiscard]] bool isAppendMode(std::span<const char* const> args) {
+    return 6 == args.size() and APPEND_FLAG == args[5];
+  }
+
+  // @returns the stamps of the history files which are new or changed since the previous import
+  [[nodiscard]] std::vector<HistoryFileStamp> getChangedFiles(const Database& db,
+                                                              const fs::path& historyDir) {
+    std::unordered_map<std::string, HistoryFileStamp> imported;
+    std::ranges::for_each(db.readHistoryFileStamps(), [&imported](auto& stamp) {
+      auto fileName {stamp.m_fileName};
+      imported.try_emplace(std::move(fileName), std::move(stamp));
+    });
+    auto ret {getStamps(historyDir)};
+    std::erase_if(ret, [&imported](const auto& stamp) {
+      const auto it {imported.find(stamp.m_fileName)};
+      return imported.end() != it and it->second == stamp;
+    });
+    return ret;
+  }
+
+  /**
+   * Imports into the existing database the history files which are new or changed since the
+   * previous import, as told by their size and last write time. A changed file is read again in
+   * full: its hands, actions and game links already saved are ignored by the unique keys of the
+   * database. Prints the number of new files, of new hands and the elapsed time.
+   * @returns false if the hands couldn't be saved, the files then being imported again next time
+   */
+  [[nodiscard]] bool appendHistory(const fs::path& dbFile, const fs::path& historyDir) {
+    const auto start {std::chrono::steady_clock::now()};
+    auto db = Database(dbFile.string());
+    const auto nbFiles {phud::filesystem::listTxtFilesInDir(historyDir / "history").size()};
+    // stamped before the import, so that a file written during the import is imported again
+    const auto changedFiles {getChangedFiles(db, historyDir)};
+    const auto nbHandsBefore {db.getNbHands()};
+
+    if (!changedFiles.empty()) {
+      std::unordered_set<std::string> fileNames;
+      std::ranges::for_each(changedFiles, [&fileNames](const auto& stamp) {
+        fileNames.insert(stamp.m_fileName);
+      });
+      const auto pHistory {PokerSiteHistory::newInstance(historyDir)};
+      pHistory->setFileFilter([&fileNames](const fs::path& file) {
+        return fileNames.contains(file.filename().string());
+      });
+
+      if (!loadAndSave(*pHistory, historyDir, db, nullptr)) {
+        return false;
+      }
+
+      db.save(changedFiles);
+    }
+
+    const auto nbNewHands {db.getNbHands() - nbHandsBefore};
+    const std::chrono::duration<double> elapsed {std::chrono::steady_clock::now() - start};
+    LOG().warn<"{} new or changed file{} out of {}, {} new hand{}, in {:.1f} s.">(
+        changedFiles.size(), ps::plural(changedFiles.size()), nbFiles, nbNewHands,
+        ps::plural(nbNewHands), elapsed.count());
+    return true;
+  }
+
   [[nodiscard]] std::optional<std::pair<fs::path, fs::path>>
   getOptionalDbAndHistory(std::span<const char* const> args) {
-    if (5 != args.size()) {
-      if ((1 == args.size())) {
-        LOG().error<"{} -b <database file name> -d <history directory>\n">(args[0]);
-      } else {
+    if (5 != args.size() and !getOptionalReportFile(args).has_value() and !isAppendMode(args)) {
+      if ((1 != args.size())) {
         LOG().error<"Wrong arguments.">();
-        LOG().error<"{} -b <database file name> -d <history directory>\n">(args[0]);
       }
 
+      printUsage(args[0]);
+
       return {};
     }
 
@@ -38,21 +261,22 @@ namespace {
     if (const std::string_view flag2 = args[3];
         ("-b" != flag1 and "-d" != flag1) or ("-b" != flag2 and "-d" != flag2)) {
       LOG().error<"Wrong arguments.">();
-      LOG().error<"{} -b <database file name> -d <history directory>\n">(args[0]);
+      printUsage(args[0]);
       return {};
     }
 
     const fs::path dbFile = ("-b" == flag1) ? args[2] : args[4];
     const fs::path historyDir = ("-b" == flag1) ? args[4] : args[2];
 
-    if (phud::filesystem::isFile(dbFile)) {
-      LOG().error<"The database file\n{}\nalready exists and is in the way.">(dbFile.string());
+    if (!isAppendMode(args) and phud::filesystem::isFile(dbFile)) {
+      LOG().error<"The database file\n{}\nalready exists and is in the way, use {} to import only "
+                  "the new hands.">(dbFile.string(), APPEND_FLAG);
       return {};
     }
 
     if (!PokerSiteHistory::isValidHistory(historyDir)) {
       LOG().error<"'{}' is not a valid history directory">(historyDir.string());
-      LOG().error<"{} -b <database file name> -d <history directory>\n">(args[0]);
+      printUsage(args[0]);
       return {};
     }
 
@@ -75,11 +299,44 @@ int main(int argc, const char* const argv[]) {
 #  pragma clang diagnostic pop
 #endif
 
+  if (isStdinMode(args)) {
+    if (const auto oDbFile = getOptionalDbForStdin(args); oDbFile.has_value()) {
+      importFromStdin(oDbFile.value());
+      return 0;
+    }
+
+    return 1;
+  }
+
+  if (isRebuildHandStoreMode(args)) {
+    if (const auto oDbFile = getOptionalDbForRebuild(args); oDbFile.has_value()) {
+      auto db = Database(oDbFile.value().string());
+      const auto nbHands = db.rebuildHandStore();
+      LOG().warn<"{} hand{} written to {}.">(nbHands, ps::plural(nbHands),
+                                             db.getHandStoreFile().string());
+      return 0;
+    }
+
+    return 1;
+  }
+
   if (const auto oRet = getOptionalDbAndHistory(args); oRet.has_value()) {
     const auto [dbFile, historyDir] = oRet.value();
+
+    if (const auto oReportFile = getOptionalReportFile(args); oReportFile.has_value()) {
+      return importWithReport(dbFile, historyDir, oReportFile.value()) ? 0 : 1;
+    }
+
+    if (isAppendMode(args)) {
+      return appendHistory(dbFile, historyDir) ? 0 : 1;
+    }
+
+    // recorded so that the next imports in append mode skip the unchanged files
+    const auto stamps {getStamps(historyDir)};
     const auto pSite = PokerSiteHistory::load(historyDir);
     auto db = Database(dbFile.string());
     db.save(*pSite);
+    db.save(stamps);
     return 0;
   }
 
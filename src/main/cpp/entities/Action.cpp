@@ -33,3 +33,17 @@ std::string_view toString(ActionType at) {
 std::string_view toString(Street st) {
   return STREET_MAPPER.toString(st);
 }
+
+ActionType toActionType(std::string_view actionType) {
+  return ACTION_TYPE_MAPPER.fromString(actionType);
+}
+
+Street toStreet(std::string_view street) {
+  return STREET_MAPPER.fromString(street);
+}
+
+/*[[nodiscard]]*/ MemoryUsage Action::getMemoryUsage() const noexcept {
+  return {.m_nbBytes =
+              sizeof(Action) + memory::getHeapSize(m_handId) + memory::getHeapSize(m_playerName),
+          .m_nbObjects = 1};
+}
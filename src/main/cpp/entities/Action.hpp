@@ -1,6 +1,6 @@
 #pragma once
 
-#include <string>
+#include "language/MemoryUsage.hpp" // MemoryUsage, std::string
 #include <string_view>
 
 /**
@@ -47,8 +47,11 @@ public:
   [[nodiscard]] constexpr ActionType getType() const noexcept { return m_type; }
   [[nodiscard]] constexpr std::size_t getIndex() const noexcept { return m_index; }
   [[nodiscard]] constexpr double getBetAmount() const noexcept { return m_betAmount; }
+  [[nodiscard]] MemoryUsage getMemoryUsage() const noexcept;
 }; // class Action
 
 // exported methods
 [[nodiscard]] std::string_view toString(ActionType at);
 [[nodiscard]] std::string_view toString(Street st);
+[[nodiscard]] ActionType toActionType(std::string_view actionType);
+[[nodiscard]] Street toStreet(std::string_view street);
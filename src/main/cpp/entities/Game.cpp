@@ -4,8 +4,6 @@
 #include "language/EnumMapper.hpp"
 #include "language/Validator.hpp"
 
-#include <ranges> // std::views
-
 static constexpr auto VARIANT_MAPPER = makeEnumMapper<Variant>(
     std::pair {Variant::holdem, "holdem"}, std::pair {Variant::omaha, "omaha"},
     std::pair {Variant::omaha5, "omaha5"}, std::pair {Variant::none, "none"});
@@ -42,20 +40,15 @@ Game::Game(const Params& args)
 Game::~Game() = default; // needed because Game owns private std::unique_ptr members
 
 void Game::addHand(std::unique_ptr<Hand> hand) {
+  m_playerHandIndex.add(*hand);
   m_hands.push_back(std::move(hand));
 }
 
-std::vector<const Hand*> Game::viewHands() const {
-  const auto handsView {m_hands |
-                        std::views::transform([](const auto& pHand) { return pHand.get(); })};
-  return {handsView.begin(), handsView.end()};
-}
-
-std::vector<const Hand*> Game::viewHands(std::string_view player) const {
-  auto r {
-      m_hands | std::views::transform([](const auto& pHand) { return pHand.get(); }) |
-      std::views::filter([player](const auto& pHand) { return pHand->isPlayerInvolved(player); })};
-  return {r.begin(), r.end()};
+/*[[nodiscard]]*/ MemoryUsage Game::getMemoryUsage() const noexcept {
+  return {.m_nbBytes = sizeof(Game) + memory::getHeapSize(m_id) + memory::getHeapSize(m_site) +
+                       memory::getHeapSize(m_name) + memory::getHeapSize(m_hands) +
+                       m_playerHandIndex.getMemoryUsage().m_nbBytes,
+          .m_nbObjects = 1};
 }
 
 Tournament::Tournament(const Params& p)
@@ -1,6 +1,8 @@
 #pragma once
 
-#include "system/Time.hpp" // std::string, std::string_view, Time
+#include "entities/PlayerHandIndex.hpp" // PlayerHandIndex, MemoryUsage, std::span
+#include "language/RangeUtils.hpp"      // phud::ranges::viewPointers
+#include "system/Time.hpp"              // std::string, std::string_view, Time
 
 #include <vector>
 
@@ -24,6 +26,7 @@ enum class /*[[nodiscard]]*/ Limit : short { none, noLimit, potLimit };
 class [[nodiscard]] Game final {
 private:
   // Memory layout optimized: largest to smallest to minimize padding
+  PlayerHandIndex m_playerHandIndex;
   std::string m_id;
   std::string m_site;
   std::string m_name;
@@ -57,13 +60,25 @@ public:
   [[nodiscard]] constexpr const std::string& getName() const noexcept { return m_name; }
   [[nodiscard]] constexpr bool isRealMoney() const noexcept { return m_isRealMoney; }
   [[nodiscard]] Time getStartDate() const noexcept { return m_startDate; }
-  [[nodiscard]] std::vector<const Hand*> viewHands() const;
-  [[nodiscard]] std::vector<const Hand*> viewHands(std::string_view player) const;
+  /**
+   * @returns a view of the hands, which allocates nothing
+   */
+  [[nodiscard]] auto viewHands() const noexcept { return phud::ranges::viewPointers(m_hands); }
+  /**
+   * @returns the hands the given player is involved in, found in the player hand index
+   */
+  [[nodiscard]] std::span<const Hand* const> viewHands(std::string_view player) const noexcept {
+    return m_playerHandIndex.viewHands(player);
+  }
   [[nodiscard]] constexpr const std::string& getSiteName() const noexcept { return m_site; }
   [[nodiscard]] constexpr const std::string& getId() const noexcept { return m_id; }
   [[nodiscard]] constexpr Variant getVariant() const noexcept { return m_variant; }
   [[nodiscard]] constexpr Limit getLimitType() const noexcept { return m_limitType; }
   [[nodiscard]] constexpr Seat getMaxNbSeats() const noexcept { return m_nbMaxSeats; }
+  /**
+   * @returns the memory held by the game, with its player hand index, without its hands
+   */
+  [[nodiscard]] MemoryUsage getMemoryUsage() const noexcept;
 }; // class Game
 
 class [[nodiscard]] Tournament final {
@@ -95,8 +110,8 @@ public:
   [[nodiscard]] constexpr const std::string& getName() const noexcept { return m_game->getName(); }
   [[nodiscard]] constexpr bool isRealMoney() const noexcept { return m_game->isRealMoney(); }
   [[nodiscard]] Time getStartDate() const noexcept { return m_game->getStartDate(); }
-  [[nodiscard]] std::vector<const Hand*> viewHands() const { return m_game->viewHands(); }
-  [[nodiscard]] std::vector<const Hand*> viewHands(std::string_view player) const {
+  [[nodiscard]] auto viewHands() const noexcept { return m_game->viewHands(); }
+  [[nodiscard]] std::span<const Hand* const> viewHands(std::string_view player) const noexcept {
     return m_game->viewHands(player);
   }
   [[nodiscard]] constexpr const std::string& getSiteName() const noexcept {
@@ -107,6 +122,13 @@ public:
   [[nodiscard]] constexpr Limit getLimitType() const noexcept { return m_game->getLimitType(); }
   [[nodiscard]] constexpr Seat getMaxNbSeats() const noexcept { return m_game->getMaxNbSeats(); }
   [[nodiscard]] constexpr double getBuyIn() const noexcept { return m_buyIn; }
+  /**
+   * @returns the memory held by the tournament, with its player hand index, without its hands
+   */
+  [[nodiscard]] MemoryUsage getMemoryUsage() const noexcept {
+    return {.m_nbBytes = sizeof(Tournament) + m_game->getMemoryUsage().m_nbBytes,
+            .m_nbObjects = 1};
+  }
 }; // class Tournament
 
 class [[nodiscard]] CashGame final {
@@ -140,8 +162,8 @@ public:
   [[nodiscard]] constexpr const std::string& getName() const noexcept { return m_game->getName(); }
   [[nodiscard]] constexpr bool isRealMoney() const noexcept { return m_game->isRealMoney(); }
   [[nodiscard]] Time getStartDate() const noexcept { return m_game->getStartDate(); }
-  [[nodiscard]] std::vector<const Hand*> viewHands() const { return m_game->viewHands(); }
-  [[nodiscard]] std::vector<const Hand*> viewHands(std::string_view player) const {
+  [[nodiscard]] auto viewHands() const noexcept { return m_game->viewHands(); }
+  [[nodiscard]] std::span<const Hand* const> viewHands(std::string_view player) const noexcept {
     return m_game->viewHands(player);
   }
   [[nodiscard]] constexpr const std::string& getSiteName() const noexcept {
@@ -153,6 +175,13 @@ public:
   [[nodiscard]] constexpr Seat getMaxNbSeats() const noexcept { return m_game->getMaxNbSeats(); }
   [[nodiscard]] constexpr double getSmallBlind() const noexcept { return m_smallBlind; }
   [[nodiscard]] constexpr double getBigBlind() const noexcept { return m_bigBlind; }
+  /**
+   * @returns the memory held by the cash game, with its player hand index, without its hands
+   */
+  [[nodiscard]] MemoryUsage getMemoryUsage() const noexcept {
+    return {.m_nbBytes = sizeof(CashGame) + m_game->getMemoryUsage().m_nbBytes,
+            .m_nbObjects = 1};
+  }
 }; // class CashGame
 
 // exported methods
@@ -2,7 +2,8 @@
 #include "entities/Hand.hpp"
 #include "language/Validator.hpp"
 #include "strings/StringUtils.hpp" // phud::strings::*
-#include <ranges>                  // std::ranges::find_if, std::views
+#include <numeric>                 // std::accumulate
+#include <ranges>                  // std::ranges::find_if
 #include <vector>
 
 namespace ps = phud::strings;
@@ -39,8 +40,15 @@ bool Hand::isWinner(std::string_view playerName) const noexcept {
   return std::ranges::find(m_winners, playerName.data()) != m_winners.end();
 }
 
-[[nodiscard]] std::vector<const Action*> Hand::viewActions() const {
-  auto actions_view =
-      m_actions | std::views::transform([](const auto& pAction) { return pAction.get(); });
-  return {actions_view.begin(), actions_view.end()};
+/*[[nodiscard]]*/ MemoryUsage Hand::getMemoryUsage() const noexcept {
+  const auto getHeapSize = [](const auto& strings) {
+    return std::accumulate(strings.begin(), strings.end(), std::size_t {0},
+                           [](std::size_t size, const auto& s) {
+                             return size + memory::getHeapSize(s);
+                           });
+  };
+  return {.m_nbBytes = sizeof(Hand) + getHeapSize(m_seats) + getHeapSize(m_winners) +
+                       memory::getHeapSize(m_id) + memory::getHeapSize(m_siteName) +
+                       memory::getHeapSize(m_tableName) + memory::getHeapSize(m_actions),
+          .m_nbObjects = 1};
 }
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "constants/TableConstants.hpp"
+#include "language/MemoryUsage.hpp" // MemoryUsage
+#include "language/RangeUtils.hpp"  // phud::ranges::viewPointers
 #include "system/Time.hpp" // Time, std::unique_ptr, std::string, std::string_view
 #include <array>
 #include <vector>
@@ -53,7 +55,10 @@ public:
   Hand& operator=(const Hand&) = delete;
   Hand& operator=(Hand&&) = delete;
   ~Hand();
-  [[nodiscard]] std::vector<const Action*> viewActions() const;
+  /**
+   * @returns a view of the actions, which allocates nothing
+   */
+  [[nodiscard]] auto viewActions() const noexcept { return phud::ranges::viewPointers(m_actions); }
   [[nodiscard]] constexpr const std::string& getId() const noexcept { return m_id; }
   [[nodiscard]] constexpr GameType getGameType() const noexcept { return m_gameType; }
   [[nodiscard]] constexpr const std::string& getSiteName() const noexcept { return m_siteName; }
@@ -79,4 +84,8 @@ public:
   [[nodiscard]] constexpr Card getBoardCard4() const noexcept { return m_boardCards.at(3); }
   [[nodiscard]] constexpr Card getBoardCard5() const noexcept { return m_boardCards.at(4); }
   [[nodiscard]] bool isWinner(std::string_view playerName) const noexcept;
+  /**
+   * @returns the memory held by the hand, without its actions
+   */
+  [[nodiscard]] MemoryUsage getMemoryUsage() const noexcept;
 }; // class Hand
@@ -10,3 +10,9 @@ Player::Player(const Params& p)
   validation::requireNonEmpty(m_name, "name");
   validation::requireNonEmpty(m_site, "site");
 }
+
+/*[[nodiscard]]*/ MemoryUsage Player::getMemoryUsage() const noexcept {
+  return {.m_nbBytes = sizeof(Player) + memory::getHeapSize(m_name) +
+                       memory::getHeapSize(m_site) + memory::getHeapSize(m_comments),
+          .m_nbObjects = 1};
+}
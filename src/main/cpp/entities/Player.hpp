@@ -1,6 +1,6 @@
 #pragma once
 
-#include <string>
+#include "language/MemoryUsage.hpp" // MemoryUsage, std::string
 #include <string_view>
 
 /**
@@ -32,4 +32,5 @@ public:
   [[nodiscard]] constexpr const std::string& getComments() const noexcept { return m_comments; }
   [[nodiscard]] constexpr bool isHero() const noexcept { return m_isHero; }
   constexpr void setIsHero(bool isHero) noexcept { m_isHero = isHero; }
+  [[nodiscard]] MemoryUsage getMemoryUsage() const noexcept;
 }; // class Player
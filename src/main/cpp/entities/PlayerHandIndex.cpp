@@ -0,0 +1,48 @@
+#include "entities/Action.hpp"          // Action
+#include "entities/Hand.hpp"            // Hand
+#include "entities/PlayerHandIndex.hpp" // PlayerHandIndex
+#include <algorithm>                    // std::ranges::for_each, std::ranges::copy
+#include <iterator>                     // std::back_inserter
+
+void PlayerHandIndex::add(const Hand& hand) {
+  std::ranges::for_each(hand.viewActions(), [this, &hand](const Action* pAction) {
+    const auto& player {pAction->getPlayerName()};
+    auto it {m_playerToHands.find(player)};
+
+    if (m_playerToHands.end() == it) {
+      it = m_playerToHands.try_emplace(player).first;
+    }
+
+    // a player acts several times in a hand, and the actions of a hand are added together
+    if (auto& hands {it->second}; hands.empty() or &hand != hands.back()) {
+      hands.push_back(&hand);
+    }
+  });
+}
+
+void PlayerHandIndex::merge(const PlayerHandIndex& other) {
+  m_playerToHands.reserve(m_playerToHands.size() + other.m_playerToHands.size());
+  std::ranges::for_each(other.m_playerToHands, [this](const auto& playerToHands) {
+    // no exact reserve, it would reallocate the hands of the player at each merge
+    std::ranges::copy(playerToHands.second,
+                      std::back_inserter(m_playerToHands[playerToHands.first]));
+  });
+}
+
+/*[[nodiscard]]*/ std::span<const Hand* const>
+PlayerHandIndex::viewHands(std::string_view player) const noexcept {
+  const auto it {m_playerToHands.find(player)};
+  return m_playerToHands.end() == it ? std::span<const Hand* const> {} : it->second;
+}
+
+/*[[nodiscard]]*/ MemoryUsage PlayerHandIndex::getMemoryUsage() const noexcept {
+  // a node holds the next node pointer, the cached hash and the entry
+  using Entry = decltype(m_playerToHands)::value_type;
+  constexpr auto NODE_SIZE {sizeof(void*) + sizeof(std::size_t) + sizeof(Entry)};
+  MemoryUsage ret {.m_nbBytes = m_playerToHands.bucket_count() * sizeof(void*), .m_nbObjects = 0};
+  std::ranges::for_each(m_playerToHands, [&ret](const auto& playerToHands) {
+    ret.m_nbBytes += NODE_SIZE + memory::getHeapSize(playerToHands.first) +
+                     memory::getHeapSize(playerToHands.second);
+  });
+  return ret;
+}
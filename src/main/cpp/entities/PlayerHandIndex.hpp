@@ -0,0 +1,53 @@
+#pragma once
+
+#include "language/MemoryUsage.hpp" // MemoryUsage
+#include <functional>               // std::equal_to, std::hash
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// forward declarations
+class Hand;
+
+/**
+ * The hands each player is involved in, i.e. the hands where the player acts, in the order they
+ * were added. Lets the per player queries cost the number of hands of the player, not the total
+ * one.
+ */
+class [[nodiscard]] PlayerHandIndex final {
+private:
+  // allows to find a player from a std::string_view without building a std::string
+  struct [[nodiscard]] StringHash final {
+    using is_transparent = void;
+
+    [[nodiscard]] std::size_t operator()(std::string_view s) const noexcept {
+      return std::hash<std::string_view> {}(s);
+    }
+  }; // struct StringHash
+
+  std::unordered_map<std::string, std::vector<const Hand*>, StringHash, std::equal_to<>>
+      m_playerToHands {};
+
+public:
+  /**
+   * Adds the given hand to the hands of each player acting in it. The hand must outlive the index.
+   */
+  void add(const Hand& hand);
+
+  /**
+   * Appends the hands of the given index to the ones of this index.
+   */
+  void merge(const PlayerHandIndex& other);
+
+  /**
+   * @returns the hands the given player is involved in, empty if the player is unknown
+   */
+  [[nodiscard]] std::span<const Hand* const> viewHands(std::string_view player) const noexcept;
+
+  /**
+   * @returns the memory held by the index, without the indexed hands
+   */
+  [[nodiscard]] MemoryUsage getMemoryUsage() const noexcept;
+}; // class PlayerHandIndex
@@ -1,9 +1,10 @@
+#include "entities/Action.hpp"
 #include "entities/Game.hpp" // CashGame, Tournament
+#include "entities/Hand.hpp"
 #include "entities/Site.hpp" // Site, Player
 #include "language/Validator.hpp"
-#include <algorithm> // std::move, also needed for std::ranges::transform, std::ranges::for_each
+#include <algorithm> // std::move, also needed for std::ranges::for_each
 #include <iterator>  // std::back_inserter
-#include <span>      // std::span
 
 Site::Site(std::string_view name)
   : m_name {name} {
@@ -12,16 +13,8 @@ Site::Site(std::string_view name)
 
 Site::~Site() = default; // needed because Site owns private std::unique_ptr members
 
-std::vector<const Player*> Site::viewPlayers() const {
-  std::vector<const Player*> ret;
-
-  if (false == m_players.empty()) {
-    ret.reserve(m_players.size());
-    std::ranges::transform(m_players, std::back_inserter(ret),
-                           [](const auto& entry) noexcept { return entry.second.get(); });
-  }
-
-  return ret;
+static void indexHands(PlayerHandIndex& index, const auto& game) {
+  std::ranges::for_each(game.viewHands(), [&index](const Hand* pHand) { index.add(*pHand); });
 }
 
 void Site::addPlayer(std::unique_ptr<Player> p) {
@@ -34,31 +27,16 @@ void Site::addPlayer(std::unique_ptr<Player> p) {
 
 void Site::addGame(std::unique_ptr<CashGame> cg) {
   validation::require(cg->getSiteName() == m_name, "game is on another site");
+  indexHands(m_playerHandIndex, *cg);
   m_cashGames.push_back(std::move(cg));
 }
 
 void Site::addGame(std::unique_ptr<Tournament> t) {
   validation::require(t->getSiteName() == m_name, "game is on another site");
+  indexHands(m_playerHandIndex, *t);
   m_tournaments.push_back(std::move(t));
 }
 
-template <typename T>
-static std::vector<const T*> view(std::span<const std::unique_ptr<T>> source) {
-  std::vector<const T*> ret;
-  ret.reserve(source.size());
-  std::ranges::transform(source, std::back_inserter(ret),
-                         [](const auto& pointer) { return pointer.get(); });
-  return ret;
-}
-
-std::vector<const CashGame*> Site::viewCashGames() const {
-  return view(std::span(m_cashGames));
-}
-
-std::vector<const Tournament*> Site::viewTournaments() const {
-  return view(std::span(m_tournaments));
-}
-
 void Site::merge(Site& other) {
   validation::require(other.getName() == m_name, "Can't merge data from different poker sites");
 
@@ -81,4 +59,47 @@ void Site::merge(Site& other) {
 
   std::ranges::move(other.m_cashGames, std::back_inserter(m_cashGames));
   std::ranges::move(other.m_tournaments, std::back_inserter(m_tournaments));
+  // the hands are moved with their games, so the indexed pointers stay valid
+  m_playerHandIndex.merge(other.m_playerHandIndex);
+  other.m_playerHandIndex = {};
+}
+
+/*[[nodiscard]]*/ std::size_t Site::getNbHands() const noexcept {
+  std::size_t ret = 0;
+  const auto addNbHands = [&ret](const auto& pGame) { ret += pGame->viewHands().size(); };
+  std::ranges::for_each(m_cashGames, addNbHands);
+  std::ranges::for_each(m_tournaments, addNbHands);
+  return ret;
+}
+
+/*[[nodiscard]]*/ SiteMemoryUsage Site::getMemoryUsage() const {
+  SiteMemoryUsage ret {};
+  // a player index node holds the next node pointer, the cached hash and the entry
+  using Entry = decltype(m_players)::value_type;
+  constexpr auto NODE_SIZE {sizeof(void*) + sizeof(std::size_t) + sizeof(Entry)};
+  ret.m_players.m_nbBytes = sizeof(Site) + m_players.bucket_count() * sizeof(void*) +
+                            m_playerHandIndex.getMemoryUsage().m_nbBytes;
+  std::ranges::for_each(m_players, [&ret](const auto& nameToPlayer) {
+    ret.m_players += nameToPlayer.second->getMemoryUsage();
+    ret.m_players.m_nbBytes += NODE_SIZE + memory::getHeapSize(nameToPlayer.first);
+  });
+  const auto addHands = [&ret](const auto& game) {
+    std::ranges::for_each(game.viewHands(), [&ret](const Hand* pHand) {
+      ret.m_hands += pHand->getMemoryUsage();
+      std::ranges::for_each(pHand->viewActions(), [&ret](const Action* pAction) {
+        ret.m_actions += pAction->getMemoryUsage();
+      });
+    });
+  };
+  ret.m_cashGames.m_nbBytes = memory::getHeapSize(m_cashGames);
+  std::ranges::for_each(m_cashGames, [&](const auto& pGame) {
+    ret.m_cashGames += pGame->getMemoryUsage();
+    addHands(*pGame);
+  });
+  ret.m_tournaments.m_nbBytes = memory::getHeapSize(m_tournaments);
+  std::ranges::for_each(m_tournaments, [&](const auto& pGame) {
+    ret.m_tournaments += pGame->getMemoryUsage();
+    addHands(*pGame);
+  });
+  return ret;
 }
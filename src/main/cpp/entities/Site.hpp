@@ -1,15 +1,34 @@
 #pragma once
 
-#include "entities/Player.hpp" // used in a std::unordered_map so must be a complete type
-#include <memory>              // std::unique_ptr
+#include "entities/Player.hpp"          // used in a std::unordered_map so must be a complete type
+#include "entities/PlayerHandIndex.hpp" // PlayerHandIndex, std::span
+#include "language/RangeUtils.hpp"      // phud::ranges::viewPointers
+#include <memory>                       // std::unique_ptr
+#include <ranges>                       // std::views
 #include <string>
 #include <string_view>
 #include <unordered_map>
 #include <vector>
 
 class CashGame;
+class Hand;
 class Tournament;
 
+/**
+ * The memory held by a Site, by kind of entity.
+ */
+struct [[nodiscard]] SiteMemoryUsage final {
+  MemoryUsage m_players;     // with the Site player index and player hand index
+  MemoryUsage m_cashGames;   // without their hands
+  MemoryUsage m_tournaments; // without their hands
+  MemoryUsage m_hands;       // without their actions
+  MemoryUsage m_actions;
+
+  [[nodiscard]] constexpr MemoryUsage getTotal() const noexcept {
+    return m_players + m_cashGames + m_tournaments + m_hands + m_actions;
+  }
+}; // struct SiteMemoryUsage
+
 /**
  * A Poker site, i.e. a bunch of hands played on different games. This entity is required to build
  * statistics on encountered players behavior.
@@ -20,6 +39,7 @@ private:
   std::unordered_map<std::string, std::unique_ptr<Player>> m_players {};
   std::vector<std::unique_ptr<CashGame>> m_cashGames {};
   std::vector<std::unique_ptr<Tournament>> m_tournaments {};
+  PlayerHandIndex m_playerHandIndex {};
 
 public:
   explicit Site(std::string_view name);
@@ -30,14 +50,40 @@ public:
   ~Site();
   void addPlayer(std::unique_ptr<Player> p);
   void addGame(std::unique_ptr<CashGame> cg);
-  [[nodiscard]] std::vector<const CashGame*> viewCashGames() const;
+  [[nodiscard]] auto viewCashGames() const noexcept {
+    return phud::ranges::viewPointers(m_cashGames);
+  }
   void addGame(std::unique_ptr<Tournament> t);
-  [[nodiscard]] std::vector<const Tournament*> viewTournaments() const;
+  [[nodiscard]] auto viewTournaments() const noexcept {
+    return phud::ranges::viewPointers(m_tournaments);
+  }
   [[nodiscard]] constexpr const std::string& getName() const noexcept { return m_name; }
-  [[nodiscard]] std::vector<const Player*> viewPlayers() const;
+  [[nodiscard]] auto viewPlayers() const noexcept {
+    return m_players | std::views::transform([](const auto& nameToPlayer) noexcept {
+             return static_cast<const Player*>(nameToPlayer.second.get());
+           });
+  }
+  /**
+   * @returns the hands of all the games the given player is involved in, found in the site player
+   * hand index. So the cost is the number of hands of the player, not the total one.
+   */
+  [[nodiscard]] std::span<const Hand* const> viewHands(std::string_view player) const noexcept {
+    return m_playerHandIndex.viewHands(player);
+  }
   [[nodiscard]] const Player* viewPlayer(std::string_view name) const {
     const auto p = m_players.find(std::string(name));
     return m_players.end() == p ? nullptr : p->second.get();
   }
+  /**
+   * Moves the players and games of the given site into this one.
+   */
   void merge(Site& other);
+  /**
+   * @returns the number of hands of all the games, without walking through the hands
+   */
+  [[nodiscard]] std::size_t getNbHands() const noexcept;
+  /**
+   * @returns an estimate of the memory held by the site, walking through all its entities
+   */
+  [[nodiscard]] SiteMemoryUsage getMemoryUsage() const;
 }; // class Site
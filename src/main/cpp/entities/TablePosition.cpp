@@ -0,0 +1,65 @@
+#include "entities/Seat.hpp"          // Seat, tableSeat
+#include "entities/TablePosition.hpp" // TablePosition, tablePosition
+#include "language/EnumMapper.hpp"    // makeEnumMapper
+#include <algorithm>                  // std::ranges::count
+
+namespace {
+  constexpr auto POSITION_MAPPER {makeEnumMapper<TablePosition>(
+      std::pair {TablePosition::button, "BTN"}, std::pair {TablePosition::cutOff, "CO"},
+      std::pair {TablePosition::middlePosition, "MP"},
+      std::pair {TablePosition::earlyPosition, "EP"}, std::pair {TablePosition::smallBlind, "SB"},
+      std::pair {TablePosition::bigBlind, "BB"}, std::pair {TablePosition::none, "none"})};
+
+  constexpr std::size_t NB_SEATS {TableConstants::MAX_SEATS};
+} // anonymous namespace
+
+/*[[nodiscard]]*/ tablePosition::SeatPositions
+tablePosition::fromSeats(const std::array<bool, TableConstants::MAX_SEATS>& isSeated,
+                         Seat buttonSeat) {
+  SeatPositions ret {};
+  ret.fill(TablePosition::none);
+  const auto nbPlayers {static_cast<std::size_t>(std::ranges::count(isSeated, true))};
+
+  if (0 == nbPlayers) {
+    return ret;
+  }
+
+  const auto button {tableSeat::toArrayIndex(buttonSeat)};
+  // the seats in the order of the preflop blinds, the button being the last one
+  std::array<std::size_t, NB_SEATS> order {};
+  std::size_t nbOrdered = 0;
+
+  for (std::size_t i = 1; i <= NB_SEATS; ++i) {
+    if (const auto seat {(button + i) % NB_SEATS}; isSeated[seat]) {
+      order[nbOrdered++] = seat;
+    }
+  }
+
+  ret[order[nbPlayers - 1]] = TablePosition::button;
+
+  if (2 == nbPlayers) {
+    ret[order[1]] = TablePosition::smallBlind;
+    ret[order[0]] = TablePosition::bigBlind;
+  } else if (2 < nbPlayers) {
+    ret[order[0]] = TablePosition::smallBlind;
+    ret[order[1]] = TablePosition::bigBlind;
+  }
+
+  if (3 < nbPlayers) {
+    ret[order[nbPlayers - 2]] = TablePosition::cutOff;
+    // the players acting before the cut-off, the first half being in early position
+    const auto nbBeforeCutOff {nbPlayers - 4};
+    const auto nbEarly {(nbBeforeCutOff + 1) / 2};
+
+    for (std::size_t i = 0; i < nbBeforeCutOff; ++i) {
+      ret[order[2 + i]] = i < nbEarly ? TablePosition::earlyPosition
+                                      : TablePosition::middlePosition;
+    }
+  }
+
+  return ret;
+}
+
+/*[[nodiscard]]*/ std::string_view tablePosition::toString(TablePosition position) {
+  return POSITION_MAPPER.toString(position);
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "constants/TableConstants.hpp" // TableConstants::MAX_SEATS
+#include <array>
+#include <cstddef> // std::size_t
+#include <string_view>
+
+// forward declarations
+enum class Seat : short;
+
+/**
+ * The position of a player at the table, relative to the button. The early and middle positions
+ * are shared by the players acting before the cut-off, half and half, so that the positions are
+ * adjusted for the number of players. Heads-up, the button is the small blind.
+ */
+enum class [[nodiscard]] TablePosition : short {
+  button,
+  cutOff,
+  middlePosition,
+  earlyPosition,
+  smallBlind,
+  bigBlind,
+  none
+};
+
+namespace tablePosition {
+  static constexpr std::size_t NB_POSITIONS {static_cast<std::size_t>(TablePosition::none)};
+
+  // the position of each seat, indexed as the seats
+  using SeatPositions = std::array<TablePosition, TableConstants::MAX_SEATS>;
+
+  /**
+   * @param isSeated tells for each seat, indexed as the seats, if a player sits on it
+   * @param buttonSeat if it is empty or unknown, the 1st seated player before it is the button
+   * @returns the position of each seated player, TablePosition::none for the empty seats
+   */
+  [[nodiscard]] SeatPositions
+  fromSeats(const std::array<bool, TableConstants::MAX_SEATS>& isSeated, Seat buttonSeat);
+
+  /*
+   * Transforms TablePosition::button into "BTN" and so on.
+   */
+  [[nodiscard]] std::string_view toString(TablePosition position);
+
+  /*
+   * Transforms TablePosition::button into 0 and so on.
+   */
+  [[nodiscard]] constexpr std::size_t toArrayIndex(TablePosition position) noexcept {
+    return static_cast<std::size_t>(position);
+  }
+} // namespace tablePosition
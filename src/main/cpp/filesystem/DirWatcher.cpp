@@ -4,7 +4,10 @@
 #include "log/Logger.hpp"            // CURRENT_FILE_NAME
 #include <efsw/efsw.hpp>
 #include <atomic>
+#include <condition_variable> // std::condition_variable_any
 #include <mutex>
+#include <thread> // std::jthread
+#include <unordered_map>
 
 namespace fs = std::filesystem;
 namespace pf = phud::filesystem;
@@ -14,12 +17,217 @@ static Logger& LOG() {
   return logger;
 }
 
+namespace {
+  // the recently changed files are rescanned often while they change, and less and less often while
+  // they don't
+  constexpr std::chrono::milliseconds MIN_POLLING_INTERVAL {250};
+  constexpr std::chrono::milliseconds MAX_POLLING_INTERVAL {4000};
+  // a file is rescanned apart from the directory until it has not changed for this duration
+  constexpr std::chrono::minutes RECENT_CHANGE_DURATION {2};
+  // the directory is scanned for the new files at a slower pace, which lasts at least 100 times the
+  // scan, so that polling takes less than 1% of a CPU
+  constexpr std::chrono::milliseconds MIN_DIR_SCAN_INTERVAL {1000};
+  constexpr int DIR_SCAN_INTERVAL_TO_SCAN_DURATION_RATIO {100};
+} // anonymous namespace
+
+/**
+ * Detects the changes by comparing the size and the last write time of the files. The recently
+ * changed files are checked apart from the scans of the directory, which find the new files.
+ */
+struct [[nodiscard]] PollingDirWatcher final : DirWatcher {
+private:
+  struct [[nodiscard]] FileState final {
+    // Memory layout optimized: largest to smallest to minimize padding
+    fs::file_time_type m_lastWriteTime;
+    // when the watcher saw the file change
+    std::chrono::steady_clock::time_point m_lastChange;
+    std::uintmax_t m_size;
+    std::size_t m_scan;
+  };
+
+  // Memory layout optimized: largest to smallest to minimize padding
+  // the file name -> its state at the last scan
+  std::unordered_map<std::string, FileState> m_files;
+  std::function<void(const fs::path&)> m_callback;
+  fs::path m_dir;
+  std::condition_variable_any m_cv;
+  std::mutex m_mutex;
+  std::jthread m_thread;
+  std::size_t m_nbScans {0};
+  std::atomic<bool> m_stopped {true};
+
+  void notifyChange(const std::string& fileName) const {
+    const auto filePath {m_dir / fileName};
+    LOG().info<"The file {} has changed (polling), notify listener">(filePath.string());
+    m_callback(filePath);
+  }
+
+  // @returns true if the file was modified since the previous scan
+  static bool update(FileState& state, std::uintmax_t size, fs::file_time_type lastWriteTime) {
+    if (size == state.m_size and lastWriteTime == state.m_lastWriteTime) {
+      return false;
+    }
+
+    state.m_size = size;
+    state.m_lastWriteTime = lastWriteTime;
+    state.m_lastChange = std::chrono::steady_clock::now();
+    return true;
+  }
+
+  // @returns true if a .txt file was added or modified since the previous scan
+  bool scanDir(bool notify) {
+    ++m_nbScans;
+    auto hasChanged {false};
+    std::error_code ec;
+
+    for (fs::directory_iterator it {m_dir, ec}, end; !ec and it != end; it.increment(ec)) {
+      // checks the extension before accessing the file attributes
+      if (".txt" == it->path().extension()) {
+        std::error_code sizeEc;
+        std::error_code timeEc;
+        const auto size {it->file_size(sizeEc)};
+        const auto lastWriteTime {it->last_write_time(timeEc)};
+
+        // the file may have been removed during the scan
+        if (sizeEc or timeEc) {
+          continue;
+        }
+
+        // the files present at the start are rescanned apart if they were written recently
+        const auto lastChange {
+            (fs::file_time_type::clock::now() - lastWriteTime < RECENT_CHANGE_DURATION)
+                ? std::chrono::steady_clock::now()
+                : std::chrono::steady_clock::time_point {}};
+        const auto [itFile, isAdded] {m_files.try_emplace(
+            it->path().filename().string(), lastWriteTime, lastChange, size, m_nbScans)};
+        itFile->second.m_scan = m_nbScans;
+
+        if (isAdded or update(itFile->second, size, lastWriteTime)) {
+          hasChanged = true;
+
+          if (notify) {
+            notifyChange(itFile->first);
+          }
+        }
+      }
+    }
+
+    if (ec) {
+      LOG().warn<"Couldn't scan the directory {}: {}">(m_dir.string(), ec.message());
+    }
+
+    std::erase_if(m_files, [this](const auto& p) { return p.second.m_scan != m_nbScans; });
+    return hasChanged;
+  }
+
+  // @returns true if a recently changed file was modified since the previous scan
+  bool scanRecentlyChangedFiles() {
+    const auto recently {std::chrono::steady_clock::now() - RECENT_CHANGE_DURATION};
+    auto hasChanged {false};
+
+    for (auto& [fileName, state] : m_files) {
+      if (state.m_lastChange < recently) {
+        continue;
+      }
+
+      std::error_code sizeEc;
+      std::error_code timeEc;
+      const auto file {m_dir / fileName};
+      const auto size {fs::file_size(file, sizeEc)};
+      const auto lastWriteTime {fs::last_write_time(file, timeEc)};
+
+      // the removed files are forgotten by the next scan of the directory
+      if (!sizeEc and !timeEc and update(state, size, lastWriteTime)) {
+        hasChanged = true;
+        notifyChange(fileName);
+      }
+    }
+
+    return hasChanged;
+  }
+
+  void poll(const std::stop_token& stopToken) {
+    auto interval {MIN_POLLING_INTERVAL};
+    auto dirScanInterval {MIN_DIR_SCAN_INTERVAL};
+    auto nextDirScan {std::chrono::steady_clock::now() + dirScanInterval};
+
+    while (!stopToken.stop_requested()) {
+      {
+        // only woken up by the stop request
+        std::unique_lock lock {m_mutex};
+        m_cv.wait_until(lock, stopToken,
+                        std::min(std::chrono::steady_clock::now() + interval, nextDirScan),
+                        [] { return false; });
+      }
+
+      if (stopToken.stop_requested()) {
+        return;
+      }
+
+      auto hasChanged {false};
+
+      if (const auto scanStart {std::chrono::steady_clock::now()}; nextDirScan <= scanStart) {
+        hasChanged = scanDir(true);
+        const auto scanEnd {std::chrono::steady_clock::now()};
+        dirScanInterval =
+            std::max(MIN_DIR_SCAN_INTERVAL,
+                     std::chrono::duration_cast<std::chrono::milliseconds>(scanEnd - scanStart) *
+                         DIR_SCAN_INTERVAL_TO_SCAN_DURATION_RATIO);
+        nextDirScan = scanEnd + dirScanInterval;
+      } else {
+        hasChanged = scanRecentlyChangedFiles();
+      }
+
+      interval = hasChanged ? MIN_POLLING_INTERVAL : std::min(interval * 2, MAX_POLLING_INTERVAL);
+    }
+  }
+
+public:
+  explicit PollingDirWatcher(const fs::path& dir)
+    : m_dir {dir} {
+    validation::require(pf::isDir(m_dir), "the dir provided to DirWatcher() is not valid.");
+    LOG().info<"will watch directory {} using polling">(dir.string());
+  }
+
+  PollingDirWatcher(const PollingDirWatcher&) = delete;
+  PollingDirWatcher(PollingDirWatcher&&) = delete;
+  PollingDirWatcher& operator=(const PollingDirWatcher&) = delete;
+  PollingDirWatcher& operator=(PollingDirWatcher&&) = delete;
+  ~PollingDirWatcher() override { PollingDirWatcher::stop(); }
+
+  void start(const std::function<void(const fs::path&)>& fileHasChangedCb) override {
+    stop();
+    m_callback = fileHasChangedCb;
+    // the files present at the start are not notified
+    m_files.clear();
+    scanDir(false);
+    m_stopped = false;
+    m_thread = std::jthread([this](const std::stop_token& stopToken) { poll(stopToken); });
+    LOG().info<"Started polling directory {}">(m_dir.string());
+  }
+
+  void stop() override {
+    if (!m_stopped.load()) {
+      m_stopped = true;
+      // waits for the running scan, so that the callback isn't called after the stop
+      m_thread.request_stop();
+      m_thread.join();
+      m_callback = nullptr;
+      LOG().info<"Stopped polling directory {}">(m_dir.string());
+    }
+  }
+
+  [[nodiscard]] bool isStopped() const noexcept override { return m_stopped.load(); }
+}; // struct PollingDirWatcher
+
 struct [[nodiscard]] DirWatcherImpl final : DirWatcher, efsw::FileWatchListener {
 private:
   // Memory layout optimized: largest to smallest to minimize padding
   efsw::FileWatcher m_watcher;
   std::function<void(const fs::path&)> m_callback;
   fs::path m_dir;
+  // used when the directory can't be watched natively
+  std::unique_ptr<PollingDirWatcher> m_pPollingWatcher;
   std::mutex m_callbackMutex;
   efsw::WatchID m_watchId;
   std::atomic<bool> m_stopped {true};
@@ -70,7 +278,9 @@ public:
     m_watchId = m_watcher.addWatch(m_dir.string(), this, isRecursive);
 
     if (0 > m_watchId) {
-      LOG().error<"Failed to add watch for directory {}">(m_dir.string());
+      LOG().warn<"Failed to add watch for directory {}, falling back to polling">(m_dir.string());
+      m_pPollingWatcher = std::make_unique<PollingDirWatcher>(m_dir);
+      m_pPollingWatcher->start(fileHasChangedCb);
       return;
     }
 
@@ -80,6 +290,11 @@ public:
   }
 
   void stop() override {
+    if (nullptr != m_pPollingWatcher) {
+      m_pPollingWatcher->stop();
+      m_pPollingWatcher.reset();
+    }
+
     if (!m_stopped.load()) {
       m_stopped = true;
       m_watcher.removeWatch(m_watchId);
@@ -92,11 +307,18 @@ public:
     }
   }
 
-  [[nodiscard]] bool isStopped() const noexcept override { return m_stopped.load(); }
+  [[nodiscard]] bool isStopped() const noexcept override {
+    return nullptr == m_pPollingWatcher ? m_stopped.load() : m_pPollingWatcher->isStopped();
+  }
 }; // class DirWatcherImpl
 
 DirWatcher::~DirWatcher() = default;
 
-[[nodiscard]] std::unique_ptr<DirWatcher> DirWatcher::create(const fs::path& dir) {
+[[nodiscard]] std::unique_ptr<DirWatcher> DirWatcher::create(const fs::path& dir,
+                                                             Backend backend) {
+  if (Backend::polling == backend) {
+    return std::make_unique<PollingDirWatcher>(dir);
+  }
+
   return std::make_unique<DirWatcherImpl>(dir);
 }
@@ -7,14 +7,23 @@
 
 class [[nodiscard]] DirWatcher /*final*/ {
 public:
+  enum class /*[[nodiscard]]*/ Backend : short {
+    // native OS file system events, falling back to polling if the directory can't be watched
+    native,
+    // scans of the directory, for the synced or network folders lacking reliable notifications
+    polling
+  };
+
   /**
    * @param dir The directory to watch for file changes
+   * @param backend How the changes are detected
    * @return A unique pointer to the DirWatcher instance
    */
-  [[nodiscard]] static std::unique_ptr<DirWatcher> create(const std::filesystem::path& dir);
+  [[nodiscard]] static std::unique_ptr<DirWatcher> create(const std::filesystem::path& dir,
+                                                          Backend backend = Backend::native);
   virtual ~DirWatcher();
   /**
-   * Watches the previously provided directory using native OS file system events.
+   * Watches the previously provided directory.
    * Each time a .txt file inside changes (Modified or Add action), the callback is called.
    * Call stop() or destroy to stop the watching.
    * @param fileHasChangedCb called each time a file changes
@@ -1,6 +1,7 @@
 #include "filesystem/FileUtils.hpp" // std::filesystem::path, std::string_view, std::vector
 #include "language/Validator.hpp"   // validation::
 #include "log/Logger.hpp"           // CURRENT_FILE_NAME
+#include "log/Metrics.hpp"          // Metrics
 #include "system/Time.hpp"          // WINAMAX_HISTORY_TIME_FORMAT
 #include <gsl/gsl>                  // std::streamsize
 #include <chrono>                   // to_time_t
@@ -50,6 +51,7 @@ std::string phud::filesystem::readToString(const fs::path& p) {
   std::string result(gsl::narrow_cast<std::string::size_type>(in.gcount()), '\0');
   in.seekg(0);
   in.read(result.data(), gsl::narrow_cast<std::streamsize>(result.size()));
+  Metrics::getNbBytesRead().increment(result.size());
   return result;
 }
 
@@ -153,6 +155,62 @@ std::string phud::filesystem::toString(const fs::file_time_type& ft) {
   return oss.str();
 }
 
+namespace {
+  /**
+   * @returns the YYYYMMDD prefix of the given file name, or an empty string if there is none.
+   */
+  [[nodiscard]] std::string getDatePrefix(const fs::path& file) {
+    constexpr std::size_t DATE_PREFIX_LENGTH {8};
+    auto stem = file.stem().string();
+
+    if (stem.size() < DATE_PREFIX_LENGTH or
+        !std::ranges::all_of(stem | std::views::take(DATE_PREFIX_LENGTH),
+                             [](char c) { return '0' <= c and c <= '9'; })) {
+      return "";
+    }
+
+    stem.resize(DATE_PREFIX_LENGTH);
+    return stem;
+  }
+
+  struct [[nodiscard]] DatedFile final {
+    // Memory layout optimized: largest to smallest to minimize padding
+    fs::path m_file;
+    std::string m_datePrefix;
+    fs::file_time_type m_lastWriteTime;
+  };
+} // anonymous namespace
+
+/* [[nodiscard]] */
+std::vector<fs::path> phud::filesystem::sortByMostRecentFirst(std::vector<fs::path> files) {
+  // compute the sort keys once, as last_write_time() is a system call
+  std::vector<DatedFile> datedFiles;
+  datedFiles.reserve(files.size());
+  std::ranges::transform(files, std::back_inserter(datedFiles), [](auto& file) {
+    std::error_code ec;
+    auto lastWriteTime = fs::last_write_time(file, ec);
+
+    if (ec) {
+      lastWriteTime = fs::file_time_type::min();
+    }
+
+    auto datePrefix = getDatePrefix(file);
+    return DatedFile {.m_file = std::move(file),
+                      .m_datePrefix = std::move(datePrefix),
+                      .m_lastWriteTime = lastWriteTime};
+  });
+  std::ranges::stable_sort(datedFiles, [](const DatedFile& a, const DatedFile& b) {
+    if (a.m_datePrefix != b.m_datePrefix) {
+      return a.m_datePrefix > b.m_datePrefix;
+    }
+    return a.m_lastWriteTime > b.m_lastWriteTime;
+  });
+  files.clear();
+  std::ranges::transform(datedFiles, std::back_inserter(files),
+                         [](auto& datedFile) { return std::move(datedFile.m_file); });
+  return files;
+}
+
 /* [[nodiscard]] */
 bool phud::filesystem::containsAFileEndingWith(std::span<const fs::path> files,
                                                std::string_view str) {
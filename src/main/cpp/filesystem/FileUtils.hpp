@@ -75,6 +75,17 @@ namespace phud::filesystem {
 
   [[nodiscard]] std::string toString(const std::filesystem::file_time_type& ft);
 
+  /**
+   * Sorts the given files so that the most recent come first. The recency is given by the
+   * YYYYMMDD date prefix of the file name when present (as in Winamax history files), then by the
+   * last modification time.
+   * @param files the files to sort
+   * @returns the sorted files.
+   */
+  [[nodiscard]] std::vector<std::filesystem::path>
+  sortByMostRecentFirst(std::vector<std::filesystem::path> files);
+  std::vector<std::filesystem::path> sortByMostRecentFirst(auto) = delete; // use only path
+
   [[nodiscard]] bool containsAFileEndingWith(std::span<const std::filesystem::path> files,
                                              std::string_view str);
 
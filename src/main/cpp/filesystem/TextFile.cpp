@@ -10,6 +10,10 @@ TextFile::TextFile(const fs::path& file)
   : m_content {pf::readToString(file)},
     m_file {file} {}
 
+TextFile::TextFile(const fs::path& file, std::string content)
+  : m_content {std::move(content)},
+    m_file {file} {}
+
 TextFile::~TextFile() = default;
 
 bool TextFile::next() {
@@ -18,6 +18,10 @@ private:
 public:
   explicit TextFile(const std::filesystem::path& file);
   explicit TextFile(auto file) = delete; // use only std::filesystem::path
+  /**
+   * Reads the given content instead of the file content, the file being only used to name it.
+   */
+  TextFile(const std::filesystem::path& file, std::string content);
 
   TextFile(const TextFile&) = delete;
   TextFile(TextFile&&) = delete;
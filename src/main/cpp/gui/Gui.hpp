@@ -1,6 +1,7 @@
 #pragma once
 
-#include <memory> // std::unique_ptr
+#include <filesystem> // std::filesystem::path
+#include <memory>     // std::unique_ptr
 #include <string_view>
 
 // forward declarations
@@ -25,6 +26,11 @@ public:
   Gui& operator=(const Gui&) = delete;
   Gui& operator=(Gui&&) = delete;
   ~Gui();
+  /**
+   * Imports the given valid history directory in the background once the GUI runs, reporting the
+   * progress, and monitors its tables meanwhile.
+   */
+  void importHistory(const std::filesystem::path& historyDir);
   /**
    * Starts the GUI.
    * @returns 0 if OK
@@ -354,7 +354,7 @@ namespace {
     for (auto it = tableToPlayerIndicators.begin(); it != tableToPlayerIndicators.end();) {
       if (const auto title = it->first; !std::ranges::contains(tableWindowTitles, title)) {
         // Stop monitoring this table
-        tableService.stopProducingStats();
+        tableService.stopProducingStats(title);
         // Clear all player indicators for this table
         auto& playerIndicators = it->second;
         std::ranges::for_each(playerIndicators, [](auto& pi) { pi.reset(); });
@@ -446,6 +446,36 @@ namespace {
       LOG().error<"Unknown exception in importDirAwakeCb">();
     }
   }
+  /**
+   * Monitors the tables of the given valid history directory, and imports it in the background.
+   * The stats already in the database are available during the import.
+   */
+  void importHistoryDir(Gui::Implementation& self, const fs::path& dir) {
+    self.m_historyService.setHistoryDir(dir); // Set the history directory in the service
+    self.m_tableService.setHistoryDir(dir);
+
+    // Connect HistoryService and TableService
+    if (const auto pokerSiteHistory = self.m_historyService.getPokerSiteHistory();
+        nullptr != pokerSiteHistory) {
+      self.m_tableService.setPokerSiteHistory(pokerSiteHistory);
+    }
+
+    // Schedule the rest of the UI updates and import
+    scheduleUITask([pb = self.m_progressBar, chb = self.m_chooseHistoDirBtn,
+                    historyService = &self.m_historyService, dir]() {
+      try {
+        LOG().info<"About to start import process">();
+        // Start import
+        importDirAwakeCb(pb, chb, *historyService, dir);
+        LOG().info<"Import process started successfully">();
+      } catch (const std::exception& e) {
+        LOG().error<"Exception in UI task: {}">(e.what());
+      } catch (...) {
+        LOG().error<"Unknown exception in UI task">();
+      }
+    });
+  }
+
   namespace DirectoryChoiceHandler {
     void handleOk(std::string_view dirName, Gui::Implementation& self);
     void handleError(const Fl_Native_File_Chooser& chooser, Gui::Implementation& self);
@@ -456,32 +486,10 @@ namespace {
 
       if (self.m_historyService.isValidHistory(dir)) {
         self.m_preferences->saveHistoryDirectory(dir);
-        self.m_historyService.setHistoryDir(dir); // Set the history directory in the service
-
-        // Connect HistoryService and TableService
-        if (const auto pokerSiteHistory = self.m_historyService.getPokerSiteHistory();
-            nullptr != pokerSiteHistory) {
-          self.m_tableService.setPokerSiteHistory(pokerSiteHistory);
-        }
-
         // Update directory label immediately (synchronously) to avoid pointer issues
         const auto& label = self.m_preferences->getHistoryDirectoryDisplayLabel();
         self.m_histoDirTextField->copy_label(label.c_str());
-
-        // Schedule the rest of the UI updates and import
-        scheduleUITask([pb = self.m_progressBar, chb = self.m_chooseHistoDirBtn,
-                        historyService = &self.m_historyService, dir]() {
-          try {
-            LOG().info<"About to start import process">();
-            // Start import
-            importDirAwakeCb(pb, chb, *historyService, dir);
-            LOG().info<"Import process started successfully">();
-          } catch (const std::exception& e) {
-            LOG().error<"Exception in UI task: {}">(e.what());
-          } catch (...) {
-            LOG().error<"Unknown exception in UI task">();
-          }
-        });
+        importHistoryDir(self, dir);
       } else {
         LOG().info<"the chosen directory '{}' is not a valid history dir">(dir.string());
         informUser<MainWindow::Label::invalidChoice>(self);
@@ -659,6 +667,11 @@ Gui::Gui(TableService& tableService, HistoryService& historyService)
 
 Gui::~Gui() = default;
 
+void Gui::importHistory(const fs::path& historyDir) {
+  LOG().info<"Catching up with the history directory '{}'">(historyDir.string());
+  importHistoryDir(*m_pImpl, historyDir);
+}
+
 /**
  * GUI entry point. will exit when all the windows are closed.
  */
@@ -1,6 +1,7 @@
 #include "db/Database.hpp"
 #include "entities/Site.hpp"
 #include "gui/HistoryService.hpp"
+#include "gui/IngestService.hpp"
 #include "history/PokerSiteHistory.hpp"
 #include "log/Logger.hpp"
 #include "threads/ThreadPool.hpp"        // Future
@@ -13,14 +14,36 @@ static Logger& LOG() {
 
 namespace fs = std::filesystem;
 
+namespace {
+  // runs in the load thread, so it should not throw
+  void saveBatch(Database& database, const Site& batch) {
+    try {
+      database.save(batch);
+    } catch (const DatabaseException& e) {
+      LOG().error<"Exception during the database usage: {}.">(e.what());
+    } catch (...) {
+      LOG().error<"Unknown during the database usage.">();
+    }
+  }
+} // anonymous namespace
+
 struct [[nodiscard]] HistoryService::Implementation final {
   Database& m_database;
   std::shared_ptr<PokerSiteHistory> m_pokerSiteHistory {};
   Future<void> m_loadTask {};
   fs::path m_historyDir {};
+  IngestService m_ingestService;
 
   explicit Implementation(Database& database)
-    : m_database {database} {}
+    : m_database {database},
+      m_ingestService {database} {}
+
+  // the hands played while the history is imported are saved as well
+  void startIngesting(const fs::path& dir) {
+    if (!m_ingestService.start(dir)) {
+      LOG().warn<"The hands appended to the history of '{}' won't be saved">(dir.string());
+    }
+  }
 };
 
 HistoryService::HistoryService(Database& database)
@@ -44,13 +67,21 @@ void HistoryService::importHistory(const fs::path& dir, const std::function<void
                                    const std::function<void(std::size_t)>& onSetNbFiles,
                                    const std::function<void()>& onDone) {
   m_pImpl->m_historyDir = dir.lexically_normal();
+  // starts tailing before the import reads the files, so that no appended hand is missed. The
+  // hands read twice are saved once, as the database ignores the hands and actions already saved.
+  m_pImpl->startIngesting(dir);
   m_pImpl->m_loadTask =
-      ThreadPool::submit([this, dir, onProgress, onSetNbFiles]() {
+      ThreadPool::submit(ThreadPool::TaskCategory::importParse,
+                         [this, dir, onProgress, onSetNbFiles]() {
         // as this method will execute in another thread, it should not throw
         try {
           if (m_pImpl->m_pokerSiteHistory = PokerSiteHistory::newInstance(dir);
               m_pImpl->m_pokerSiteHistory) {
-            return m_pImpl->m_pokerSiteHistory->load(dir, onProgress, onSetNbFiles);
+            // import the most recent files first and save them as soon as they are parsed, so
+            // that the stats of the players currently met are available early
+            return m_pImpl->m_pokerSiteHistory->load(
+                dir, onProgress, onSetNbFiles, ImportOrder::mostRecentFirst,
+                [this](const Site& batch) { saveBatch(m_pImpl->m_database, batch); });
           }
         } catch (const std::exception& e) {
           LOG().error<"Unexpected exception during the history import: {}.">(e.what());
@@ -60,7 +91,7 @@ void HistoryService::importHistory(const fs::path& dir, const std::function<void
 
         return std::unique_ptr<Site>();
       })
-          .then([this](const auto& pSite) {
+          .then(ThreadPool::recorded(ThreadPool::TaskCategory::dbSave, [this](const auto& pSite) {
             try {
               if (pSite) {
                 m_pImpl->m_database.save(*pSite);
@@ -70,7 +101,7 @@ void HistoryService::importHistory(const fs::path& dir, const std::function<void
             } catch (...) {
               LOG().error<"Unknown during the database usage.">();
             }
-          })
+          }))
           .then([onDone]() {
             if (onDone) {
               onDone();
@@ -82,6 +113,10 @@ void HistoryService::setHistoryDir(const fs::path& dir) {
   m_pImpl->m_historyDir = dir;
   LOG().info<"Chosen Poker Site History Directory: {}">(dir.string());
   m_pImpl->m_pokerSiteHistory = PokerSiteHistory::newInstance(m_pImpl->m_historyDir);
+
+  if (nullptr != m_pImpl->m_pokerSiteHistory) {
+    m_pImpl->startIngesting(dir);
+  }
 }
 
 void HistoryService::stopImportingHistory() {
@@ -94,6 +129,7 @@ void HistoryService::stopImportingHistory() {
   }
 
   m_pImpl->m_loadTask.reset();
+  m_pImpl->m_ingestService.stop();
 }
 
 std::shared_ptr<PokerSiteHistory> HistoryService::getPokerSiteHistory() const {
@@ -34,7 +34,7 @@ public:
   [[nodiscard]] virtual bool isValidHistory(const std::filesystem::path& dir);
 
   /**
-   * Imports history from the given directory.
+   * Imports history from the given directory, then keeps saving the hands appended to it.
    * @param dir Directory containing history files
    * @param onProgress Callback called for each file processed
    * @param onSetNbFiles Callback called when total file count is known
@@ -46,12 +46,12 @@ public:
                              const std::function<void()>& onDone);
 
   /**
-   * Stops importing history.
+   * Stops importing history, and saving the hands appended to it.
    */
   virtual void stopImportingHistory();
 
   /**
-   * Sets the current history directory.
+   * Sets the current history directory, and starts saving the hands appended to its files.
    * @param dir History directory path
    */
   virtual void setHistoryDir(const std::filesystem::path& dir);
@@ -0,0 +1,178 @@
+#include "gui/HudLatency.hpp" // ReloadTrace, HudLatency, ReloadStage, std::chrono, std::string
+#include "log/Logger.hpp"    // CURRENT_FILE_NAME, fmt::format_to
+#include "log/Metrics.hpp"   // Metrics
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <ranges>
+
+static Logger& LOG() {
+  static auto logger = Logger(CURRENT_FILE_NAME);
+  return logger;
+}
+
+namespace {
+  constexpr std::array<ReloadStage, NB_RELOAD_STAGES> STAGES {
+      ReloadStage::fileChanged, ReloadStage::fileReloaded, ReloadStage::statisticsRead,
+      ReloadStage::observerNotified};
+
+  [[nodiscard]] constexpr std::size_t toIndex(ReloadStage stage) noexcept {
+    return static_cast<std::size_t>(stage);
+  }
+
+  [[nodiscard]] double toMillis(std::chrono::steady_clock::duration d) noexcept {
+    return std::chrono::duration<double, std::milli>(d).count();
+  }
+
+  [[nodiscard]] std::uint64_t newCorrelationId() noexcept {
+    static std::atomic<std::uint64_t> lastId {0};
+    return lastId.fetch_add(1, std::memory_order_relaxed) + 1;
+  }
+
+  // use a lazy singleton to avoid the static initialization fiasco
+  struct [[nodiscard]] RecentReloads final {
+    std::deque<ReloadTrace> m_reloads {};
+    std::mutex m_mutex {};
+  }; // struct RecentReloads
+
+  // intentional leak to avoid exit-time destructor warning
+  RecentReloads& getRecentReloads() {
+    static auto* instance {new RecentReloads()};
+    return *instance;
+  }
+
+  void exportMetrics(const ReloadTrace& reload) {
+    Metrics::getHudRefreshLatency(reload.getTable()).observe(reload.getTotalDuration());
+    const auto tableLabel {Metrics::toLabel("table", reload.getTable())};
+    std::ranges::for_each(STAGES | std::views::drop(1), [&](ReloadStage stage) {
+      if (reload.isMarked(stage)) {
+        Metrics::getHistogram(
+            "phud_hud_reload_stage_seconds", "Duration of each stage of the HUD refresh.",
+            fmt::format("{},{}", tableLabel, Metrics::toLabel("stage", toString(stage))))
+            .observe(reload.getStageDuration(stage));
+      }
+    });
+  }
+} // anonymous namespace
+
+/*[[nodiscard]]*/ std::string_view toString(ReloadStage stage) noexcept {
+  switch (stage) {
+    case ReloadStage::fileChanged: return "fileChanged";
+    case ReloadStage::fileReloaded: return "fileReloaded";
+    case ReloadStage::statisticsRead: return "statisticsRead";
+    case ReloadStage::observerNotified: return "observerNotified";
+  }
+
+  return "unknown";
+}
+
+ReloadTrace::ReloadTrace(std::string_view table,
+                         std::chrono::steady_clock::time_point fileChangeTime)
+  : m_table {table},
+    m_id {newCorrelationId()} {
+  mark(ReloadStage::fileChanged, fileChangeTime);
+}
+
+void ReloadTrace::mark(ReloadStage stage, std::chrono::steady_clock::time_point time) {
+  m_timestamps.at(toIndex(stage)) = time;
+}
+
+/*[[nodiscard]]*/ bool ReloadTrace::isMarked(ReloadStage stage) const noexcept {
+  return std::chrono::steady_clock::time_point() != m_timestamps[toIndex(stage)];
+}
+
+/*[[nodiscard]]*/ std::chrono::steady_clock::duration
+ReloadTrace::getStageDuration(ReloadStage stage) const {
+  const auto index {toIndex(stage)};
+
+  if (0 == index or !isMarked(stage) or !isMarked(STAGES.at(index - 1))) {
+    return {};
+  }
+
+  return m_timestamps[index] - m_timestamps[index - 1];
+}
+
+/*[[nodiscard]]*/ std::chrono::steady_clock::duration ReloadTrace::getTotalDuration() const {
+  const auto reversedStages {STAGES | std::views::reverse};
+  const auto last {std::ranges::find_if(reversedStages,
+                                        [this](ReloadStage stage) { return isMarked(stage); })};
+  return reversedStages.end() == last
+             ? std::chrono::steady_clock::duration()
+             : m_timestamps[toIndex(*last)] - m_timestamps[toIndex(ReloadStage::fileChanged)];
+}
+
+/*[[nodiscard]]*/ std::string ReloadTrace::toString() const {
+  std::string ret;
+  auto out {std::back_inserter(ret)};
+  fmt::format_to(out, "reload #{} of '{}': {:.1f} ms (", m_id, m_table,
+                 toMillis(getTotalDuration()));
+  auto separator {""};
+
+  for (const auto stage : STAGES | std::views::drop(1)) {
+    if (isMarked(stage)) {
+      fmt::format_to(out, "{}{} {:.1f} ms", separator, ::toString(stage),
+                     toMillis(getStageDuration(stage)));
+      separator = ", ";
+    }
+  }
+
+  ret.push_back(')');
+  return ret;
+}
+
+void HudLatency::record(const ReloadTrace& reload) {
+  exportMetrics(reload);
+
+  if (reload.getTotalDuration() > TARGET) {
+    LOG().warn<"HUD latency target of {} ms missed by {}">(TARGET.count(), reload.toString());
+  } else {
+    LOG().debug<"{}">(reload.toString());
+  }
+
+  auto& recent {getRecentReloads()};
+  const std::scoped_lock lock {recent.m_mutex};
+
+  if (NB_RECENT_RELOADS == recent.m_reloads.size()) {
+    recent.m_reloads.pop_front();
+  }
+
+  recent.m_reloads.push_back(reload);
+}
+
+/*[[nodiscard]]*/ std::vector<ReloadTrace> HudLatency::getSlowestRecentReloads(std::size_t nb) {
+  std::vector<ReloadTrace> ret;
+  {
+    auto& recent {getRecentReloads()};
+    const std::scoped_lock lock {recent.m_mutex};
+    ret.assign(recent.m_reloads.begin(), recent.m_reloads.end());
+  }
+  const auto middle {ret.begin() + static_cast<std::ptrdiff_t>(std::min(nb, ret.size()))};
+  std::ranges::partial_sort(ret, middle, std::greater {}, &ReloadTrace::getTotalDuration);
+  ret.erase(middle, ret.end());
+  return ret;
+}
+
+/*[[nodiscard]]*/ std::optional<std::chrono::steady_clock::duration>
+HudLatency::getRecentP99(std::string_view table) {
+  std::vector<std::chrono::steady_clock::duration> durations;
+  {
+    auto& recent {getRecentReloads()};
+    const std::scoped_lock lock {recent.m_mutex};
+
+    for (const auto& reload : recent.m_reloads) {
+      if (table == reload.getTable()) {
+        durations.push_back(reload.getTotalDuration());
+      }
+    }
+  }
+
+  if (durations.empty()) {
+    return {};
+  }
+
+  // nearest rank: the smallest duration greater or equal to 99% of the durations
+  const auto rank {(durations.size() * 99 + 99) / 100 - 1};
+  const auto nth {durations.begin() + static_cast<std::ptrdiff_t>(rank)};
+  std::ranges::nth_element(durations, nth);
+  return *nth;
+}
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint64_t
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * The stages of the HUD critical path, in order. The hands are saved in the database after the HUD
+ * update, out of this path.
+ */
+enum class /*[[nodiscard]]*/ ReloadStage : short {
+  fileChanged,     // the file watcher saw the history file modification
+  fileReloaded,    // the history file is parsed
+  statisticsRead,  // the hands are counted and the table statistics assembled, in memory
+  observerNotified // the GUI observer got the statistics
+};
+
+inline constexpr std::size_t NB_RELOAD_STAGES {4};
+
+[[nodiscard]] std::string_view toString(ReloadStage stage) noexcept;
+
+/**
+ * The timestamps of the stages of a history file reload, from the file change to the HUD update.
+ * Each reload gets a unique correlation id, to be found in the logs. Not thread safe: the stages
+ * are marked one after the other.
+ */
+class [[nodiscard]] ReloadTrace final {
+private:
+  // Memory layout optimized: largest to smallest to minimize padding
+  std::string m_table;
+  std::array<std::chrono::steady_clock::time_point, NB_RELOAD_STAGES> m_timestamps {};
+  std::uint64_t m_id;
+
+public:
+  /**
+   * Marks the fileChanged stage at the given time.
+   */
+  explicit ReloadTrace(std::string_view table,
+                       std::chrono::steady_clock::time_point fileChangeTime =
+                           std::chrono::steady_clock::now());
+
+  void mark(ReloadStage stage,
+            std::chrono::steady_clock::time_point time = std::chrono::steady_clock::now());
+  [[nodiscard]] std::uint64_t getId() const noexcept { return m_id; }
+  [[nodiscard]] std::string_view getTable() const noexcept { return m_table; }
+  [[nodiscard]] bool isMarked(ReloadStage stage) const noexcept;
+
+  /**
+   * @returns the duration from the previous stage to the given one, 0 if one of them is not marked
+   */
+  [[nodiscard]] std::chrono::steady_clock::duration getStageDuration(ReloadStage stage) const;
+
+  /**
+   * @returns the duration from the file change to the last marked stage
+   */
+  [[nodiscard]] std::chrono::steady_clock::duration getTotalDuration() const;
+
+  /**
+   * @returns e.g. "reload #3 of 'Colorado 1': 41.2 ms (fileReloaded 2.1 ms, statisticsRead 0.3 ms...)"
+   */
+  [[nodiscard]] std::string toString() const;
+}; // class ReloadTrace
+
+/**
+ * Aggregates the completed reloads into per table latency histograms, and keeps the recent
+ * reloads to find the stage breaking the latency target.
+ */
+namespace HudLatency {
+  /**
+   * The HUD should be updated within this duration after a history file change, at the 99th
+   * percentile.
+   */
+  inline constexpr std::chrono::milliseconds TARGET {150};
+
+  /**
+   * The number of recent reloads kept.
+   */
+  inline constexpr std::size_t NB_RECENT_RELOADS {256};
+
+  /**
+   * Records a completed reload: exports its total and stage durations as metrics, keeps it among
+   * the recent reloads, and logs a warning with its stage breakdown if it is slower than TARGET.
+   * Thread safe.
+   */
+  void record(const ReloadTrace& reload);
+
+  /**
+   * @returns the at most nb slowest recent reloads, the slowest first. Thread safe.
+   */
+  [[nodiscard]] std::vector<ReloadTrace> getSlowestRecentReloads(std::size_t nb);
+
+  /**
+   * @returns the 99th percentile of the total duration of the recent reloads of the given table,
+   * or nothing if the table has no recent reload. Thread safe.
+   */
+  [[nodiscard]] std::optional<std::chrono::steady_clock::duration>
+  getRecentP99(std::string_view table);
+} // namespace HudLatency
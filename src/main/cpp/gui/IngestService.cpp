@@ -0,0 +1,198 @@
+#include "db/Database.hpp"              // Database, DatabaseException
+#include "entities/Site.hpp"            // Site
+#include "filesystem/DirWatcher.hpp"    // DirWatcher
+#include "filesystem/FileUtils.hpp"     // phud::filesystem::*
+#include "gui/IngestService.hpp"        // IngestService, std::filesystem::path
+#include "history/PokerSiteHistory.hpp" // PokerSiteHistory
+#include "log/Logger.hpp"               // CURRENT_FILE_NAME
+#include "log/Metrics.hpp"              // Metrics
+#include "threads/PeriodicTask.hpp"     // PeriodicTask
+#include <array>
+#include <atomic>
+#include <fstream>  // std::ifstream
+#include <iterator> // std::istreambuf_iterator
+#include <mutex>
+#include <set>
+#include <string>
+#include <unordered_map>
+
+static Logger& LOG() {
+  static auto logger = Logger(CURRENT_FILE_NAME);
+  return logger;
+}
+
+namespace fs = std::filesystem;
+namespace pf = phud::filesystem;
+
+namespace {
+  constexpr std::string_view UTF8_BOM {"\xEF\xBB\xBF"};
+  // Winamax writes two empty lines after each hand
+  constexpr std::array HAND_ENDS {std::string_view {"\n\n\n"}, std::string_view {"\r\n\r\n\r\n"}};
+
+  // @returns the size of the complete hands at the start of the given text
+  [[nodiscard]] std::size_t getCompleteHandsSize(std::string_view text) {
+    std::size_t ret = 0;
+    std::ranges::for_each(HAND_ENDS, [&](auto handEnd) {
+      if (const auto pos {text.rfind(handEnd)}; std::string_view::npos != pos) {
+        ret = std::max(ret, pos + handEnd.size());
+      }
+    });
+    return ret;
+  }
+
+  [[nodiscard]] std::string readFrom(const fs::path& file, std::uintmax_t offset) {
+    std::ifstream in {file, std::ios::binary};
+    in.seekg(static_cast<std::streamoff>(offset));
+    std::string ret {std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+    Metrics::getNbBytesRead().increment(ret.size());
+    return ret;
+  }
+} // anonymous namespace
+
+struct [[nodiscard]] IngestService::Implementation final {
+  // Memory layout optimized: largest to smallest to minimize padding
+  // the history file name -> the size of its content already ingested, only used by the task
+  std::unordered_map<std::string, std::uintmax_t> m_fileToOffset {};
+  std::set<fs::path> m_changedFiles {};
+  std::shared_ptr<PokerSiteHistory> m_pokerSiteHistory {};
+  std::unique_ptr<DirWatcher> m_pDirWatcher {};
+  std::unique_ptr<PeriodicTask> m_pTask {};
+  std::mutex m_mutex {}; // guards m_changedFiles
+  std::atomic<std::size_t> m_nbIngestedHands {0};
+  Database& m_database;
+
+  explicit Implementation(Database& database)
+    : m_database {database} {}
+
+  // called by the directory watcher thread
+  void onFileChanged(const fs::path& file) {
+    const std::scoped_lock lock {m_mutex};
+    m_changedFiles.insert(file);
+  }
+
+  PeriodicTaskStatus ingestChangedFiles() {
+    std::set<fs::path> files;
+    {
+      const std::scoped_lock lock {m_mutex};
+      files.swap(m_changedFiles);
+    }
+    std::ranges::for_each(files, [this](const auto& file) { ingest(file); });
+    return PeriodicTaskStatus::repeatTask;
+  }
+
+  void ingest(const fs::path& file) {
+    std::error_code ec;
+    const auto fileSize {fs::file_size(file, ec)};
+
+    if (ec) {
+      LOG().warn<"Couldn't get the size of {}: {}">(file.string(), ec.message());
+      return;
+    }
+
+    // a file created after the start is ingested from its beginning
+    auto& offset {m_fileToOffset[file.filename().string()]};
+
+    if (fileSize < offset) {
+      LOG().warn<"The file {} was truncated, ingesting it again">(file.string());
+      offset = 0;
+    }
+
+    if (fileSize == offset) {
+      return;
+    }
+
+    auto hands {readFrom(file, offset)};
+    const auto completeHandsSize {getCompleteHandsSize(hands)};
+
+    // the hand being written is ingested with the next change
+    if (0 == completeHandsSize) {
+      return;
+    }
+
+    hands.resize(completeHandsSize);
+
+    if (0 == offset and hands.starts_with(UTF8_BOM)) {
+      hands.erase(0, UTF8_BOM.size());
+    }
+
+    offset += completeHandsSize;
+    const auto pSite {m_pokerSiteHistory->parseAppendedHands(file, std::move(hands))};
+
+    // the parsing error is already logged
+    if (nullptr == pSite) {
+      return;
+    }
+
+    // the hands of a monitored table are also saved by the reload of its file, the database
+    // ignores the hands and actions already saved
+    try {
+      m_database.save(*pSite);
+      const auto nbHands {pSite->getNbHands()};
+      m_nbIngestedHands += nbHands;
+      LOG().info<"Ingested {} hand(s) appended to {}">(nbHands, file.filename().string());
+    } catch (const std::exception& e) {
+      LOG().error<"Couldn't save the hands appended to {}: {}">(file.string(), e.what());
+    }
+  }
+}; // struct IngestService::Implementation
+
+IngestService::IngestService(Database& database)
+  : m_pImpl {std::make_unique<Implementation>(database)} {}
+
+IngestService::~IngestService() {
+  try {
+    stop();
+  } catch (...) {
+    LOG().error<"Unknown Error when stopping the ingestion in the IngestService destruction.">();
+  }
+}
+
+/*[[nodiscard]]*/ bool IngestService::start(const fs::path& historyDir,
+                                            std::chrono::milliseconds period) {
+  stop();
+  m_pImpl->m_pokerSiteHistory = PokerSiteHistory::newInstance(historyDir);
+
+  if (nullptr == m_pImpl->m_pokerSiteHistory) {
+    LOG().error<"Can't ingest the hands of the invalid history directory {}">(
+        historyDir.string());
+    return false;
+  }
+
+  const auto dir {historyDir / "history"};
+  LOG().info<"Ingesting the hands appended to the files of {}">(dir.string());
+  // the offsets are taken before the watch starts, so that no appended hand is missed
+  m_pImpl->m_fileToOffset.clear();
+  std::ranges::for_each(pf::listTxtFilesInDir(dir), [this](const auto& file) {
+    std::error_code ec;
+    m_pImpl->m_fileToOffset[file.filename().string()] = fs::file_size(file, ec);
+  });
+  m_pImpl->m_pDirWatcher = DirWatcher::create(dir);
+  m_pImpl->m_pDirWatcher->start(
+      [pImpl = m_pImpl.get()](const fs::path& file) { pImpl->onFileChanged(file); });
+  m_pImpl->m_pTask = std::make_unique<PeriodicTask>(period, CURRENT_FILE_NAME);
+  m_pImpl->m_pTask->start([pImpl = m_pImpl.get()]() { return pImpl->ingestChangedFiles(); });
+  return true;
+}
+
+void IngestService::stop() {
+  if (nullptr != m_pImpl->m_pDirWatcher) {
+    m_pImpl->m_pDirWatcher->stop();
+    m_pImpl->m_pDirWatcher.reset();
+  }
+
+  if (nullptr != m_pImpl->m_pTask) {
+    m_pImpl->m_pTask->stop();
+    m_pImpl->m_pTask.reset();
+  }
+
+  const std::scoped_lock lock {m_pImpl->m_mutex};
+  m_pImpl->m_changedFiles.clear();
+}
+
+/*[[nodiscard]]*/ bool IngestService::isStarted() const noexcept {
+  return nullptr != m_pImpl->m_pTask;
+}
+
+/*[[nodiscard]]*/ std::size_t IngestService::getNbIngestedHands() const noexcept {
+  return m_pImpl->m_nbIngestedHands.load();
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>    // std::size_t
+#include <filesystem> // std::filesystem::path
+#include <memory>     // std::unique_ptr
+
+// forward declarations
+class Database;
+
+/**
+ * Keeps the database current while playing: the history files are tailed, and the hands appended
+ * to them are saved, whatever their table, monitored by the TableService or not.
+ * The changed files are read by a single periodic task, which only parses the complete hands
+ * appended since its previous pass. So the ingestion uses at most one thread pool worker, at most
+ * once per period, whatever the number of tables played.
+ */
+class [[nodiscard]] IngestService final {
+private:
+  struct Implementation;
+  std::unique_ptr<Implementation> m_pImpl;
+
+public:
+  static constexpr std::chrono::milliseconds DEFAULT_PERIOD {500};
+
+  explicit IngestService(Database& database);
+  IngestService(const IngestService&) = delete;
+  IngestService(IngestService&&) = delete;
+  IngestService& operator=(const IngestService&) = delete;
+  IngestService& operator=(IngestService&&) = delete;
+  ~IngestService();
+
+  /**
+   * Starts ingesting the hands appended from now on to the files of <historyDir>/history. The
+   * current content of the files is left to the history import. Restarts the ingestion if it is
+   * already started.
+   * @param period the delay between two passes on the changed files
+   * @returns false if historyDir is not a valid history directory
+   */
+  [[nodiscard]] bool start(const std::filesystem::path& historyDir,
+                           std::chrono::milliseconds period = DEFAULT_PERIOD);
+
+  /**
+   * Stops the ingestion, waiting for the running pass if any.
+   */
+  void stop();
+
+  [[nodiscard]] bool isStarted() const noexcept;
+
+  /**
+   * @returns the number of hands saved since the creation of the service. Thread safe.
+   */
+  [[nodiscard]] std::size_t getNbIngestedHands() const noexcept;
+}; // class IngestService
@@ -1,21 +1,30 @@
 #include "constants/ProgramInfos.hpp"
 #include "db/Database.hpp"
+#include "db/HandStore.hpp" // HandStore
 #include "entities/Seat.hpp"
 #include "entities/Site.hpp"
+#include "filesystem/DirWatcher.hpp" // DirWatcher
+#include "gui/HudLatency.hpp" // ReloadTrace, HudLatency
 #include "gui/TableService.hpp"
 #include "history/PokerSiteHistory.hpp"
 #include "log/Logger.hpp"
+#include "log/Metrics.hpp" // Metrics
+#include "log/Tracer.hpp"  // TraceSpan
 #include "statistics/PlayerStatistics.hpp"
+#include "statistics/StatsStore.hpp" // StatsStore
 #include "statistics/TableStatistics.hpp"
-#include "threads/ThreadPool.hpp" // Future
-#include <efsw/efsw.hpp>
+#include "threads/DelayedExecutor.hpp" // DelayedExecutor
+#include "threads/ThreadPool.hpp"      // Future
 #include <spdlog/fmt/fmt.h>
-#include <stlab/concurrency/utility.hpp>
-#include <atomic>
+#include <stlab/concurrency/utility.hpp> // stlab::await
 #include <chrono>
+#include <condition_variable>
 #include <filesystem>
 #include <mutex>
 #include <optional>
+#include <ranges>
+#include <unordered_map>
+#include <vector>
 
 namespace fs = std::filesystem;
 
@@ -24,145 +33,368 @@ static Logger& LOG() {
   return logger;
 }
 
-/**
- * EFSW-based file watcher for a single file.
- * Monitors a specific file and triggers callback on modifications.
- */
-class [[nodiscard]] EfswFileWatcher final : public efsw::FileWatchListener {
-private:
-  // Memory layout optimized: largest to smallest to minimize padding
-  efsw::FileWatcher m_watcher;
-  std::function<void(const fs::path&)> m_callback;
-  fs::path m_file;
-  std::string m_filename; // Cache filename for fast comparison
-  std::mutex m_callbackMutex;
-  efsw::WatchID m_watchId;
-  std::atomic<bool> m_stopped {true};
-
-  void handleFileAction([[maybe_unused]] efsw::WatchID watchid,
-                        [[maybe_unused]] const std::string& dir, const std::string& filename,
-                        efsw::Action action, [[maybe_unused]] std::string oldFilename) override {
-    // Fast path: filter by action and filename before any expensive operations
-    if (efsw::Actions::Modified != action || filename != m_filename) {
+static void notify(TableStatistics&& stats, const TableService::TableObserverCallback& observerCb) {
+  if (Seat::seatUnknown == stats.getMaxSeat()) {
+    LOG().info<"Got no stats from db.">();
+  } else {
+    LOG().info<"Got {} player stats objects.">(tableSeat::toInt(stats.getMaxSeat()));
+    LOG().info<"Calling observer with statistics...">();
+    observerCb(std::move(stats));
+  }
+}
+
+[[nodiscard]] static std::optional<TableStatistics>
+extractTableStatistics(const StatsStore& store, std::string_view table) {
+  LOG().info<"Extracting table statistics for table: {}">(table);
+  if (auto stats {store.getTableStatistics(table)}; stats.isValid()) {
+    LOG().info<"Got stats from memory.">();
+    return stats;
+  }
+  LOG().info<"Got no stats yet for table {} on site {}.">(table,
+                                                          ProgramInfos::WINAMAX_SITE_NAME);
+  return {};
+}
+
+// counts the hands saved before the start, e.g. by a previous run. A database which predates the
+// hand store has none, or a partial one: it is then rebuilt from the database.
+static void loadStatsStore(Database& database, StatsStore& store) {
+  const auto file {database.getHandStoreFile()};
+
+  if (file.empty()) {
+    return;
+  }
+
+  try {
+    // counted before reading the hand store, as a save writes the database then the hand store
+    const auto nbSavedHands {database.getNbHands()};
+
+    if (const HandStore::Reader reader {file}; nbSavedHands <= reader.viewHands().size()) {
+      LOG().info<"{} hands of the hand store counted">(store.load(reader));
       return;
     }
 
-    LOG().info<"The file {} has changed, notify listener">(m_file.string());
+    LOG().warn<"The hand store {} misses hands of the database, rebuilding it">(file.string());
+    database.rebuildHandStore();
+    const HandStore::Reader reader {file};
+    LOG().info<"{} hands of the hand store counted">(store.load(reader));
+  } catch (const std::exception& e) { // the reloads wait for the loading, which must not fail
+    LOG().error<"Couldn't read the hand store {}: {}">(file.string(), e.what());
+  }
+}
+
+namespace {
+  /**
+   * The reload lane of a monitored table: its history file reloads run one after the other, and
+   * the lanes of different tables run in parallel. As Winamax writes a hand in several chunks,
+   * the changes are coalesced: a reload waits for the coalescing window before reading the file,
+   * the changes seen meanwhile joining it, and the changes seen while it reads the file make a
+   * single pending reload, started when it ends.
+   */
+  class [[nodiscard]] TableSubscription final
+    : public std::enable_shared_from_this<TableSubscription> {
+  private:
+    // Memory layout optimized: largest to smallest to minimize padding
+    std::condition_variable m_idle {};
+    TableService::TableObserverCallback m_observerCb;
+    std::shared_ptr<PokerSiteHistory> m_pokerSiteHistory;
+    std::shared_ptr<ReloadTrace> m_pPendingReload {};
+    fs::path m_file;
+    std::string m_table;
+    std::string m_filename; // Cache filename for fast comparison
+    std::mutex m_mutex {};
+    std::chrono::milliseconds m_coalescingWindow;
+    Database& m_database;
+    StatsStore& m_statsStore;
+    const DelayedExecutor& m_delayedExecutor;
+    // the reloads wait for the hands saved before the start to be counted
+    Future<void> m_statsStoreLoaded;
+    bool m_isRunning = false;
+    bool m_isReading = false; // the running reload doesn't take new changes anymore
+    bool m_isStopped = false;
 
-    // Call user callback in thread-safe manner
-    std::scoped_lock lock {m_callbackMutex};
-    if (m_callback) {
-      m_callback(m_file); // Reuse cached m_file instead of reconstructing path
+    void run(std::shared_ptr<ReloadTrace> pReload) {
+      LOG().info<"File watcher triggered for: {}, reload #{}">(m_file.string(), pReload->getId());
+      Metrics::getNbHistoryFileReloads().increment();
+
+      // lets the next chunks of the hand being written join the reload, without blocking a pool
+      // worker meanwhile
+      if (0 < m_coalescingWindow.count()) {
+        m_delayedExecutor.executeAfter(
+            m_coalescingWindow, [self = shared_from_this(), pReload]() { self->read(pReload); });
+      } else {
+        read(pReload);
+      }
     }
-  }
 
-public:
-  explicit EfswFileWatcher(const fs::path& file)
-    : m_file {file},
-      m_filename {file.filename().string()},
-      m_watchId {-1} {
-    LOG().info<"will watch file {} using EFSW (event-driven)">(file.string());
-  }
+    void read(const std::shared_ptr<ReloadTrace>& pReload) {
+      {
+        const std::scoped_lock lock {m_mutex};
+        m_isReading = true;
+      }
 
-  EfswFileWatcher(const EfswFileWatcher&) = delete;
-  EfswFileWatcher(EfswFileWatcher&&) = delete;
-  EfswFileWatcher& operator=(const EfswFileWatcher&) = delete;
-  EfswFileWatcher& operator=(EfswFileWatcher&&) = delete;
+      m_statsStoreLoaded
+          .then(ThreadPool::recorded(
+              ThreadPool::TaskCategory::importParse, [self = shared_from_this(), pReload]() {
+                const TraceSpan span {"reloadFile"};
+                LOG().debug<"Notified, reloading the file\n{}">(self->m_file.string());
+                // shared, to be saved once the statistics are notified
+                std::shared_ptr<const Site> ret {
+                    self->m_pokerSiteHistory->reloadFile(self->m_file)};
+                pReload->mark(ReloadStage::fileReloaded);
+                return ret;
+              }))
+          .then(ThreadPool::recorded(
+              ThreadPool::TaskCategory::statsRead,
+              [self = shared_from_this(), pReload](const std::shared_ptr<const Site>& pSite) {
+                const TraceSpan span {"extractTableStatistics"};
 
-  void start(const std::function<void(const fs::path&)>& fileHasChangedCb) {
-    std::scoped_lock lock {m_callbackMutex};
-    m_callback = fileHasChangedCb;
+                // the parsing error is already logged
+                if (nullptr != pSite) {
+                  self->m_statsStore.add(*pSite);
+                }
 
-    // Watch the parent directory of the file
-    const auto parentDir = m_file.parent_path().string();
-    m_watchId = m_watcher.addWatch(parentDir, this, false);
+                LOG().info<"in threadpool : Extracting table statistics for table: {}">(
+                    self->m_table);
+                auto ret {std::make_pair(pSite, extractTableStatistics(self->m_statsStore,
+                                                                       self->m_table))};
+                pReload->mark(ReloadStage::statisticsRead);
+                return ret;
+              }))
+          .then([self = shared_from_this(),
+                 pReload](std::pair<std::shared_ptr<const Site>, std::optional<TableStatistics>>&&
+                              siteAndStats) {
+            const TraceSpan span {"notifyObserver"};
 
-    if (0 > m_watchId) {
-      LOG().error<"Failed to add watch for file {}">(m_file.string());
-      return;
+            if (auto& ots {siteAndStats.second}; ots.has_value()) {
+              LOG().info<"in threadpool : Notifying observer with table statistics">();
+              notify(std::move(ots.value()), self->m_observerCb);
+              pReload->mark(ReloadStage::observerNotified);
+              HudLatency::record(*pReload);
+            } else {
+              LOG().warn<"in threadpool : No statistics found for reload #{}">(pReload->getId());
+            }
+
+            return std::move(siteAndStats.first);
+          })
+          // the hands are persisted once the HUD is updated
+          .then(ThreadPool::recorded(
+              ThreadPool::TaskCategory::dbSave,
+              [self = shared_from_this()](const std::shared_ptr<const Site>& pSite) {
+                const TraceSpan span {"saveReloadedSite"};
+                LOG().info<"in threadpool : Saving poker site data to database">();
+
+                if (nullptr != pSite) {
+                  self->m_database.save(*pSite);
+                }
+              }))
+          .recover([self = shared_from_this(), pReload](const Future<void>& reload) {
+            if (const auto pException {reload.exception()}) {
+              try {
+                std::rethrow_exception(pException);
+              } catch (const std::exception& e) {
+                LOG().error<"Reload #{} of {} failed: {}">(pReload->getId(), self->m_file.string(),
+                                                           e.what());
+              } catch (...) {
+                LOG().error<"Reload #{} of {} failed: unknown error">(pReload->getId(),
+                                                                      self->m_file.string());
+              }
+            }
+
+            self->onReloadEnd();
+          })
+          .detach();
     }
 
-    m_watcher.watch();
-    m_stopped = false;
-    LOG().info<"Started watching file {} (WatchID: {})">(m_file.string(), m_watchId);
-  }
+    void onReloadEnd() {
+      std::shared_ptr<ReloadTrace> pNext;
+      {
+        const std::scoped_lock lock {m_mutex};
+
+        if (nullptr == m_pPendingReload) {
+          m_isRunning = false;
+          m_idle.notify_all();
+          return;
+        }
 
-  void stop() {
-    if (!m_stopped.load()) {
-      m_watcher.removeWatch(m_watchId);
-      m_stopped.store(true);
-      LOG().info<"Stopped watching file {}">(m_file.string());
+        pNext = std::move(m_pPendingReload);
+        m_isReading = false;
+      }
+      run(std::move(pNext));
     }
-  }
 
-  [[nodiscard]] bool isStopped() const noexcept { return m_stopped.load(); }
-};
+  public:
+    struct [[nodiscard]] Params final {
+      Database& database;
+      StatsStore& statsStore;
+      const DelayedExecutor& delayedExecutor;
+      const Future<void>& statsStoreLoaded;
+      std::shared_ptr<PokerSiteHistory> pokerSiteHistory;
+      const fs::path& file;
+      std::string_view table;
+      const TableService::TableObserverCallback& observerCb;
+      std::chrono::milliseconds coalescingWindow;
+    }; // struct Params
+
+    explicit TableSubscription(const Params& p)
+      : m_observerCb {p.observerCb},
+        m_pokerSiteHistory {p.pokerSiteHistory},
+        m_file {p.file},
+        m_table {p.table},
+        m_filename {p.file.filename().string()},
+        m_coalescingWindow {p.coalescingWindow},
+        m_database {p.database},
+        m_statsStore {p.statsStore},
+        m_delayedExecutor {p.delayedExecutor},
+        m_statsStoreLoaded {p.statsStoreLoaded} {}
+
+    TableSubscription(const TableSubscription&) = delete;
+    TableSubscription(TableSubscription&&) = delete;
+    TableSubscription& operator=(const TableSubscription&) = delete;
+    TableSubscription& operator=(TableSubscription&&) = delete;
+    ~TableSubscription() = default;
+
+    [[nodiscard]] bool isWatching(const fs::path& file) const {
+      return file.filename() == m_filename;
+    }
+
+    /**
+     * Reloads the history file, unless the change joins the running or the pending reload.
+     */
+    void reload() {
+      std::shared_ptr<ReloadTrace> pReload;
+      {
+        const std::scoped_lock lock {m_mutex};
+
+        if (m_isStopped or (m_isRunning and !m_isReading) or nullptr != m_pPendingReload) {
+          LOG().debug<"The change of {} joins a reload">(m_file.string());
+          return;
+        }
+
+        // the reload timestamps, shared by the continuations which run one after the other
+        pReload = std::make_shared<ReloadTrace>(m_table);
+
+        if (m_isRunning) {
+          LOG().debug<"Reload #{} of {} waits for the running one">(pReload->getId(),
+                                                                    m_file.string());
+          m_pPendingReload = std::move(pReload);
+          return;
+        }
+
+        m_isRunning = true;
+        m_isReading = false;
+      }
+      run(std::move(pReload));
+    }
+
+    /**
+     * Cancels the pending reload and waits for the running one.
+     */
+    void stop() {
+      std::unique_lock lock {m_mutex};
+      m_isStopped = true;
+      m_pPendingReload.reset();
+      m_idle.wait(lock, [this] { return !m_isRunning; });
+      LOG().info<"Stopped producing stats for table {}">(m_table);
+    }
+  }; // class TableSubscription
+} // anonymous namespace
 
 struct [[nodiscard]] TableService::Implementation final {
-  Database& m_database;
-  std::unique_ptr<EfswFileWatcher> m_fileWatcher {};
+  // Memory layout optimized: largest to smallest to minimize padding
+  // the table window title -> its subscription
+  std::unordered_map<std::string, std::shared_ptr<TableSubscription>> m_subscriptions {};
+  // shared by the subscriptions, started by the first one and stopped with the last one
+  std::unique_ptr<DirWatcher> m_pDirWatcher {};
   std::shared_ptr<PokerSiteHistory> m_pokerSiteHistory {};
-  Future<void> m_reloadTask {};
   fs::path m_historyDir {};
+  std::mutex m_mutex {};
+  // the statistics of the monitored tables, shared by the subscriptions
+  StatsStore m_statsStore {ProgramInfos::WINAMAX_SITE_NAME};
+  // the hands saved before the start are counted once, when the service is created
+  Future<void> m_statsStoreLoaded {};
+  // waits for the coalescing windows of the subscriptions
+  DelayedExecutor m_delayedExecutor {};
+  std::chrono::milliseconds m_coalescingWindow {TableService::DEFAULT_COALESCING_WINDOW};
+  Database& m_database;
+  // feeds the statistics with the hands saved by any service, e.g. the history import
+  std::size_t m_siteObserverId;
 
   explicit Implementation(Database& database)
-    : m_database {database} {}
-
-  [[nodiscard]] static std::optional<TableStatistics>
-  extractTableStatistics(const Database& database, std::string_view table) {
-    LOG().info<"Extracting table statistics for table: {}">(table);
-    if (auto stats {database.readTableStatistics("Winamax", table)}; stats.isValid()) {
-      LOG().info<"Got stats from db.">();
-      return stats;
+    : m_database {database},
+      m_siteObserverId {database.addSiteObserver([this](const Site& site) {
+        if (ProgramInfos::WINAMAX_SITE_NAME == site.getName()) {
+          m_statsStore.add(site);
+        }
+      })} {
+    m_statsStoreLoaded = ThreadPool::submit(ThreadPool::TaskCategory::statsRead,
+                                            [this]() { loadStatsStore(m_database, m_statsStore); });
+  }
+
+  Implementation(const Implementation&) = delete;
+  Implementation(Implementation&&) = delete;
+  Implementation& operator=(const Implementation&) = delete;
+  Implementation& operator=(Implementation&&) = delete;
+
+  ~Implementation() {
+    try {
+      m_database.removeSiteObserver(m_siteObserverId);
+      stlab::await(std::move(m_statsStoreLoaded));
+    } catch (...) { // can't throw in a destructor
+      LOG().error<"Unknown error when stopping the statistics feed.">();
     }
-    LOG().info<"Got no stats from db yet for table {} on site {}.">(table, "Winamax");
-    return {};
   }
 
-  static std::unique_ptr<EfswFileWatcher> watchHistoFile(
-      Future<void>& reloadTask,
-      std::shared_ptr<PokerSiteHistory> pokerSiteHistory, // NOLINT(*-unnecessary-value-param)
-      Database& database, const fs::path& file, std::string_view aTable, const auto& observerCb) {
-    LOG().info<"Starting to watch history file: {} for table: {}">(file.string(), aTable);
-    auto fileWatcher = std::make_unique<EfswFileWatcher>(file);
-    fileWatcher->start([&reloadTask, &database, pokerSiteHistory, table = std::string(aTable),
-                        observerCb](const fs::path& f) {
-      LOG().info<"File watcher triggered for: {}">(f.string());
-      reloadTask =
-          ThreadPool::submit([pokerSiteHistory, table, observerCb, f]() {
-            LOG().debug<"Notified, reloading the file\n{}">(f.string());
-            return pokerSiteHistory->reloadFile(f);
-          })
-              .then([&database](const auto& pSite) {
-                LOG().info<"in threadpool : Saving poker site data to database">();
-                database.save(*pSite);
-              })
-              .then([&database, table]() {
-                LOG().info<"in threadpool : Extracting table statistics for table: {}">(table);
-                return extractTableStatistics(database, table);
-              })
-              .then([observerCb](std::optional<TableStatistics>&& ots) {
-                if (ots.has_value()) {
-                  LOG().info<"in threadpool : Notifying observer with table statistics">();
-                  notify(std::move(ots.value()), observerCb);
-                } else {
-                  LOG().warn<"in threadpool : No statistics found">();
-                }
-              });
+  // called by the directory watcher thread
+  void dispatch(const fs::path& file) {
+    std::vector<std::shared_ptr<TableSubscription>> subscriptions;
+    {
+      const std::scoped_lock lock {m_mutex};
+      std::ranges::copy_if(m_subscriptions | std::views::values,
+                           std::back_inserter(subscriptions),
+                           [&file](const auto& pSubscription) {
+                             return pSubscription->isWatching(file);
+                           });
+    }
+    // the reloads are started without the lock, as they may run in this thread
+    std::ranges::for_each(subscriptions, [](const auto& pSubscription) {
+      Metrics::getNbHistoryFileChanges().increment();
+      pSubscription->reload();
     });
-    return fileWatcher;
   }
-}; // struct TableService::Implementation
 
-static void notify(TableStatistics&& stats, const auto& observerCb) {
-  if (Seat::seatUnknown == stats.getMaxSeat()) {
-    LOG().info<"Got no stats from db.">();
-  } else {
-    LOG().info<"Got {} player stats objects.">(tableSeat::toInt(stats.getMaxSeat()));
-    LOG().info<"Calling observer with statistics...">();
-    observerCb(std::move(stats));
+  /**
+   * @returns the directory watcher to stop, if the last subscription was removed
+   */
+  [[nodiscard]] std::unique_ptr<DirWatcher>
+  unsubscribe(std::vector<std::shared_ptr<TableSubscription>>& removed,
+              const auto& shouldRemove) {
+    const std::scoped_lock lock {m_mutex};
+    std::erase_if(m_subscriptions, [&](const auto& titleToSubscription) {
+      if (!shouldRemove(titleToSubscription.first)) {
+        return false;
+      }
+
+      removed.push_back(titleToSubscription.second);
+      return true;
+    });
+
+    if (m_subscriptions.empty()) {
+      return std::move(m_pDirWatcher);
+    }
+
+    return nullptr;
   }
-}
+
+  void stop(const auto& shouldRemove) {
+    std::vector<std::shared_ptr<TableSubscription>> removed;
+    // the watcher waits for its running callback, which takes the lock: it is stopped unlocked
+    if (const auto pDirWatcher {unsubscribe(removed, shouldRemove)}; nullptr != pDirWatcher) {
+      pDirWatcher->stop();
+    }
+
+    std::ranges::for_each(removed, [](const auto& pSubscription) { pSubscription->stop(); });
+  }
+}; // struct TableService::Implementation
 
 TableService::TableService(Database& database)
   : m_pImpl {std::make_unique<Implementation>(database)} {}
@@ -212,9 +444,31 @@ std::string TableService::startProducingStats(std::string_view tableWindowTitle,
     const auto tableName =
         m_pImpl->m_pokerSiteHistory->getTableNameFromTableWindowTitle(tableWindowTitle);
     LOG().info<"Table name: '{}', history file: '{}'">(tableName, histoFile.string());
-    m_pImpl->m_fileWatcher =
-        Implementation::watchHistoFile(m_pImpl->m_reloadTask, m_pImpl->m_pokerSiteHistory,
-                                       m_pImpl->m_database, histoFile, tableName, observerCb);
+    // a table already monitored is monitored again with the new observer
+    stopProducingStats(tableWindowTitle);
+    auto pSubscription {std::make_shared<TableSubscription>(
+        TableSubscription::Params {.database = m_pImpl->m_database,
+                                   .statsStore = m_pImpl->m_statsStore,
+                                   .delayedExecutor = m_pImpl->m_delayedExecutor,
+                                   .statsStoreLoaded = m_pImpl->m_statsStoreLoaded,
+                                   .pokerSiteHistory = m_pImpl->m_pokerSiteHistory,
+                                   .file = histoFile,
+                                   .table = tableName,
+                                   .observerCb = observerCb,
+                                   .coalescingWindow = m_pImpl->m_coalescingWindow})};
+    {
+      const std::scoped_lock lock {m_pImpl->m_mutex};
+      m_pImpl->m_subscriptions.insert_or_assign(std::string(tableWindowTitle), pSubscription);
+
+      if (nullptr == m_pImpl->m_pDirWatcher) {
+        m_pImpl->m_pDirWatcher = DirWatcher::create(histoFile.parent_path());
+        m_pImpl->m_pDirWatcher->start(
+            [pImpl = m_pImpl.get()](const fs::path& file) { pImpl->dispatch(file); });
+      }
+    }
+    // the hands of a newly seen table are saved and its stats shown at once, without waiting for
+    // its next hand or for the history import
+    pSubscription->reload();
     return "";
   } else {
     LOG().warn<"Couldn't get history file for table '{}'">(tableWindowTitle);
@@ -223,13 +477,11 @@ std::string TableService::startProducingStats(std::string_view tableWindowTitle,
 }
 
 void TableService::stopProducingStats() {
-  if (nullptr != m_pImpl->m_fileWatcher) {
-    m_pImpl->m_fileWatcher->stop();
-  }
-  if (m_pImpl->m_reloadTask.valid()) {
-    stlab::await(std::move(m_pImpl->m_reloadTask));
-  }
-  m_pImpl->m_reloadTask.reset();
+  m_pImpl->stop([](const auto&) { return true; });
+}
+
+void TableService::stopProducingStats(std::string_view tableWindowTitle) {
+  m_pImpl->stop([tableWindowTitle](const auto& title) { return tableWindowTitle == title; });
 }
 
 void TableService::setPokerSiteHistory(std::shared_ptr<PokerSiteHistory> pokerSiteHistory) const {
@@ -239,3 +491,7 @@ void TableService::setPokerSiteHistory(std::shared_ptr<PokerSiteHistory> pokerSi
 void TableService::setHistoryDir(const fs::path& historyDir) const {
   m_pImpl->m_historyDir = historyDir;
 }
+
+void TableService::setCoalescingWindow(std::chrono::milliseconds coalescingWindow) const {
+  m_pImpl->m_coalescingWindow = coalescingWindow;
+}
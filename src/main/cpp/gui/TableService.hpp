@@ -1,5 +1,6 @@
 #pragma once
 
+#include <chrono>
 #include <filesystem>
 #include <functional>
 #include <memory>
@@ -24,6 +25,17 @@ private:
 public:
   using TableObserverCallback = std::function<void(TableStatistics&&)>;
 
+  /**
+   * The changes of a history file seen within this duration are coalesced into a single reload,
+   * as Winamax writes a hand in several chunks.
+   */
+  static constexpr std::chrono::milliseconds DEFAULT_COALESCING_WINDOW {50};
+
+  /**
+   * Counts the hands already saved in the background, then feeds the statistics with the hands of
+   * each site saved by the database, whatever the saving service. The hand store of a database
+   * which predates it is rebuilt first.
+   */
   explicit TableService(Database& database);
   TableService(const TableService&) = delete;
   TableService(TableService&&) = delete;
@@ -39,7 +51,10 @@ public:
   [[nodiscard]] static bool isPokerApp(std::string_view executableName);
 
   /**
-   * Starts producing statistics for the given table.
+   * Starts producing statistics for the given table. Several tables can be monitored at once: a
+   * single watcher of the history directory dispatches the file changes to the tables, and the
+   * reloads of a table run one after the other, in parallel with those of the other tables.
+   * The history file of the table is reloaded at once.
    * @param tableWindowTitle Name of table to monitor
    * @param observerCb Callback for statistics updates
    * @return Error message if failed, empty string if success
@@ -47,10 +62,16 @@ public:
   [[nodiscard]] virtual std::string startProducingStats(std::string_view tableWindowTitle,
                                                         const TableObserverCallback& observerCb);
   /**
-   * Stops producing statistics for the current table.
+   * Stops producing statistics for all the tables, waiting for their running reloads.
    */
   virtual void stopProducingStats();
 
+  /**
+   * Stops producing statistics for the given table, waiting for its running reload.
+   * @param tableWindowTitle Name of the monitored table
+   */
+  virtual void stopProducingStats(std::string_view tableWindowTitle);
+
   /**
    * Sets the poker site history instance to use.
    * @param pokerSiteHistory Shared pointer to poker site history
@@ -62,4 +83,12 @@ public:
    * @param historyDir Path to history directory
    */
   void setHistoryDir(const std::filesystem::path& historyDir) const;
+
+  /**
+   * Sets the coalescing window of the tables monitored afterwards. A reload waits for it before
+   * reading the history file, the changes seen meanwhile joining it, and at most one reload is
+   * pending while another one runs. 0 reloads as soon as the file changes.
+   * @param coalescingWindow DEFAULT_COALESCING_WINDOW by default
+   */
+  void setCoalescingWindow(std::chrono::milliseconds coalescingWindow) const;
 }; // class TableService
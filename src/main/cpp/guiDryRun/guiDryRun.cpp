@@ -102,6 +102,9 @@ public:
     m_continue = PeriodicTaskStatus::stopTask;
     m_task.stop();
   }
+
+  // a single fake table is monitored
+  void stopProducingStats(std::string_view /*table*/) override { stopProducingStats(); }
 }; // class NoOpTableService
 
 class [[nodiscard]] NoOpHistoryService final : public HistoryService {
@@ -0,0 +1,218 @@
+#include "history/ImportReport.hpp" // ImportReport, ImportedFile, ImportPhase, std::chrono
+#include "log/Logger.hpp"           // CURRENT_FILE_NAME, fmt::format_to
+#include <algorithm> // std::ranges::sort
+#include <array>
+#include <fstream> // std::ofstream
+#include <mutex>
+#include <numeric> // std::accumulate
+#include <optional>
+#include <ranges>
+#include <span>
+
+static Logger& LOG() {
+  static auto logger = Logger(CURRENT_FILE_NAME);
+  return logger;
+}
+
+namespace {
+  constexpr std::array PHASES {ImportPhase::read, ImportPhase::parse, ImportPhase::merge,
+                               ImportPhase::insert};
+
+  [[nodiscard]] constexpr std::size_t toIndex(ImportPhase phase) noexcept {
+    return static_cast<std::size_t>(phase);
+  }
+
+  [[nodiscard]] double toMillis(std::chrono::steady_clock::duration d) noexcept {
+    return std::chrono::duration<double, std::milli>(d).count();
+  }
+
+  [[nodiscard]] double toSeconds(std::chrono::steady_clock::duration d) noexcept {
+    return std::chrono::duration<double>(d).count();
+  }
+
+  [[nodiscard]] double toMegaBytes(std::size_t nbBytes) noexcept {
+    return static_cast<double>(nbBytes) / (1024.0 * 1024.0);
+  }
+
+  [[nodiscard]] double perSecond(double quantity, std::chrono::steady_clock::duration d) noexcept {
+    const auto seconds {toSeconds(d)};
+    return 0.0 < seconds ? quantity / seconds : 0.0;
+  }
+
+  [[nodiscard]] std::size_t getNbHands(std::span<const ImportedFile> files) {
+    return std::accumulate(files.begin(), files.end(), std::size_t {0},
+                           [](std::size_t n, const auto& f) { return n + f.m_nbHands; });
+  }
+
+  // the file names and the error messages may contain commas or double quotes
+  [[nodiscard]] std::string toCsvField(std::string_view s) {
+    std::string ret {"\""};
+
+    for (const auto c : s) {
+      if ('"' == c) {
+        ret.push_back('"');
+      }
+
+      ret.push_back(c);
+    }
+
+    ret.push_back('"');
+    return ret;
+  }
+} // anonymous namespace
+
+/*[[nodiscard]]*/ std::string_view toString(ImportPhase phase) noexcept {
+  switch (phase) {
+    case ImportPhase::read: return "read";
+    case ImportPhase::parse: return "parse";
+    case ImportPhase::merge: return "merge";
+    case ImportPhase::insert: return "insert";
+  }
+
+  return "unknown";
+}
+
+struct [[nodiscard]] ImportReport::Implementation final {
+  // Memory layout optimized: largest to smallest to minimize padding
+  std::vector<ImportedFile> m_files {};
+  std::array<std::chrono::steady_clock::duration, PHASES.size()> m_phaseTimes {};
+  std::mutex m_mutex {};
+  std::chrono::steady_clock::time_point m_start {std::chrono::steady_clock::now()};
+  std::optional<std::chrono::steady_clock::time_point> m_oEnd {};
+  std::size_t m_firstFileToInsert = 0;
+}; // struct ImportReport::Implementation
+
+ImportReport::ImportReport()
+  : m_pImpl {std::make_unique<Implementation>()} {}
+
+ImportReport::~ImportReport() = default;
+
+void ImportReport::addFile(ImportedFile file) {
+  const std::scoped_lock lock {m_pImpl->m_mutex};
+  m_pImpl->m_phaseTimes[toIndex(ImportPhase::read)] += file.m_readTime;
+  m_pImpl->m_phaseTimes[toIndex(ImportPhase::parse)] += file.m_parseTime;
+  m_pImpl->m_files.push_back(std::move(file));
+}
+
+void ImportReport::addTime(ImportPhase phase, std::chrono::steady_clock::duration duration) {
+  const std::scoped_lock lock {m_pImpl->m_mutex};
+  m_pImpl->m_phaseTimes.at(toIndex(phase)) += duration;
+}
+
+void ImportReport::addInsertTime(std::chrono::steady_clock::duration duration) {
+  const std::scoped_lock lock {m_pImpl->m_mutex};
+  m_pImpl->m_phaseTimes[toIndex(ImportPhase::insert)] += duration;
+  const auto files {std::span(m_pImpl->m_files).subspan(m_pImpl->m_firstFileToInsert)};
+  m_pImpl->m_firstFileToInsert = m_pImpl->m_files.size();
+  const auto nbHands {::getNbHands(files)};
+
+  // without hands, the files share the insertion time evenly
+  for (auto& file : files) {
+    const auto share {0 == nbHands ? 1.0 / static_cast<double>(files.size())
+                                   : static_cast<double>(file.m_nbHands) /
+                                         static_cast<double>(nbHands)};
+    file.m_insertTime += std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double, std::chrono::steady_clock::period>(
+            share * static_cast<double>(duration.count())));
+  }
+}
+
+void ImportReport::stop() {
+  const std::scoped_lock lock {m_pImpl->m_mutex};
+  m_pImpl->m_oEnd = std::chrono::steady_clock::now();
+}
+
+/*[[nodiscard]]*/ std::vector<ImportedFile> ImportReport::getFiles() const {
+  std::vector<ImportedFile> ret;
+  {
+    const std::scoped_lock lock {m_pImpl->m_mutex};
+    ret = m_pImpl->m_files;
+  }
+  std::ranges::sort(ret, std::greater {}, &ImportedFile::getTotalTime);
+  return ret;
+}
+
+/*[[nodiscard]]*/ std::chrono::steady_clock::duration
+ImportReport::getTime(ImportPhase phase) const {
+  const std::scoped_lock lock {m_pImpl->m_mutex};
+  return m_pImpl->m_phaseTimes.at(toIndex(phase));
+}
+
+/*[[nodiscard]]*/ std::chrono::steady_clock::duration ImportReport::getElapsedTime() const {
+  const std::scoped_lock lock {m_pImpl->m_mutex};
+  return m_pImpl->m_oEnd.value_or(std::chrono::steady_clock::now()) - m_pImpl->m_start;
+}
+
+/*[[nodiscard]]*/ std::size_t ImportReport::getNbBytes() const {
+  const std::scoped_lock lock {m_pImpl->m_mutex};
+  return std::accumulate(m_pImpl->m_files.begin(), m_pImpl->m_files.end(), std::size_t {0},
+                         [](std::size_t n, const auto& f) { return n + f.m_nbBytes; });
+}
+
+/*[[nodiscard]]*/ std::size_t ImportReport::getNbHands() const {
+  const std::scoped_lock lock {m_pImpl->m_mutex};
+  return ::getNbHands(m_pImpl->m_files);
+}
+
+/*[[nodiscard]]*/ std::string ImportReport::toString(std::size_t nbSlowestFiles) const {
+  const auto files {getFiles()};
+  const auto elapsed {getElapsedTime()};
+  const auto nbBytes {getNbBytes()};
+  const auto nbHands {getNbHands()};
+  const auto nbErrors {std::ranges::count_if(files, [](const auto& f) {
+    return !f.m_error.empty();
+  })};
+  std::string ret;
+  auto out {std::back_inserter(ret)};
+  fmt::format_to(out, "{} files ({} in error), {:.1f} MB, {} hands imported in {:.1f} s: ",
+                 files.size(), nbErrors, toMegaBytes(nbBytes), nbHands, toSeconds(elapsed));
+  fmt::format_to(out, "{:.2f} MB/s, {:.0f} hands/s\n", perSecond(toMegaBytes(nbBytes), elapsed),
+                 perSecond(static_cast<double>(nbHands), elapsed));
+
+  // read and parse are summed over the import threads, so they can exceed the elapsed time
+  std::array<std::chrono::steady_clock::duration, PHASES.size()> times {};
+  std::ranges::transform(PHASES, times.begin(), [this](ImportPhase p) { return getTime(p); });
+  const auto total {std::accumulate(times.begin(), times.end(),
+                                    std::chrono::steady_clock::duration())};
+  fmt::format_to(out, "{:<8} {:>12} {:>7}\n", "phase", "time (s)", "share");
+
+  for (const auto phase : PHASES) {
+    const auto time {times[toIndex(phase)]};
+    const auto share {0 < total.count() ? 100.0 * toSeconds(time) / toSeconds(total) : 0.0};
+    fmt::format_to(out, "{:<8} {:>12.3f} {:>6.1f}%\n", ::toString(phase), toSeconds(time), share);
+  }
+
+  fmt::format_to(out, "slowest files:\n");
+
+  for (const auto& file : files | std::views::take(nbSlowestFiles)) {
+    fmt::format_to(out, "{:>10.1f} ms {} ({} hands, {} bytes){}{}\n",
+                   toMillis(file.getTotalTime()), file.m_file.filename().string(), file.m_nbHands,
+                   file.m_nbBytes, file.m_error.empty() ? "" : ": ", file.m_error);
+  }
+
+  return ret;
+}
+
+/*[[nodiscard]]*/ bool ImportReport::writeCsv(const std::filesystem::path& csvFile) const {
+  const auto files {getFiles()};
+  std::ofstream os {csvFile, std::ios::trunc};
+  os << "file,bytes,hands,read_ms,parse_ms,insert_ms,total_ms,error\n";
+
+  for (const auto& file : files) {
+    os << fmt::format("{},{},{},{:.3f},{:.3f},{:.3f},{:.3f},{}\n",
+                      toCsvField(file.m_file.string()), file.m_nbBytes, file.m_nbHands,
+                      toMillis(file.m_readTime), toMillis(file.m_parseTime),
+                      toMillis(file.m_insertTime), toMillis(file.getTotalTime()),
+                      toCsvField(file.m_error));
+  }
+
+  os.flush();
+
+  if (!os) {
+    LOG().error<"Couldn't write the import report file {}">(csvFile.string());
+    return false;
+  }
+
+  LOG().info<"{} files written to the import report file {}">(files.size(), csvFile.string());
+  return true;
+}
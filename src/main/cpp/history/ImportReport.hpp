@@ -0,0 +1,104 @@
+#pragma once
+
+#include <chrono>     // std::chrono::steady_clock
+#include <filesystem> // std::filesystem::path
+#include <memory>     // std::unique_ptr
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * The phases of the import of a history directory.
+ */
+enum class /*[[nodiscard]]*/ ImportPhase : short {
+  read,  // reading the history files, done by the import threads
+  parse, // parsing the history files, done by the import threads
+  merge, // merging the parsed files into one Site (Site::merge)
+  insert // saving the games and players into the database
+};
+
+[[nodiscard]] std::string_view toString(ImportPhase phase) noexcept;
+
+/**
+ * What the import of one history file cost.
+ */
+struct [[nodiscard]] ImportedFile final {
+  // Memory layout optimized: largest to smallest to minimize padding
+  std::filesystem::path m_file {};
+  std::string m_error {}; // empty if the file was parsed without exception
+  std::chrono::steady_clock::duration m_readTime {};
+  std::chrono::steady_clock::duration m_parseTime {};
+  // the files are saved by batches, so this is the share of the batch insertion, in proportion of
+  // the number of hands of the file
+  std::chrono::steady_clock::duration m_insertTime {};
+  std::size_t m_nbBytes = 0;
+  std::size_t m_nbHands = 0;
+
+  [[nodiscard]] std::chrono::steady_clock::duration getTotalTime() const noexcept {
+    return m_readTime + m_parseTime + m_insertTime;
+  }
+}; // struct ImportedFile
+
+/**
+ * Collects the cost of each imported file and of each import phase, to find out which files and
+ * which phases make an import slow. Thread safe.
+ */
+class [[nodiscard]] ImportReport final {
+private:
+  struct Implementation;
+  std::unique_ptr<Implementation> m_pImpl;
+
+public:
+  /**
+   * Starts the wall clock of the import.
+   */
+  ImportReport();
+  ImportReport(const ImportReport&) = delete;
+  ImportReport(ImportReport&&) = delete;
+  ImportReport& operator=(const ImportReport&) = delete;
+  ImportReport& operator=(ImportReport&&) = delete;
+  ~ImportReport();
+
+  /**
+   * Adds a parsed file, its read and parse times are added to the read and parse phases.
+   */
+  void addFile(ImportedFile file);
+
+  /**
+   * Adds the given duration to the given phase.
+   */
+  void addTime(ImportPhase phase, std::chrono::steady_clock::duration duration);
+
+  /**
+   * Adds the time spent saving the files added since the previous call. It is shared among those
+   * files in proportion of their number of hands.
+   */
+  void addInsertTime(std::chrono::steady_clock::duration duration);
+
+  /**
+   * Stops the wall clock of the import.
+   */
+  void stop();
+
+  /**
+   * @returns the imported files, the slowest first
+   */
+  [[nodiscard]] std::vector<ImportedFile> getFiles() const;
+  [[nodiscard]] std::chrono::steady_clock::duration getTime(ImportPhase phase) const;
+  [[nodiscard]] std::chrono::steady_clock::duration getElapsedTime() const;
+  [[nodiscard]] std::size_t getNbBytes() const;
+  [[nodiscard]] std::size_t getNbHands() const;
+
+  /**
+   * @returns the throughput, the time split between the phases and the given number of slowest
+   * files
+   */
+  [[nodiscard]] std::string toString(std::size_t nbSlowestFiles = 10) const;
+
+  /**
+   * Writes one line per imported file, the slowest first, in the given CSV file.
+   * @returns false if the file could not be written
+   */
+  [[nodiscard]] bool writeCsv(const std::filesystem::path& csvFile) const;
+  bool writeCsv(auto) const = delete; // use only std::filesystem::path
+}; // class ImportReport
@@ -7,11 +7,14 @@
 #include "history/PmuHandBuilder.hpp"
 #include "history/PmuGameHistory.hpp" // std::filesystem::path
 #include "log/Logger.hpp"             // CURRENT_FILE_NAME
+#include "log/Metrics.hpp"            // Metrics
+#include "log/Tracer.hpp"             // TraceSpan
 #include "strings/StringUtils.hpp"    // phud::strings::*
 #include "threads/PlayerCache.hpp"
 
-static Logger& LOG() {
-  static auto logger = Logger(CURRENT_FILE_NAME);
+// hot path: the logging calls below PHUD_HOT_PATH_LOGGING_LEVEL are not compiled
+static MinLevelLogger<PHUD_HOT_PATH_LOGGING_LEVEL>& LOG() {
+  static auto logger = MinLevelLogger<PHUD_HOT_PATH_LOGGING_LEVEL>(CURRENT_FILE_NAME);
   return logger;
 }
 
@@ -100,6 +103,8 @@ template <typename GAME_TYPE>
 }
 
 std::unique_ptr<Site> PmuGameHistory::parseGameHistory(const fs::path& gameHistoryFile) {
+  const TraceSpan span {"parseGameHistory"};
+  Metrics::getNbFilesParsed().increment();
   LOG().debug<"Parsing the {} game history file {}.">(ProgramInfos::PMU_SITE_NAME,
                                                       gameHistoryFile.filename().string());
   return handleGame<CashGame>(gameHistoryFile);
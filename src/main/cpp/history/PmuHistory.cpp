@@ -20,16 +20,33 @@ std::unique_ptr<Site> PmuHistory::load(const fs::path& /*historyDir*/,
   return nullptr;
 }
 
+std::unique_ptr<Site> PmuHistory::load(const fs::path& /*historyDir*/,
+                                       std::function<void()> /*onProgress*/,
+                                       std::function<void(std::size_t)> /*onSetNbFiles*/,
+                                       ImportOrder /*importOrder*/,
+                                       std::function<void(Site&)> /*onBatchLoaded*/) {
+  return nullptr;
+}
+
 /* [[nodiscard]] static*/ std::unique_ptr<Site> PmuHistory::load(const fs::path& /*historyDir*/) {
   return nullptr;
 }
 
 void PmuHistory::stopLoading() {}
 
+void PmuHistory::setImportReport(std::shared_ptr<ImportReport> /*pReport*/) {}
+
+void PmuHistory::setFileFilter(std::function<bool(const fs::path&)> /*isFileToLoad*/) {}
+
 std::unique_ptr<Site> PmuHistory::reloadFile(const fs::path& /*winamaxHistoryFile*/) {
   return nullptr;
 }
 
+std::unique_ptr<Site> PmuHistory::parseAppendedHands(const fs::path& /*historyFile*/,
+                                                     std::string /*hands*/) {
+  return nullptr;
+}
+
 std::string_view
 PmuHistory::getTableNameFromTableWindowTitle(std::string_view /*tableWindowTitle*/) const {
   return "";
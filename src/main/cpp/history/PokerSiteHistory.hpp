@@ -4,10 +4,19 @@
 #include <functional> // std::function
 #include <memory>     // std::unique_ptr
 #include <optional>
+#include <string>
 
 // forward declarations
+class ImportReport;
 class Site;
 
+/**
+ * The order in which the history files are imported.
+ * mostRecentFirst makes the stats of the players met recently available before the whole
+ * history is imported.
+ */
+enum class /*[[nodiscard]]*/ ImportOrder : short { directory, mostRecentFirst };
+
 /**
  * @brief The hand history of all the games played on one poker site.
  */
@@ -33,12 +42,50 @@ public:
        std::function<void(std::size_t)> onSetNbFiles) = 0;
   std::unique_ptr<Site> load(auto, std::function<void()>,
                              std::function<void(std::size_t)>) = delete;
+  /**
+   * Loads the history files in the given order. If onBatchLoaded is set, it is given the games
+   * and players of each batch of parsed files as soon as the batch is done, so that they can be
+   * persisted while the remaining files are parsed. Those games and players are then not part of
+   * the returned Site.
+   * @returns a Site containing the games that were not given to onBatchLoaded.
+   */
+  [[nodiscard]] virtual std::unique_ptr<Site>
+  load(const std::filesystem::path& historyDir, std::function<void()> onProgress,
+       std::function<void(std::size_t)> onSetNbFiles, ImportOrder importOrder,
+       std::function<void(Site&)> onBatchLoaded) = 0;
+  std::unique_ptr<Site> load(auto, std::function<void()>, std::function<void(std::size_t)>,
+                             ImportOrder, std::function<void(Site&)>) = delete;
   [[nodiscard]] static std::unique_ptr<Site> load(const std::filesystem::path& historyDir);
   std::unique_ptr<Site> load(auto historyDir) = delete;
   virtual void stopLoading() = 0;
+  /**
+   * Records the cost of each file and of each phase of the next loads in the given report. The
+   * insertion phase is only recorded for the batches given to onBatchLoaded.
+   * @param pReport the report, or nullptr to stop recording
+   */
+  virtual void setImportReport(std::shared_ptr<ImportReport> pReport) = 0;
+
+  /**
+   * Restricts the next loads to the history files accepted by the given filter, e.g. to import
+   * only the files changed since a previous import.
+   * @param isFileToLoad the filter, or nullptr to load all the files
+   */
+  virtual void
+  setFileFilter(std::function<bool(const std::filesystem::path&)> isFileToLoad) = 0;
   [[nodiscard]] virtual std::unique_ptr<Site>
   reloadFile(const std::filesystem::path& winamaxHistoryFile) = 0;
   std::unique_ptr<Site> reloadFile(auto) = delete;
+
+  /**
+   * Parses the hands appended to a history file, without reading the file again.
+   * @param historyFile the file the hands were appended to, which tells their game
+   * @param hands the complete hands appended to the file
+   * @returns a Site containing their games and players, nullptr if the site can't parse a part
+   * of a file or if the hands can't be parsed.
+   */
+  [[nodiscard]] virtual std::unique_ptr<Site>
+  parseAppendedHands(const std::filesystem::path& historyFile, std::string hands) = 0;
+  std::unique_ptr<Site> parseAppendedHands(auto, std::string) = delete;
   /**
    * Validates if the given directory contains valid poker history.
    * @param historyDir Directory path to validate
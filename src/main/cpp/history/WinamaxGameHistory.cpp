@@ -7,12 +7,15 @@
 #include "history/WinamaxHandBuilder.hpp"
 #include "history/WinamaxGameHistory.hpp" // std::filesystem::path
 #include "log/Logger.hpp"                 // CURRENT_FILE_NAME
+#include "log/Metrics.hpp"                // Metrics
+#include "log/Tracer.hpp"                 // TraceSpan
 #include "strings/StringUtils.hpp"        // phud::strings
 #include "threads/PlayerCache.hpp"
 #include <optional>
 
-static Logger& LOG() {
-  static auto logger = Logger(CURRENT_FILE_NAME);
+// hot path: the logging calls below PHUD_HOT_PATH_LOGGING_LEVEL are not compiled
+static MinLevelLogger<PHUD_HOT_PATH_LOGGING_LEVEL>& LOG() {
+  static auto logger = MinLevelLogger<PHUD_HOT_PATH_LOGGING_LEVEL>(CURRENT_FILE_NAME);
   return logger;
 }
 
@@ -132,16 +135,13 @@ static void fillFromFileName(const FileStem& values, GameData& gameData) {
 }
 
 template <typename GAME_TYPE>
-[[nodiscard]] static std::unique_ptr<GAME_TYPE> createGame(const fs::path& gameHistoryFile,
-                                                           PlayerCache& cache) {
-  LOG().debug<"Creating the game history from {}.">(gameHistoryFile.filename().string());
-  const auto fileStem = ps::sanitize(gameHistoryFile.stem().string());
+[[nodiscard]] static std::unique_ptr<GAME_TYPE> createGame(TextFile& tfl, PlayerCache& cache) {
+  LOG().debug<"Creating the game history from {}.">(tfl.getFileName());
+  const auto fileStem = ps::sanitize(tfl.getFileStem());
   std::unique_ptr<GAME_TYPE> ret;
 
   if (const auto oGameDataFromFileName = parseFileStem(fileStem);
       oGameDataFromFileName.has_value()) {
-    TextFile tfl {gameHistoryFile};
-
     while (tfl.next()) {
       if (nullptr == ret) {
         LOG().debug<"1st hand : get additional game data from the hand.">();
@@ -164,52 +164,81 @@ template <typename GAME_TYPE>
 }
 
 template <typename GAME_TYPE>
-[[nodiscard]] static std::unique_ptr<Site> handleGame(const fs::path& gameHistoryFile,
-                                                      PlayerCache& cache) {
-  LOG().debug<"Handling the game history from {}.">(gameHistoryFile.filename().string());
+[[nodiscard]] static std::unique_ptr<Site> handleGame(TextFile& tfl, PlayerCache& cache) {
+  LOG().debug<"Handling the game history from {}.">(tfl.getFileName());
   auto pSite = std::make_unique<Site>(ProgramInfos::WINAMAX_SITE_NAME);
 
-  if (auto g {createGame<GAME_TYPE>(gameHistoryFile, cache)}; nullptr != g) {
-    LOG().debug<"Game created for file {}.">(gameHistoryFile.filename().string());
+  if (auto g {createGame<GAME_TYPE>(tfl, cache)}; nullptr != g) {
+    LOG().debug<"Game created for file {}.">(tfl.getFileName());
     pSite->addGame(std::move(g));
   } else {
-    LOG().info<"Game *not* created for file {}.">(gameHistoryFile.filename().string());
+    LOG().info<"Game *not* created for file {}.">(tfl.getFileName());
   }
 
   // Players are kept in the shared cache and extracted later
   return pSite;
 }
 
-// reminder: WinamaxGameHistory is a namespace
-
-// Version with shared cache for better performance
-std::unique_ptr<Site> WinamaxGameHistory::parseGameHistory(const fs::path& gameHistoryFile,
-                                                           PlayerCache& cache) {
-  LOG().debug<"Parsing the {} game history file {}.">(ProgramInfos::WINAMAX_SITE_NAME,
-                                                      gameHistoryFile.filename().string());
-  const auto fileStem = gameHistoryFile.stem().string();
-
+[[nodiscard]] static bool isParsableFileStem(std::string_view fileStem) {
   if (12 > fileStem.size()) {
     LOG().error<"Couldn't parse the file name '{}', too short!!!">(fileStem);
-    return std::make_unique<Site>(ProgramInfos::WINAMAX_SITE_NAME);
+    return false;
   }
 
   // history files with an '!' in their title are duplicated with another name, so ignore it
   if (ps::contains(fileStem, '!')) {
-    LOG().info<"Ignoring the file '{}' as it start with '!' and thus is duplicated.">(
-        gameHistoryFile.filename().string());
-    return std::make_unique<Site>(ProgramInfos::WINAMAX_SITE_NAME);
+    LOG().info<"Ignoring the file '{}' as it start with '!' and thus is duplicated.">(fileStem);
+    return false;
   }
 
   if (std::string::npos == fileStem.find("_real_", 9) and
       std::string::npos == fileStem.find("_play_", 9)) {
     LOG().error<"Couldn't parse the file name '{}', unable to guess real or play money!!!">(
         fileStem);
+    return false;
+  }
+
+  return true;
+}
+
+[[nodiscard]] static std::unique_ptr<Site> handleGame(TextFile& tfl, PlayerCache& cache) {
+  return ps::contains(tfl.getFileStem(), '(') ? handleGame<Tournament>(tfl, cache)
+                                              : handleGame<CashGame>(tfl, cache);
+}
+
+// reminder: WinamaxGameHistory is a namespace
+
+// Version with shared cache for better performance
+std::unique_ptr<Site> WinamaxGameHistory::parseGameHistory(const fs::path& gameHistoryFile,
+                                                           PlayerCache& cache) {
+  const TraceSpan span {"parseGameHistory"};
+  LOG().debug<"Parsing the {} game history file {}.">(ProgramInfos::WINAMAX_SITE_NAME,
+                                                      gameHistoryFile.filename().string());
+
+  if (!isParsableFileStem(gameHistoryFile.stem().string())) {
+    return std::make_unique<Site>(ProgramInfos::WINAMAX_SITE_NAME);
+  }
+
+  TextFile tfl {gameHistoryFile};
+  Metrics::getNbFilesParsed().increment();
+  return handleGame(tfl, cache);
+}
+
+std::unique_ptr<Site> WinamaxGameHistory::parseGameHistory(const fs::path& gameHistoryFile,
+                                                           std::string content,
+                                                           PlayerCache& cache) {
+  const TraceSpan span {"parseGameHistory"};
+  LOG().debug<"Parsing the {} game history {} from memory.">(ProgramInfos::WINAMAX_SITE_NAME,
+                                                             gameHistoryFile.filename().string());
+
+  if (!isParsableFileStem(gameHistoryFile.stem().string())) {
     return std::make_unique<Site>(ProgramInfos::WINAMAX_SITE_NAME);
   }
 
-  return ps::contains(fileStem, '(') ? handleGame<Tournament>(gameHistoryFile, cache)
-                                     : handleGame<CashGame>(gameHistoryFile, cache);
+  // the bytes were counted when read
+  TextFile tfl {gameHistoryFile, std::move(content)};
+  Metrics::getNbFilesParsed().increment();
+  return handleGame(tfl, cache);
 }
 
 // Legacy version without cache (creates its own local cache)
@@ -2,6 +2,7 @@
 
 #include <filesystem>
 #include <memory> // std::unique_ptr
+#include <string>
 
 // forward declarations
 class Site;
@@ -11,6 +12,10 @@ namespace WinamaxGameHistory {
   // Version with shared cache (for better performance when parsing multiple files)
   [[nodiscard]] std::unique_ptr<Site> parseGameHistory(const std::filesystem::path& gameHistoryFile,
                                                        PlayerCache& cache);
+  // Version parsing a content already in memory, gameHistoryFile being the name it would have on
+  // the disk, as the game is guessed from the file name
+  [[nodiscard]] std::unique_ptr<Site> parseGameHistory(const std::filesystem::path& gameHistoryFile,
+                                                       std::string content, PlayerCache& cache);
   // Legacy version (creates its own cache)
   [[nodiscard]] std::unique_ptr<Site>
   parseGameHistory(const std::filesystem::path& gameHistoryFile);
@@ -9,13 +9,16 @@
 #include "history/PokerSiteHandBuilder.hpp" // split, parseSeats
 #include "history/WinamaxHandBuilder.hpp"   // Pair
 #include "log/Logger.hpp"                   // CURRENT_FILE_NAME
+#include "log/Metrics.hpp"                  // Metrics
+#include "log/Tracer.hpp"                   // TraceSpan
 #include "strings/StringUtils.hpp"          // phud::strings
 #include "threads/PlayerCache.hpp"
 #include <optional>
 #include <ranges>
 
-static Logger& LOG() {
-  static auto logger = Logger(CURRENT_FILE_NAME);
+// hot path: the logging calls below PHUD_HOT_PATH_LOGGING_LEVEL are not compiled
+static MinLevelLogger<PHUD_HOT_PATH_LOGGING_LEVEL>& LOG() {
+  static auto logger = MinLevelLogger<PHUD_HOT_PATH_LOGGING_LEVEL>(CURRENT_FILE_NAME);
   return logger;
 }
 
@@ -347,6 +350,7 @@ parseActionsAndWinners(TextFile& tf, std::string_view handId) {
 template <GameType gameType>
 [[nodiscard]] static std::unique_ptr<Hand> getHand(TextFile& tf, PlayerCache& cache, int level,
                                                    const Time& date, std::string_view handId) {
+  const TraceSpan span {"buildHand"};
   LOG().debug<"Building hand and maxSeats from history file {}.">(tf.getFileStem());
   const auto& [nbMaxSeats, tableName,
                buttonSeat] {getNbMaxSeatsTableNameButtonSeatFromTableLine(tf)};
@@ -375,6 +379,7 @@ template <GameType gameType>
                        .boardCards = boardCards,
                        .actions = std::move(actions),
                        .winners = winners};
+  Metrics::getNbHandsParsed().increment();
   return std::make_unique<Hand>(params);
 }
 
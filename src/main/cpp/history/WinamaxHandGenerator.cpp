@@ -0,0 +1,133 @@
+#include "history/WinamaxHandGenerator.hpp" // WinamaxHandGenerator, std::string, std::span
+#include "language/Validator.hpp"           // validation::
+#include "log/Logger.hpp"                   // fmt::format
+#include "strings/StringUtils.hpp"          // phud::strings::trim
+#include <algorithm>                        // std::ranges::sort
+#include <utility>                          // std::pair
+
+namespace ps = phud::strings;
+
+namespace {
+  constexpr std::string_view HAND_START {"Winamax Poker - "};
+  constexpr std::string_view HAND_ID {" - HandId: #"};
+  constexpr std::string_view TABLE_LINE_START {"\nTable: '"};
+  // Winamax writes two empty lines after each hand
+  constexpr std::string_view HAND_SEPARATOR {"\n\n\n"};
+
+  // 'Seat 1: Amntfs (5€)' -> 'Amntfs', the summary seat lines are ignored
+  [[nodiscard]] std::vector<std::string> getPlayerNames(std::string_view hand) {
+    constexpr std::string_view SEAT_LINE_START {"\nSeat "};
+    const auto seats {hand.substr(0, hand.find("\n***"))};
+    std::vector<std::string> ret;
+
+    for (auto pos {seats.find(SEAT_LINE_START)}; std::string_view::npos != pos;
+         pos = seats.find(SEAT_LINE_START, pos + 1)) {
+      const auto start {seats.find(": ", pos) + 2};
+
+      if (const auto end {seats.find(" (", start)}; std::string_view::npos != end) {
+        ret.emplace_back(seats.substr(start, end - start));
+      }
+    }
+
+    // the longest first, in case a name contains another one
+    std::ranges::sort(ret, std::greater {}, &std::string::size);
+    return ret;
+  }
+
+  // replaces the whole words only
+  void replacePlayerName(std::string& hand, std::string_view name, std::string_view newName) {
+    for (auto pos {hand.find(name)}; std::string::npos != pos; pos = hand.find(name, pos)) {
+      const auto before {0 == pos ? '\n' : hand[pos - 1]};
+      const auto after {pos + name.size() < hand.size() ? hand[pos + name.size()] : '\n'};
+
+      if ((' ' == before or '\n' == before) and (' ' == after or '\n' == after)) {
+        hand.replace(pos, name.size(), newName);
+        pos += newName.size();
+      } else {
+        pos += name.size();
+      }
+    }
+  }
+
+  // the cash game table name is quoted in the 1st line and in the table line
+  void replaceFirst(std::string& hand, std::string_view s, std::string_view newS) {
+    if (const auto pos {hand.find(s)}; std::string::npos != pos) {
+      hand.replace(pos, s.size(), newS);
+    }
+  }
+
+  [[nodiscard]] std::string renameTable(std::string_view hand, std::string_view tableName) {
+    std::string ret {hand};
+
+    if (const auto table {WinamaxHandGenerator::getTableName(hand)}; !tableName.empty()) {
+      replaceFirst(ret, fmt::format("\"{}\"", table), fmt::format("\"{}\"", tableName));
+      replaceFirst(ret, fmt::format("'{}'", table), fmt::format("'{}'", tableName));
+    }
+
+    return ret;
+  }
+} // anonymous namespace
+
+struct [[nodiscard]] WinamaxHandGenerator::Implementation final {
+  // Memory layout optimized: largest to smallest to minimize padding
+  std::vector<std::pair<std::string, std::vector<std::string>>> m_handToPlayerNames {};
+  std::string m_handIdPrefix;
+  std::size_t m_nbPlayerGroups;
+  std::size_t m_nbGeneratedHands = 0;
+
+  explicit Implementation(const Params& p)
+    : m_handIdPrefix {p.handIdPrefix},
+      m_nbPlayerGroups {std::max<std::size_t>(1, p.nbPlayerGroups)} {
+    validation::requireNonEmpty(p.hands, "hands");
+    std::ranges::transform(p.hands, std::back_inserter(m_handToPlayerNames), [&p](const auto& h) {
+      auto hand {renameTable(ps::trim(h), p.tableName)};
+      hand.append(HAND_SEPARATOR);
+      return std::make_pair(std::move(hand), getPlayerNames(h));
+    });
+  }
+}; // struct WinamaxHandGenerator::Implementation
+
+WinamaxHandGenerator::WinamaxHandGenerator(const Params& p)
+  : m_pImpl {std::make_unique<Implementation>(p)} {}
+
+WinamaxHandGenerator::~WinamaxHandGenerator() = default;
+
+/*[[nodiscard]]*/ std::string WinamaxHandGenerator::next() {
+  const auto nbTemplates {m_pImpl->m_handToPlayerNames.size()};
+  const auto nbGeneratedHands {m_pImpl->m_nbGeneratedHands++};
+  const auto& [hand, playerNames] {m_pImpl->m_handToPlayerNames[nbGeneratedHands % nbTemplates]};
+  const auto group {nbGeneratedHands / nbTemplates % m_pImpl->m_nbPlayerGroups};
+  auto ret {hand};
+  const auto idEnd {ret.find(" - ", ret.find(HAND_ID) + HAND_ID.size())};
+  ret.insert(idEnd, fmt::format("-{}{}", m_pImpl->m_handIdPrefix, nbGeneratedHands));
+  std::ranges::for_each(playerNames, [&](const auto& name) {
+    replacePlayerName(ret, name, fmt::format("{}_{}", name, group));
+  });
+  return ret;
+}
+
+/*[[nodiscard]]*/ std::vector<std::string>
+WinamaxHandGenerator::splitHands(std::string_view history) {
+  std::vector<std::string> ret;
+  auto start {history.find(HAND_START)};
+
+  while (std::string_view::npos != start) {
+    const auto end {history.find(HAND_START, start + HAND_START.size())};
+    ret.emplace_back(history.substr(start, end - start));
+    start = end;
+  }
+
+  return ret;
+}
+
+// 'Table: 'Colorado 1' 5-max (real money) Seat #1 is the button' -> 'Colorado 1'
+/*[[nodiscard]]*/ std::string WinamaxHandGenerator::getTableName(std::string_view hand) {
+  const auto pos {hand.find(TABLE_LINE_START)};
+
+  if (std::string_view::npos == pos) {
+    return "";
+  }
+
+  const auto start {pos + TABLE_LINE_START.size()};
+  return std::string(hand.substr(start, hand.find("' ", start) - start));
+}
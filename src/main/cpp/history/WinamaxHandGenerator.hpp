@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef> // std::size_t
+#include <memory>  // std::unique_ptr
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * Generates as many cash game hands as needed from a few Winamax hands, to fill a database or to
+ * replay a session. The copies get unique hand ids, and their players are renamed so that they
+ * form a given number of distinct groups, as would the players of many sessions.
+ */
+class [[nodiscard]] WinamaxHandGenerator final {
+private:
+  struct Implementation;
+  std::unique_ptr<Implementation> m_pImpl;
+
+public:
+  struct [[nodiscard]] Params final {
+    std::span<const std::string> hands;
+    // the copies are played at this table, if not empty
+    std::string_view tableName;
+    // appended to the hand ids, to generate distinct hands from the same templates
+    std::string_view handIdPrefix;
+    std::size_t nbPlayerGroups;
+  }; // struct Params
+
+  /**
+   * @throws PhudException if there is no hand
+   */
+  explicit WinamaxHandGenerator(const Params& p);
+  WinamaxHandGenerator(const WinamaxHandGenerator&) = delete;
+  WinamaxHandGenerator(WinamaxHandGenerator&&) = delete;
+  WinamaxHandGenerator& operator=(const WinamaxHandGenerator&) = delete;
+  WinamaxHandGenerator& operator=(WinamaxHandGenerator&&) = delete;
+  ~WinamaxHandGenerator();
+
+  /**
+   * @returns the next hand, followed by the empty lines Winamax writes between two hands
+   */
+  [[nodiscard]] std::string next();
+
+  /**
+   * @returns the hands of the given history, each one starting with 'Winamax Poker - '
+   */
+  [[nodiscard]] static std::vector<std::string> splitHands(std::string_view history);
+
+  /**
+   * @returns the table name of the given hand, e.g. 'Colorado 1', or an empty string
+   */
+  [[nodiscard]] static std::string getTableName(std::string_view hand);
+}; // class WinamaxHandGenerator
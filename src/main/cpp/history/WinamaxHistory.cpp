@@ -1,10 +1,13 @@
 #include "constants/ProgramInfos.hpp"
 #include "entities/Site.hpp"              // Site
 #include "filesystem/FileUtils.hpp"       // phud::filesystem::*
+#include "history/ImportReport.hpp"       // ImportReport, ImportedFile, ImportPhase
 #include "history/WinamaxGameHistory.hpp" // parseGameHistory
 #include "history/WinamaxHistory.hpp" // WinamaxHistory, std::filesystem::path, fs::*, Global::*, std::string, phud::strings
 #include "language/Either.hpp"
 #include "log/Logger.hpp"                // CURRENT_FILE_NAME
+#include "log/MemoryAccounting.hpp"      // MemoryAccounting
+#include "log/Metrics.hpp"               // Metrics
 #include "strings/StringUtils.hpp"       // concatLiteral
 #include "threads/PlayerCache.hpp"       // PlayerCache
 #include "threads/ThreadPool.hpp"        // Future
@@ -57,8 +60,13 @@ namespace {
 
   // using auto&& enhances performances by inlining std::function's logic
   [[nodiscard]] std::vector<fs::path> getFilesAndNotify(const fs::path& historyDir,
+                                                        const auto& isFileToLoad,
                                                         auto&& onSetNbFiles) {
-    const auto files = getFiles(historyDir);
+    auto files = getFiles(historyDir);
+
+    if (isFileToLoad) {
+      std::erase_if(files, [&isFileToLoad](const auto& file) { return !isFileToLoad(file); });
+    }
 
     if (onSetNbFiles) {
       const auto fileSize = files.size();
@@ -72,14 +80,98 @@ namespace {
     return files;
   }
 
+  void accountMemory(const Site& site) {
+    const auto usage {site.getMemoryUsage()};
+    MemoryAccounting::set(MemorySubsystem::sitePlayers, usage.m_players);
+    MemoryAccounting::set(MemorySubsystem::siteCashGames, usage.m_cashGames);
+    MemoryAccounting::set(MemorySubsystem::siteTournaments, usage.m_tournaments);
+    MemoryAccounting::set(MemorySubsystem::hands, usage.m_hands);
+    MemoryAccounting::set(MemorySubsystem::actions, usage.m_actions);
+  }
+
+  [[nodiscard]] std::unique_ptr<Site> awaitPendingSite(Future<Site*>&& task) {
+    return std::unique_ptr<Site>(stlab::await(std::move(task)));
+  }
+
   // disable other types than const std::filesystem::path&
-  std::vector<fs::path> getFilesAndNotify(auto, auto) = delete;
+  std::vector<fs::path> getFilesAndNotify(auto, const auto&, auto) = delete;
+
+  void merge(Site& into, Site& site, ImportReport* pReport) {
+    const auto start {std::chrono::steady_clock::now()};
+    into.merge(site);
+
+    if (nullptr != pReport) {
+      pReport->addTime(ImportPhase::merge, std::chrono::steady_clock::now() - start);
+    }
+  }
+
+  void addFailedFile(ImportReport& report, ImportedFile&& file, std::string_view error,
+                     std::chrono::steady_clock::time_point parseStart) {
+    file.m_error = error;
+    file.m_parseTime = std::chrono::steady_clock::now() - parseStart;
+    report.addFile(std::move(file));
+  }
+
+  // reads the file before parsing it, to tell the read time from the parse time
+  [[nodiscard]] std::unique_ptr<Site> parseAndReport(const fs::path& file, PlayerCache& cache,
+                                                     ImportReport& report) {
+    ImportedFile imported {.m_file = file};
+    const auto start {std::chrono::steady_clock::now()};
+    auto readEnd {start};
+
+    try {
+      auto content {pf::readToString(file)};
+      readEnd = std::chrono::steady_clock::now();
+      imported.m_readTime = readEnd - start;
+      imported.m_nbBytes = content.size();
+      auto ret {WinamaxGameHistory::parseGameHistory(file, std::move(content), cache)};
+      imported.m_parseTime = std::chrono::steady_clock::now() - readEnd;
+      imported.m_nbHands = ret ? ret->getNbHands() : 0;
+      report.addFile(std::move(imported));
+      return ret;
+    } catch (const std::exception& e) {
+      addFailedFile(report, std::move(imported), e.what(), readEnd);
+      throw;
+    } catch (const char* str) {
+      addFailedFile(report, std::move(imported), str, readEnd);
+      throw;
+    }
+  }
+
+  // Merge the games of a completed batch and hand them over with the players met so far
+  void handOverBatch(std::vector<Future<Site*>>& batchTasks, const std::atomic_bool& stop,
+                     PlayerCache& sharedCache, const auto& onBatchLoaded, ImportReport* pReport) {
+    Site batchSite {ProgramInfos::WINAMAX_SITE_NAME};
+    std::ranges::for_each(batchTasks, [&batchSite, &stop, pReport](auto& task) {
+      if (task.valid()) {
+        if (const auto site = awaitPendingSite(std::move(task)); !stop and site) {
+          merge(batchSite, *site, pReport);
+        }
+      }
+    });
+    batchTasks.clear();
+    MemoryAccounting::set(MemorySubsystem::playerCache, sharedCache.getMemoryUsage());
+    auto players = sharedCache.extractPlayers();
+    std::ranges::for_each(players, [&](auto& p) { batchSite.addPlayer(std::move(p)); });
+    accountMemory(batchSite);
+
+    if (!stop) {
+      const auto start {std::chrono::steady_clock::now()};
+      onBatchLoaded(batchSite);
+
+      if (nullptr != pReport) {
+        pReport->addInsertTime(std::chrono::steady_clock::now() - start);
+      }
+    }
+  }
 
   // Parse files in batches to limit concurrency and reduce memory pressure
   // Uses a shared PlayerCache to avoid creating duplicate Player objects
   std::vector<Future<Site*>> parseFilesAsyncBatched(std::span<const fs::path> files,
                                                     std::atomic_bool& stop, const auto& onProgress,
-                                                    PlayerCache& sharedCache) {
+                                                    PlayerCache& sharedCache,
+                                                    const auto& onBatchLoaded,
+                                                    ImportReport* pReport) {
     // Batch size = 2x number of hardware threads to keep all cores busy
     // while limiting memory usage from having too many files loaded at once
     const std::size_t batchSize = std::max(2u, std::thread::hardware_concurrency() * 2);
@@ -102,16 +194,24 @@ namespace {
         if (stop) {
           break;
         }
-        batchTasks.push_back(ThreadPool::submit([file, onProgress, aStop = std::ref(stop),
-                                                 &sharedCache]() {
+        Metrics::getNbQueuedFiles().add(1);
+        batchTasks.push_back(ThreadPool::submit(ThreadPool::TaskCategory::importParse,
+                                                 [file, onProgress, aStop = std::ref(stop),
+                                                  &sharedCache, pReport]() {
+          Metrics::getNbQueuedFiles().add(-1);
           Site* pSite = nullptr;
 
           try {
             // Use shared cache to avoid creating duplicate players
-            pSite = WinamaxGameHistory::parseGameHistory(file, sharedCache).release();
+            pSite = (nullptr == pReport
+                         ? WinamaxGameHistory::parseGameHistory(file, sharedCache)
+                         : parseAndReport(file, sharedCache, *pReport))
+                        .release();
           } catch (const std::exception& e) {
+            Metrics::getNbParseErrors().increment();
             LOG().error<"Exception loading the file {}: {}">(file.filename().string(), e.what());
           } catch (const char* str) {
+            Metrics::getNbParseErrors().increment();
             LOG().error<"Exception loading the file {}: {}">(file.filename().string(), str);
           }
 
@@ -124,14 +224,25 @@ namespace {
       } // for
 
       // Wait for current batch to complete before starting next batch
-      std::ranges::for_each(batchTasks, [](auto& task) {
+      // the sites kept in the futures until the end of the loading are accounted as pending
+      MemoryUsage pendingUsage;
+      std::ranges::for_each(batchTasks, [&pendingUsage, &onBatchLoaded](auto& task) {
         if (task.valid()) {
-          stlab::await(stlab::copy(task)); // Wait for task to complete
+          // Wait for task to complete
+          if (const auto* pSite {stlab::await(stlab::copy(task))};
+              !onBatchLoaded and nullptr != pSite) {
+            pendingUsage += pSite->getMemoryUsage().getTotal();
+          }
         }
       });
 
-      // Move completed tasks to result vector
-      std::ranges::move(batchTasks, std::back_inserter(allTasks));
+      if (onBatchLoaded) {
+        handOverBatch(batchTasks, stop, sharedCache, onBatchLoaded, pReport);
+      } else {
+        MemoryAccounting::add(MemorySubsystem::pendingSites, pendingUsage);
+        // Move completed tasks to result vector
+        std::ranges::move(batchTasks, std::back_inserter(allTasks));
+      }
     }
 
     return allTasks;
@@ -140,6 +251,8 @@ namespace {
 
 struct [[nodiscard]] WinamaxHistory::Implementation final {
   std::vector<Future<Site*>> m_tasks = {};
+  std::shared_ptr<ImportReport> m_pReport = {};
+  std::function<bool(const fs::path&)> m_isFileToLoad = {};
   std::atomic_bool m_stop = true;
 }; // struct WinamaxHistory::Implementation
 
@@ -175,11 +288,24 @@ bool WinamaxHistory::isValidHistory(const fs::path& dir) {
 
 std::unique_ptr<Site> WinamaxHistory::load(const fs::path& dir, std::function<void()> onProgress,
                                            std::function<void(std::size_t)> onSetNbFiles) {
+  return load(dir, std::move(onProgress), std::move(onSetNbFiles), ImportOrder::directory,
+              nullptr);
+}
+
+std::unique_ptr<Site> WinamaxHistory::load(const fs::path& dir, std::function<void()> onProgress,
+                                           std::function<void(std::size_t)> onSetNbFiles,
+                                           ImportOrder importOrder,
+                                           std::function<void(Site&)> onBatchLoaded) {
   m_pImpl->m_stop = false;
 
   try {
     LOG().debug<"Loading the history dir '{}'.">(dir.string());
-    const auto files = getFilesAndNotify(dir, onSetNbFiles);
+    auto files = getFilesAndNotify(dir, m_pImpl->m_isFileToLoad, onSetNbFiles);
+
+    if (ImportOrder::mostRecentFirst == importOrder) {
+      files = pf::sortByMostRecentFirst(std::move(files));
+    }
+
     auto ret = std::make_unique<Site>(ProgramInfos::WINAMAX_SITE_NAME);
 
     if (files.empty()) {
@@ -193,23 +319,27 @@ std::unique_ptr<Site> WinamaxHistory::load(const fs::path& dir, std::function<vo
     PlayerCache sharedCache {ProgramInfos::WINAMAX_SITE_NAME};
 
     // Use batched parsing to limit concurrency and memory usage
-    m_pImpl->m_tasks = parseFilesAsyncBatched(files, m_pImpl->m_stop, onProgress, sharedCache);
+    m_pImpl->m_tasks = parseFilesAsyncBatched(files, m_pImpl->m_stop, onProgress, sharedCache,
+                                              onBatchLoaded, m_pImpl->m_pReport.get());
     LOG().info<"Merging results from {} tasks.">(m_pImpl->m_tasks.size());
 
     // Merge all game data from parsed files
     std::ranges::for_each(m_pImpl->m_tasks, [&ret, this](auto& task) {
       if (task.valid()) {
-        if (const auto site = std::unique_ptr<Site>(stlab::await(std::move(task)));
-            !m_pImpl->m_stop and site) {
-          ret->merge(*site);
+        if (const auto site = awaitPendingSite(std::move(task)); !m_pImpl->m_stop and site) {
+          merge(*ret, *site, m_pImpl->m_pReport.get());
         }
       }
     });
     m_pImpl->m_tasks.clear();
+    MemoryAccounting::set(MemorySubsystem::pendingSites, {});
     // Extract all players from shared cache and add to result
+    MemoryAccounting::set(MemorySubsystem::playerCache, sharedCache.getMemoryUsage());
     auto players = sharedCache.extractPlayers();
     LOG().info<"Adding {} player{} from shared cache.">(players.size(), ps::plural(players.size()));
     std::ranges::for_each(players, [&](auto& p) { ret->addPlayer(std::move(p)); });
+    accountMemory(*ret);
+    LOG().info<"Memory usage after the loading:\n{}">(MemoryAccounting::toString());
     LOG().info<"Loading done.">();
     return ret;
   } catch (const std::exception& e) {
@@ -224,6 +354,14 @@ std::unique_ptr<Site> WinamaxHistory::load(const fs::path& dir) {
   return wh.load(dir, nullptr, nullptr);
 }
 
+void WinamaxHistory::setImportReport(std::shared_ptr<ImportReport> pReport) {
+  m_pImpl->m_pReport = std::move(pReport);
+}
+
+void WinamaxHistory::setFileFilter(std::function<bool(const fs::path&)> isFileToLoad) {
+  m_pImpl->m_isFileToLoad = std::move(isFileToLoad);
+}
+
 void WinamaxHistory::stopLoading() {
   m_pImpl->m_stop = true;
   std::size_t nbTasksFinished = 0;
@@ -245,12 +383,34 @@ std::unique_ptr<Site> WinamaxHistory::reloadFile(const fs::path& file) {
   try {
     ret = WinamaxGameHistory::parseGameHistory(file);
   } catch (const std::exception& e) {
+    Metrics::getNbParseErrors().increment();
     LOG().error<"Exception loading the file {}: {}">(file.string(), e.what());
   }
 
   return ret;
 }
 
+std::unique_ptr<Site> WinamaxHistory::parseAppendedHands(const fs::path& file, std::string hands) {
+  LOG().trace<"Parsing the hands appended to the history file '{}'.">(file.string());
+  PlayerCache cache {ProgramInfos::WINAMAX_SITE_NAME};
+  std::unique_ptr<Site> ret = nullptr;
+
+  try {
+    ret = WinamaxGameHistory::parseGameHistory(file, std::move(hands), cache);
+
+    // the hands may not be parsable
+    if (nullptr != ret) {
+      auto players {cache.extractPlayers()};
+      std::ranges::for_each(players, [&ret](auto& p) { ret->addPlayer(std::move(p)); });
+    }
+  } catch (const std::exception& e) {
+    Metrics::getNbParseErrors().increment();
+    LOG().error<"Exception parsing the hands appended to {}: {}">(file.string(), e.what());
+  }
+
+  return ret;
+}
+
 std::string_view
 WinamaxHistory::getTableNameFromTableWindowTitle(std::string_view tableWindowTitle) const {
   // Remove "Winamax " prefix if present (new format in 2025)
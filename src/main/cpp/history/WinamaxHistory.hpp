@@ -28,14 +28,30 @@ public:
   std::unique_ptr<Site> load(auto, std::function<void()>,
                              std::function<void(std::size_t)>) = delete;
 
+  [[nodiscard]] std::unique_ptr<Site> load(const std::filesystem::path& dir,
+                                           std::function<void()> onProgress,
+                                           std::function<void(std::size_t)> onSetNbFiles,
+                                           ImportOrder importOrder,
+                                           std::function<void(Site&)> onBatchLoaded) override;
+  std::unique_ptr<Site> load(auto, std::function<void()>, std::function<void(std::size_t)>,
+                             ImportOrder, std::function<void(Site&)>) = delete;
+
   [[nodiscard]] static std::unique_ptr<Site> load(const std::filesystem::path& dir);
   std::unique_ptr<Site> load(auto) = delete;
 
   void stopLoading() override;
 
+  void setImportReport(std::shared_ptr<ImportReport> pReport) override;
+
+  void setFileFilter(std::function<bool(const std::filesystem::path&)> isFileToLoad) override;
+
   [[nodiscard]] std::unique_ptr<Site> reloadFile(const std::filesystem::path& file) override;
   std::unique_ptr<Site> reloadFile(auto) = delete;
 
+  [[nodiscard]] std::unique_ptr<Site> parseAppendedHands(const std::filesystem::path& file,
+                                                         std::string hands) override;
+  std::unique_ptr<Site> parseAppendedHands(auto, std::string) = delete;
+
   [[nodiscard]] static bool isValidHistory(const std::filesystem::path& dir);
   static bool isValidHistory(auto) = delete;
 
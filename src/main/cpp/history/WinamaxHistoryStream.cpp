@@ -0,0 +1,239 @@
+#include "constants/ProgramInfos.hpp"
+#include "entities/Player.hpp" // needed as Site declares an incomplete Player type
+#include "entities/Site.hpp"
+#include "history/WinamaxGameHistory.hpp"   // parseGameHistory
+#include "history/WinamaxHistoryStream.hpp" // std::istream, std::string, std::string_view
+#include "log/Logger.hpp"                   // CURRENT_FILE_NAME
+#include "log/Metrics.hpp"                  // Metrics
+#include "strings/StringUtils.hpp"          // phud::strings
+#include "threads/PlayerCache.hpp"          // PlayerCache
+#include <istream>                          // std::getline
+#include <utility>                          // std::exchange
+
+static Logger& LOG() {
+  static auto logger = Logger(CURRENT_FILE_NAME);
+  return logger;
+}
+
+namespace fs = std::filesystem;
+namespace ps = phud::strings;
+
+namespace {
+  constexpr std::string_view UTF8_BOM {"\xEF\xBB\xBF"};
+  constexpr std::string_view WINAMAX_POKER_LINE_START {"Winamax Poker - "};
+  constexpr std::string_view TABLE_LINE_START {"Table: '"};
+  // like '2016/03/31 18:53:49 UTC'
+  constexpr std::string_view DATE_TIME_EXAMPLE {"2016/03/31 18:53:49 UTC"};
+
+  [[nodiscard]] std::string_view toVariant(std::string_view winamaxPokerLine) {
+    if (ps::contains(winamaxPokerLine, " - Holdem ")) {
+      return "holdem";
+    }
+
+    if (ps::contains(winamaxPokerLine, " - 5 Card Omaha ")) {
+      return "omaha5";
+    }
+
+    if (ps::contains(winamaxPokerLine, " - Omaha ")) {
+      return "omaha";
+    }
+
+    return "";
+  }
+
+  [[nodiscard]] std::string_view toLimit(std::string_view winamaxPokerLine) {
+    if (ps::contains(winamaxPokerLine, " no limit (")) {
+      return "no-limit";
+    }
+
+    if (ps::contains(winamaxPokerLine, " pot limit (")) {
+      return "pot-limit";
+    }
+
+    return "";
+  }
+
+  [[nodiscard]] std::string_view toMoney(std::string_view tableLine) {
+    if (ps::contains(tableLine, "(real money)")) {
+      return "real";
+    }
+
+    if (ps::contains(tableLine, "(play money)")) {
+      return "play";
+    }
+
+    return "";
+  }
+
+  // 'Kill The Fish(152800689)#056' -> 'Kill The Fish(152800689)', 'Colorado 1' -> 'Colorado 1'
+  [[nodiscard]] std::string_view toGameName(std::string_view tableLine) {
+    const auto end = tableLine.find("' ", TABLE_LINE_START.size());
+
+    if (std::string_view::npos == end) {
+      return "";
+    }
+
+    const auto tableName = tableLine.substr(TABLE_LINE_START.size(), end - TABLE_LINE_START.size());
+    return ps::contains(tableName, '(') ? tableName.substr(0, tableName.rfind('#')) : tableName;
+  }
+
+  // '... - 2016/03/31 18:53:49 UTC' -> '20160331'
+  [[nodiscard]] std::string toDate(std::string_view winamaxPokerLine) {
+    if (!winamaxPokerLine.ends_with(" UTC") or
+        DATE_TIME_EXAMPLE.size() > winamaxPokerLine.size()) {
+      return "";
+    }
+
+    const auto date = winamaxPokerLine.substr(winamaxPokerLine.size() - DATE_TIME_EXAMPLE.size(),
+                                              ps::length("2016/03/31"));
+    std::string ret;
+    std::ranges::copy_if(date, std::back_inserter(ret), [](char c) { return '/' != c; });
+    return ret;
+  }
+
+  // '20160331_Kill The Fish(152800689)_real_holdem_no-limit' ->
+  // '_Kill The Fish(152800689)_real_holdem_no-limit'
+  [[nodiscard]] std::string_view withoutDate(std::string_view fileStem) {
+    return fileStem.substr(std::min(fileStem.size(), ps::length("20160331")));
+  }
+
+  /**
+   * Splits the stream into games and the games into batches of a bounded number of hands.
+   */
+  class [[nodiscard]] HandStreamParser final {
+  private:
+    // Memory layout optimized: largest to smallest to minimize padding
+    PlayerCache m_cache {ProgramInfos::WINAMAX_SITE_NAME};
+    std::unique_ptr<Site> m_pBatch {std::make_unique<Site>(ProgramInfos::WINAMAX_SITE_NAME)};
+    const std::function<void(Site&)>& m_onBatchParsed;
+    std::string m_gameStem {};
+    std::string m_gameContent {};
+    std::size_t m_maxHandsPerBatch;
+    std::size_t m_nbHandsInBatch = 0;
+    std::size_t m_nbHands = 0;
+
+    void flushGame() {
+      if (m_gameContent.empty()) {
+        return;
+      }
+
+      try {
+        const auto pSite = WinamaxGameHistory::parseGameHistory(
+            fs::path(m_gameStem + ".txt"), std::exchange(m_gameContent, {}), m_cache);
+        m_pBatch->merge(*pSite);
+      } catch (const std::exception& e) {
+        Metrics::getNbParseErrors().increment();
+        LOG().error<"Exception parsing the hands of the game {}: {}">(m_gameStem, e.what());
+      }
+    }
+
+  public:
+    HandStreamParser(std::size_t maxHandsPerBatch, const std::function<void(Site&)>& onBatchParsed)
+      : m_onBatchParsed {onBatchParsed},
+        m_maxHandsPerBatch {std::max<std::size_t>(1, maxHandsPerBatch)} {}
+
+    void addHand(std::string_view winamaxPokerLine, std::string_view tableLine,
+                 std::string_view hand) {
+      const auto oFileStem = WinamaxHistoryStream::toFileStem(winamaxPokerLine, tableLine);
+
+      if (!oFileStem.has_value()) {
+        LOG().error<"Ignoring the hand '{}' as its game can't be guessed.">(winamaxPokerLine);
+        return;
+      }
+
+      // Winamax names the file after the date of the 1st hand, so a game going on after midnight
+      // keeps it
+      if (withoutDate(oFileStem.value()) != withoutDate(m_gameStem)) {
+        flushGame();
+        m_gameStem = oFileStem.value();
+      }
+
+      m_gameContent.append(hand);
+      ++m_nbHands;
+
+      if (++m_nbHandsInBatch >= m_maxHandsPerBatch) {
+        flushBatch();
+      }
+    }
+
+    void flushBatch() {
+      flushGame();
+      auto players = m_cache.extractPlayers();
+      std::ranges::for_each(players, [this](auto& p) { m_pBatch->addPlayer(std::move(p)); });
+      LOG().info<"{} hand{} parsed from the stream.">(m_nbHands, ps::plural(m_nbHands));
+
+      if (m_onBatchParsed) {
+        m_onBatchParsed(*m_pBatch);
+      }
+
+      m_pBatch = std::make_unique<Site>(ProgramInfos::WINAMAX_SITE_NAME);
+      m_nbHandsInBatch = 0;
+    }
+
+    [[nodiscard]] std::size_t getNbHands() const noexcept { return m_nbHands; }
+  }; // class HandStreamParser
+} // anonymous namespace
+
+/* [[nodiscard]] */
+std::optional<std::string> WinamaxHistoryStream::toFileStem(std::string_view winamaxPokerLine,
+                                                           std::string_view tableLine) {
+  if (!winamaxPokerLine.starts_with(WINAMAX_POKER_LINE_START) or
+      !tableLine.starts_with(TABLE_LINE_START)) {
+    return {};
+  }
+
+  const auto date = toDate(winamaxPokerLine);
+  const auto gameName = toGameName(tableLine);
+  const auto money = toMoney(tableLine);
+  const auto variant = toVariant(winamaxPokerLine);
+  const auto limit = toLimit(winamaxPokerLine);
+
+  if (date.empty() or gameName.empty() or money.empty() or variant.empty() or limit.empty()) {
+    return {};
+  }
+
+  return fmt::format("{}_{}_{}_{}_{}", date, gameName, money, variant, limit);
+}
+
+std::size_t WinamaxHistoryStream::parse(std::istream& in, std::size_t maxHandsPerBatch,
+                                        const std::function<void(Site&)>& onBatchParsed) {
+  HandStreamParser parser {maxHandsPerBatch, onBatchParsed};
+  std::string winamaxPokerLine;
+  std::string tableLine;
+  std::string hand;
+  std::string line;
+
+  while (std::getline(in, line)) {
+    // each concatenated file may start with a byte order mark
+    if (line.starts_with(UTF8_BOM)) {
+      line.erase(0, UTF8_BOM.size());
+    }
+
+    if (line.starts_with(WINAMAX_POKER_LINE_START)) {
+      if (!hand.empty()) {
+        parser.addHand(winamaxPokerLine, tableLine, hand);
+      }
+
+      winamaxPokerLine = line;
+      tableLine.clear();
+      hand.clear();
+    } else if (hand.empty()) {
+      if (!line.empty()) {
+        LOG().warn<"Ignoring the line '{}' as it is not part of a hand.">(line);
+      }
+
+      continue;
+    } else if (tableLine.empty()) {
+      tableLine = line;
+    }
+
+    hand.append(line).push_back('\n');
+  }
+
+  if (!hand.empty()) {
+    parser.addHand(winamaxPokerLine, tableLine, hand);
+  }
+
+  parser.flushBatch();
+  return parser.getNbHands();
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstddef>    // std::size_t
+#include <functional> // std::function
+#include <iosfwd>     // std::istream
+#include <optional>
+#include <string>
+#include <string_view>
+
+// forward declarations
+class Site;
+
+/**
+ * Reads concatenated Winamax hand histories from a stream, e.g. 'cat *.txt | dbgen --stdin'.
+ * As there is no file name, the game of each hand is guessed from the hand header lines, and the
+ * consecutive hands of a game get the date of the 1st one, as in the file names. Hence two files
+ * of the same game written on different days, if consecutive in the stream, make a single game.
+ */
+namespace WinamaxHistoryStream {
+  /**
+   * Builds the name, without extension, of the history file Winamax would write the hand in, e.g.
+   * 20160331_Kill The Fish(152800689)_real_holdem_no-limit
+   * @param winamaxPokerLine the 1st line of the hand, starting with 'Winamax Poker - '
+   * @param tableLine the 2nd line of the hand, starting with 'Table: '
+   * @returns the file stem, or nothing if the lines can't be parsed.
+   */
+  [[nodiscard]] std::optional<std::string> toFileStem(std::string_view winamaxPokerLine,
+                                                      std::string_view tableLine);
+
+  /**
+   * Parses the hands read from the given stream. Every maxHandsPerBatch hands, the games and
+   * players parsed so far are given to onBatchParsed then freed, so that the memory usage does not
+   * depend on the amount of data read.
+   * @returns the number of hands read.
+   */
+  std::size_t parse(std::istream& in, std::size_t maxHandsPerBatch,
+                    const std::function<void(Site&)>& onBatchParsed);
+} // namespace WinamaxHistoryStream
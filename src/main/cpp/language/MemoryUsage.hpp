@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstddef> // std::size_t
+#include <string>
+#include <vector>
+
+/**
+ * An estimate of the memory held by objects: their size plus the heap blocks they own, without
+ * the allocator overhead.
+ */
+struct [[nodiscard]] MemoryUsage final {
+  std::size_t m_nbBytes = 0;
+  std::size_t m_nbObjects = 0;
+
+  constexpr MemoryUsage& operator+=(const MemoryUsage& other) noexcept {
+    m_nbBytes += other.m_nbBytes;
+    m_nbObjects += other.m_nbObjects;
+    return *this;
+  }
+
+  [[nodiscard]] friend constexpr MemoryUsage operator+(MemoryUsage a,
+                                                       const MemoryUsage& b) noexcept {
+    return a += b;
+  }
+
+  [[nodiscard]] constexpr bool operator==(const MemoryUsage&) const noexcept = default;
+}; // struct MemoryUsage
+
+namespace memory {
+  /**
+   * @returns the size of the heap block owned by the given string, 0 if it uses the small string
+   * optimization
+   */
+  [[nodiscard]] inline std::size_t getHeapSize(const std::string& s) noexcept {
+    static const auto SMALL_STRING_CAPACITY {std::string().capacity()};
+    return s.capacity() > SMALL_STRING_CAPACITY ? s.capacity() + 1 : 0;
+  }
+
+  /**
+   * @returns the size of the heap block owned by the given vector, not the one of its elements
+   */
+  template <typename T>
+  [[nodiscard]] constexpr std::size_t getHeapSize(const std::vector<T>& v) noexcept {
+    return v.capacity() * sizeof(T);
+  }
+} // namespace memory
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <memory> // std::unique_ptr
+#include <ranges> // std::views::transform
+#include <vector>
+
+namespace phud::ranges {
+  /**
+   * @returns a view of the objects owned by the given vector, as const pointers. Nothing is
+   * allocated: the view is sized and random access, as the vector.
+   */
+  template <typename T>
+  [[nodiscard]] constexpr auto
+  viewPointers(const std::vector<std::unique_ptr<T>>& owners) noexcept {
+    return owners | std::views::transform(
+                        [](const auto& pOwned) noexcept -> const T* { return pOwned.get(); });
+  }
+} // namespace phud::ranges
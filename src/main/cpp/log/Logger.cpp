@@ -1,10 +1,11 @@
 #include "log/Logger.hpp" // std::string_view, std::string
 #include <frozen/unordered_map.h>
-#include <spdlog/async.h>                    // spdlog::async_factory
-#include <spdlog/sinks/basic_file_sink.h>    // spdlog::basic_logger_mt
-#include <spdlog/sinks/stdout_color_sinks.h> // spdlog::stdout_color_mt
+#include <spdlog/async.h>                    // spdlog::async_logger, spdlog::init_thread_pool
+#include <spdlog/sinks/basic_file_sink.h>    // spdlog::sinks::basic_file_sink_mt
+#include <spdlog/sinks/stdout_color_sinks.h> // spdlog::sinks::stdout_color_sink_mt
 #include <spdlog/spdlog.h>                   // spdlog::level::level_enum, spdlog::logger
 #include <cassert>                           // assert
+#include <chrono>                            // std::chrono::seconds
 #include <memory>                            // std::shared_ptr
 
 using LegacyLoggingLevel = spdlog::level::level_enum;
@@ -17,6 +18,41 @@ namespace {
     return *instance;
   }
 
+  // the messages are queued by the logging threads and written by one background thread
+  constexpr std::size_t ASYNC_QUEUE_SIZE {8192};
+  constexpr std::size_t NB_ASYNC_THREADS {1};
+  // the errors are flushed at once, the other messages periodically
+  constexpr auto FLUSH_PERIOD {std::chrono::seconds(1)};
+
+  // the thread pool is owned by spdlog, which drains its queue at exit
+  [[nodiscard]] std::shared_ptr<spdlog::details::thread_pool> getAsyncThreadPool() {
+    if (auto pThreadPool {spdlog::thread_pool()}; nullptr != pThreadPool) {
+      return pThreadPool;
+    }
+
+    spdlog::init_thread_pool(ASYNC_QUEUE_SIZE, NB_ASYNC_THREADS);
+    spdlog::flush_every(FLUSH_PERIOD);
+    return spdlog::thread_pool();
+  }
+
+  [[nodiscard]] constexpr spdlog::async_overflow_policy toAsyncOverflowPolicy(
+      LoggingOverflowPolicy policy) {
+    return LoggingOverflowPolicy::block == policy ? spdlog::async_overflow_policy::block
+                                                  : spdlog::async_overflow_policy::overrun_oldest;
+  }
+
+  [[nodiscard]] std::shared_ptr<spdlog::logger>
+  createAsyncLogger(const std::string& name, spdlog::sink_ptr pSink, LoggingOverflowPolicy policy) {
+    spdlog::drop(name);
+    auto pLogger {std::make_shared<spdlog::async_logger>(name, std::move(pSink),
+                                                         getAsyncThreadPool(),
+                                                         toAsyncOverflowPolicy(policy))};
+    pLogger->flush_on(spdlog::level::warn);
+    // registered to be flushed periodically
+    spdlog::register_logger(pLogger);
+    return pLogger;
+  }
+
   constexpr auto LEGACY_LOGGING_LEVEL_TO_LOGGING_LEVEL {
       frozen::make_unordered_map<LegacyLoggingLevel, LoggingLevel>(
           {{LegacyLoggingLevel::critical, LoggingLevel::critical},
@@ -61,67 +97,58 @@ namespace {
 /*static*/ void Logger::shutdownLogging() {
   auto& globalLogger {getGlobalLogger()};
   assert(nullptr != globalLogger);
+  globalLogger->flush();
   globalLogger->set_level(LegacyLoggingLevel::off);
   spdlog::drop_all();
 }
 
-void Logger::traceStr(std::string_view msg) {
-  auto& globalLogger {getGlobalLogger()};
-  assert(nullptr != globalLogger);
-  globalLogger->trace(msg);
-  globalLogger->flush();
-}
-void Logger::debugStr(std::string_view msg) {
-  auto& globalLogger {getGlobalLogger()};
-  assert(nullptr != globalLogger);
-  globalLogger->debug(msg);
-  globalLogger->flush();
-}
-void Logger::infoStr(std::string_view msg) {
-  auto& globalLogger {getGlobalLogger()};
-  assert(nullptr != globalLogger);
-  globalLogger->info(msg);
-  globalLogger->flush();
+/*[[nodiscard]] static*/ bool Logger::isEnabled(LoggingLevel l) {
+  const auto& globalLogger {getGlobalLogger()};
+  return nullptr != globalLogger and LoggingLevel::none != l and
+         globalLogger->should_log(toLegacyLoggingLevel(l));
 }
-void Logger::warnStr(std::string_view msg) {
-  auto& globalLogger {getGlobalLogger()};
-  assert(nullptr != globalLogger);
-  globalLogger->warn(msg);
-  globalLogger->flush();
-}
-void Logger::errorStr(std::string_view msg) {
-  auto& globalLogger {getGlobalLogger()};
-  assert(nullptr != globalLogger);
-  globalLogger->error(msg);
-  globalLogger->flush();
-}
-void Logger::criticalStr(std::string_view msg) {
+
+/*static*/ void Logger::logStr(LoggingLevel l, std::string_view msg) {
   auto& globalLogger {getGlobalLogger()};
   assert(nullptr != globalLogger);
-  globalLogger->critical(msg);
-  globalLogger->flush();
+  globalLogger->log(toLegacyLoggingLevel(l), msg);
 }
 
 //
 // note: *_mt means "multithread, i.e. all those factories create thread-safe loggers.
 //
 /*static*/ void Logger::setupFileInfoLogging(std::string_view pattern) {
+  setupFileInfoLogging(pattern, LoggingOverflowPolicy::block);
+}
+
+/*static*/ void Logger::setupFileInfoLogging(std::string_view pattern,
+                                             LoggingOverflowPolicy policy) {
   auto& globalLogger {getGlobalLogger()};
-  globalLogger = spdlog::basic_logger_mt<spdlog::async_factory>("fileInfoLogger", "log.txt");
+  globalLogger = createAsyncLogger(
+      "fileInfoLogger", std::make_shared<spdlog::sinks::basic_file_sink_mt>("log.txt"), policy);
   globalLogger->set_pattern(pattern.data());
   globalLogger->set_level(LegacyLoggingLevel::info);
 }
 
 /*static*/ void Logger::setupConsoleWarnLogging(std::string_view pattern) {
   auto& globalLogger {getGlobalLogger()};
-  globalLogger = spdlog::stdout_color_mt<spdlog::async_factory>("consoleWarnLogger");
+  globalLogger = createAsyncLogger("consoleWarnLogger",
+                                   std::make_shared<spdlog::sinks::stdout_color_sink_mt>(),
+                                   LoggingOverflowPolicy::block);
   globalLogger->set_pattern(pattern.data());
   globalLogger->set_level(LegacyLoggingLevel::warn);
 }
 
 /*static*/ void Logger::setupConsoleDebugLogging(std::string_view pattern) {
   auto& globalLogger {getGlobalLogger()};
-  globalLogger = spdlog::stdout_color_mt<spdlog::async_factory>("consoleDebugLogger");
+  globalLogger = createAsyncLogger("consoleDebugLogger",
+                                   std::make_shared<spdlog::sinks::stdout_color_sink_mt>(),
+                                   LoggingOverflowPolicy::block);
   globalLogger->set_pattern(pattern.data());
   globalLogger->set_level(LegacyLoggingLevel::debug);
 }
+
+/*[[nodiscard]] static*/ std::size_t Logger::getNbDroppedMessages() {
+  const auto pThreadPool {spdlog::thread_pool()};
+  return nullptr == pThreadPool ? 0 : pThreadPool->overrun_counter();
+}
@@ -1,7 +1,8 @@
 #pragma once
 
-#include "log/LoggingLevel.hpp"      // std::string_view
-#include "strings/StringLiteral.hpp" // concatLiteral
+#include "log/LoggingLevel.hpp"      // LoggingOverflowPolicy, std::string_view
+#include "strings/StringLiteral.hpp" // StringLiteral
+#include <iterator>                  // std::back_inserter
 #include <span>                      // std::span
 
 #if defined(_MSC_VER) // removal of specific msvc warnings due to fmt
@@ -9,7 +10,7 @@
 #  pragma warning(disable : 4191 4244 4365 4514 4625 4626 4820 5026 5027)
 #endif // _MSC_VER
 
-#include <spdlog/fmt/bundled/format.h> // fmt::format()
+#include <spdlog/fmt/bundled/format.h> // fmt::format_to(), fmt::memory_buffer
 
 #if defined(_MSC_VER) // end of specific msvc warnings removal
 #  pragma warning(pop)
@@ -18,54 +19,73 @@
 class [[nodiscard]] Logger final {
 private:
   std::string_view m_name;
-  static void traceStr(std::string_view msg);
-  static void debugStr(std::string_view msg);
-  static void infoStr(std::string_view msg);
-  static void warnStr(std::string_view msg);
-  static void errorStr(std::string_view msg);
-  static void criticalStr(std::string_view msg);
+  static void logStr(LoggingLevel l, std::string_view msg);
 
 public:
   explicit Logger(std::string_view name)
     : m_name {name} {}
 
-  // to be constexpr, fmt::format requires a constexpr string as first parameter
-  void trace(std::string_view msg) { traceStr(fmt::format("[{}]: {}", m_name, msg)); }
-  void debug(std::string_view msg) { debugStr(fmt::format("[{}]: {}", m_name, msg)); }
-  void info(std::string_view msg) { infoStr(fmt::format("[{}]: {}", m_name, msg)); }
-  void warn(std::string_view msg) { warnStr(fmt::format("[{}]: {}", m_name, msg)); }
-  void error(std::string_view msg) { errorStr(fmt::format("[{}]: {}", m_name, msg)); }
-  void critical(std::string_view msg) { criticalStr(fmt::format("[{}]: {}", m_name, msg)); }
+  /**
+   * @returns true if a message of the given level would be written, false if it would be discarded
+   */
+  [[nodiscard]] static bool isEnabled(LoggingLevel l);
+
+  void log(LoggingLevel l, std::string_view msg) {
+    if (isEnabled(l)) {
+      fmt::memory_buffer buffer;
+      fmt::format_to(std::back_inserter(buffer), "[{}]: {}", m_name, msg);
+      logStr(l, {buffer.data(), buffer.size()});
+    }
+  }
+
+  // the level is checked before formatting, so disabled levels don't pay for the formatting
+  template <LoggingLevel LEVEL, StringLiteral FMT, typename... Args>
+  void log(Args&&... args) {
+    if (isEnabled(LEVEL)) {
+      fmt::memory_buffer buffer;
+      fmt::format_to(std::back_inserter(buffer), "[{}]: ", m_name);
+      // to be constexpr, fmt::format requires a constexpr string as first parameter
+      fmt::format_to(std::back_inserter(buffer), FMT.value, std::forward<Args>(args)...);
+      logStr(LEVEL, {buffer.data(), buffer.size()});
+    }
+  }
+
+  void trace(std::string_view msg) { log(LoggingLevel::trace, msg); }
+  void debug(std::string_view msg) { log(LoggingLevel::debug, msg); }
+  void info(std::string_view msg) { log(LoggingLevel::info, msg); }
+  void warn(std::string_view msg) { log(LoggingLevel::warn, msg); }
+  void error(std::string_view msg) { log(LoggingLevel::error, msg); }
+  void critical(std::string_view msg) { log(LoggingLevel::critical, msg); }
 
   template <StringLiteral FMT, typename... Args>
   void trace(Args&&... args) {
     // static_assert(allTypesAreFormattable<FMT, Args...>()); // TODO
-    trace(fmt::format(FMT.value, std::forward<Args>(args)...));
+    log<LoggingLevel::trace, FMT>(std::forward<Args>(args)...);
   }
 
   template <StringLiteral FMT, typename... Args>
   void debug(Args&&... args) {
-    debug(fmt::format(FMT.value, std::forward<Args>(args)...));
+    log<LoggingLevel::debug, FMT>(std::forward<Args>(args)...);
   }
 
   template <StringLiteral FMT, typename... Args>
   void info(Args&&... args) {
-    info(fmt::format(FMT.value, std::forward<Args>(args)...));
+    log<LoggingLevel::info, FMT>(std::forward<Args>(args)...);
   }
 
   template <StringLiteral FMT, typename... Args>
   void warn(Args&&... args) {
-    warn(fmt::format(FMT.value, std::forward<Args>(args)...));
+    log<LoggingLevel::warn, FMT>(std::forward<Args>(args)...);
   }
 
   template <StringLiteral FMT, typename... Args>
   void error(Args&&... args) {
-    error(fmt::format(FMT.value, std::forward<Args>(args)...));
+    log<LoggingLevel::error, FMT>(std::forward<Args>(args)...);
   }
 
   template <StringLiteral FMT, typename... Args>
   void critical(Args&&... args) {
-    critical(fmt::format(FMT.value, std::forward<Args>(args)...));
+    log<LoggingLevel::critical, FMT>(std::forward<Args>(args)...);
   }
 
   /** Call one of those methods before any logging. */
@@ -86,13 +106,104 @@ public:
    * see https://github.com/gabime/spdlog/wiki/3.-Custom-formatting#pattern-flags
    */
   static void setupFileInfoLogging(std::string_view pattern);
+  static void setupFileInfoLogging(std::string_view pattern, LoggingOverflowPolicy policy);
   static void setupConsoleWarnLogging(std::string_view pattern);
   static void setupConsoleDebugLogging(std::string_view pattern);
   static void shutdownLogging();
+
+  /**
+   * The messages are written to the sinks by a background thread, through a bounded queue. The
+   * logging threads only wait when the queue is full and the overflow policy is
+   * LoggingOverflowPolicy::block.
+   * @returns the number of messages dropped because the queue was full
+   */
+  [[nodiscard]] static std::size_t getNbDroppedMessages();
   static void setLoggingLevel(LoggingLevel l);
   [[nodiscard]] static LoggingLevel getCurrentLoggingLevel();
 }; // class Logger
 
+/**
+ * The minimum level of the logging calls compiled in the hot paths (parsing, SQL), see
+ * MinLevelLogger. Defaults to info in release builds and to trace otherwise.
+ */
+#if !defined(PHUD_HOT_PATH_LOGGING_LEVEL)
+#  if defined(NDEBUG)
+#    define PHUD_HOT_PATH_LOGGING_LEVEL LoggingLevel::info
+#  else
+#    define PHUD_HOT_PATH_LOGGING_LEVEL LoggingLevel::trace
+#  endif
+#endif // PHUD_HOT_PATH_LOGGING_LEVEL
+
+/**
+ * A Logger whose calls below MIN_LEVEL are removed at compile time, arguments evaluation included.
+ * To be used in the translation units where logging is frequent, e.g.
+ * static MinLevelLogger<PHUD_HOT_PATH_LOGGING_LEVEL>& LOG();
+ */
+template <LoggingLevel MIN_LEVEL>
+class [[nodiscard]] MinLevelLogger final {
+private:
+  Logger m_logger;
+
+  [[nodiscard]] static constexpr bool isCompiledIn(LoggingLevel l) noexcept {
+    return LoggingLevel::none != l and LoggingLevel::none != MIN_LEVEL and MIN_LEVEL <= l;
+  }
+
+public:
+  explicit MinLevelLogger(std::string_view name)
+    : m_logger {name} {}
+
+  template <LoggingLevel LEVEL>
+  void log([[maybe_unused]] std::string_view msg) {
+    if constexpr (isCompiledIn(LEVEL)) {
+      m_logger.log(LEVEL, msg);
+    }
+  }
+
+  template <LoggingLevel LEVEL, StringLiteral FMT, typename... Args>
+  void log([[maybe_unused]] Args&&... args) {
+    if constexpr (isCompiledIn(LEVEL)) {
+      m_logger.log<LEVEL, FMT>(std::forward<Args>(args)...);
+    }
+  }
+
+  void trace(std::string_view msg) { log<LoggingLevel::trace>(msg); }
+  void debug(std::string_view msg) { log<LoggingLevel::debug>(msg); }
+  void info(std::string_view msg) { log<LoggingLevel::info>(msg); }
+  void warn(std::string_view msg) { log<LoggingLevel::warn>(msg); }
+  void error(std::string_view msg) { log<LoggingLevel::error>(msg); }
+  void critical(std::string_view msg) { log<LoggingLevel::critical>(msg); }
+
+  template <StringLiteral FMT, typename... Args>
+  void trace(Args&&... args) {
+    log<LoggingLevel::trace, FMT>(std::forward<Args>(args)...);
+  }
+
+  template <StringLiteral FMT, typename... Args>
+  void debug(Args&&... args) {
+    log<LoggingLevel::debug, FMT>(std::forward<Args>(args)...);
+  }
+
+  template <StringLiteral FMT, typename... Args>
+  void info(Args&&... args) {
+    log<LoggingLevel::info, FMT>(std::forward<Args>(args)...);
+  }
+
+  template <StringLiteral FMT, typename... Args>
+  void warn(Args&&... args) {
+    log<LoggingLevel::warn, FMT>(std::forward<Args>(args)...);
+  }
+
+  template <StringLiteral FMT, typename... Args>
+  void error(Args&&... args) {
+    log<LoggingLevel::error, FMT>(std::forward<Args>(args)...);
+  }
+
+  template <StringLiteral FMT, typename... Args>
+  void critical(Args&&... args) {
+    log<LoggingLevel::critical, FMT>(std::forward<Args>(args)...);
+  }
+}; // class MinLevelLogger
+
 // inspired by https://stackoverflow.com/questions/8487986/file-macro-shows-full-path
 // see user Andry
 // also https://godbolt.org/z/u6s8j3
@@ -122,6 +233,9 @@ constexpr std::size_t getFileNameOffset(const CHAR_TYPE (&str)[ARRAY_LENGTH]) {
 
 struct [[nodiscard]] LoggingConfig final {
   explicit LoggingConfig(std::string_view pattern) { Logger::setupFileInfoLogging(pattern); }
+  LoggingConfig(std::string_view pattern, LoggingOverflowPolicy policy) {
+    Logger::setupFileInfoLogging(pattern, policy);
+  }
   LoggingConfig(const LoggingConfig&) = delete;
   LoggingConfig(LoggingConfig&&) = delete;
   LoggingConfig& operator=(const LoggingConfig&) = delete;
@@ -7,6 +7,10 @@ static constexpr auto LOGGING_MAPPER = makeEnumMapper<LoggingLevel>(
     std::pair {LoggingLevel::error, "error"}, std::pair {LoggingLevel::critical, "critical"},
     std::pair {LoggingLevel::none, "none"});
 
+static constexpr auto OVERFLOW_POLICY_MAPPER =
+    makeEnumMapper<LoggingOverflowPolicy>(std::pair {LoggingOverflowPolicy::block, "block"},
+                                          std::pair {LoggingOverflowPolicy::drop, "drop"});
+
 LoggingLevel toLoggingLevel(std::string_view sv) {
   return LOGGING_MAPPER.fromString(sv);
 }
@@ -14,3 +18,11 @@ LoggingLevel toLoggingLevel(std::string_view sv) {
 std::string_view toString(LoggingLevel l) {
   return LOGGING_MAPPER.toString(l);
 }
+
+LoggingOverflowPolicy toLoggingOverflowPolicy(std::string_view sv) {
+  return OVERFLOW_POLICY_MAPPER.fromString(sv);
+}
+
+std::string_view toString(LoggingOverflowPolicy p) {
+  return OVERFLOW_POLICY_MAPPER.toString(p);
+}
@@ -15,3 +15,15 @@ enum class /*[[nodiscard]]*/ LoggingLevel : short {
 [[nodiscard]] LoggingLevel toLoggingLevel(std::string_view sv);
 
 [[nodiscard]] std::string_view toString(LoggingLevel l);
+
+/**
+ * What to do when the asynchronous logging queue is full.
+ */
+enum class /*[[nodiscard]]*/ LoggingOverflowPolicy : short {
+  block, // the logging thread waits for some room in the queue
+  drop   // the oldest message of the queue is dropped, see Logger::getNbDroppedMessages()
+};
+
+[[nodiscard]] LoggingOverflowPolicy toLoggingOverflowPolicy(std::string_view sv);
+
+[[nodiscard]] std::string_view toString(LoggingOverflowPolicy p);
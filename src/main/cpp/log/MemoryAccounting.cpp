@@ -0,0 +1,96 @@
+#include "log/Logger.hpp"           // fmt::format_to
+#include "log/MemoryAccounting.hpp" // MemoryAccounting, MemorySubsystem, MemoryUsage
+#include "log/Metrics.hpp"          // Metrics
+#include <array>
+
+namespace {
+  constexpr std::array SUBSYSTEMS {
+      MemorySubsystem::sitePlayers, MemorySubsystem::siteCashGames,
+      MemorySubsystem::siteTournaments, MemorySubsystem::hands,
+      MemorySubsystem::actions, MemorySubsystem::playerCache,
+      MemorySubsystem::pendingSites, MemorySubsystem::sqlite};
+
+  struct [[nodiscard]] SubsystemGauges final {
+    Metrics::Gauge& m_nbBytes;
+    Metrics::Gauge& m_nbObjects;
+  }; // struct SubsystemGauges
+
+  [[nodiscard]] SubsystemGauges newGauges(MemorySubsystem subsystem) {
+    const auto label {Metrics::toLabel("subsystem", toString(subsystem))};
+    return {.m_nbBytes = Metrics::getGauge("phud_memory_bytes",
+                                           "Estimated number of bytes held by a subsystem.", label),
+            .m_nbObjects = Metrics::getGauge(
+                "phud_memory_objects", "Number of objects held by a subsystem.", label)};
+  }
+
+  // the gauges store the figures, as they are atomic
+  [[nodiscard]] const SubsystemGauges& getGauges(MemorySubsystem subsystem) {
+    static const std::array<SubsystemGauges, SUBSYSTEMS.size()> gauges {
+        newGauges(SUBSYSTEMS[0]), newGauges(SUBSYSTEMS[1]), newGauges(SUBSYSTEMS[2]),
+        newGauges(SUBSYSTEMS[3]), newGauges(SUBSYSTEMS[4]), newGauges(SUBSYSTEMS[5]),
+        newGauges(SUBSYSTEMS[6]), newGauges(SUBSYSTEMS[7])};
+    return gauges.at(static_cast<std::size_t>(subsystem));
+  }
+
+  [[nodiscard]] std::int64_t toSigned(std::size_t n) noexcept {
+    return static_cast<std::int64_t>(n);
+  }
+
+  [[nodiscard]] std::size_t toUnsigned(std::int64_t n) noexcept {
+    return 0 > n ? 0 : static_cast<std::size_t>(n);
+  }
+} // anonymous namespace
+
+/*[[nodiscard]]*/ std::string_view toString(MemorySubsystem subsystem) noexcept {
+  switch (subsystem) {
+    case MemorySubsystem::sitePlayers: return "sitePlayers";
+    case MemorySubsystem::siteCashGames: return "siteCashGames";
+    case MemorySubsystem::siteTournaments: return "siteTournaments";
+    case MemorySubsystem::hands: return "hands";
+    case MemorySubsystem::actions: return "actions";
+    case MemorySubsystem::playerCache: return "playerCache";
+    case MemorySubsystem::pendingSites: return "pendingSites";
+    case MemorySubsystem::sqlite: return "sqlite";
+  }
+
+  return "unknown";
+}
+
+void MemoryAccounting::set(MemorySubsystem subsystem, const MemoryUsage& usage) {
+  const auto& gauges {getGauges(subsystem)};
+  gauges.m_nbBytes.set(toSigned(usage.m_nbBytes));
+  gauges.m_nbObjects.set(toSigned(usage.m_nbObjects));
+}
+
+void MemoryAccounting::add(MemorySubsystem subsystem, const MemoryUsage& usage) {
+  const auto& gauges {getGauges(subsystem)};
+  gauges.m_nbBytes.add(toSigned(usage.m_nbBytes));
+  gauges.m_nbObjects.add(toSigned(usage.m_nbObjects));
+}
+
+void MemoryAccounting::subtract(MemorySubsystem subsystem, const MemoryUsage& usage) {
+  const auto& gauges {getGauges(subsystem)};
+  gauges.m_nbBytes.add(-toSigned(usage.m_nbBytes));
+  gauges.m_nbObjects.add(-toSigned(usage.m_nbObjects));
+}
+
+/*[[nodiscard]]*/ MemoryUsage MemoryAccounting::get(MemorySubsystem subsystem) {
+  const auto& gauges {getGauges(subsystem)};
+  return {.m_nbBytes = toUnsigned(gauges.m_nbBytes.get()),
+          .m_nbObjects = toUnsigned(gauges.m_nbObjects.get())};
+}
+
+/*[[nodiscard]]*/ std::string MemoryAccounting::toString() {
+  std::string ret;
+  auto out {std::back_inserter(ret)};
+  MemoryUsage total;
+  fmt::format_to(out, "{:<16} {:>14} {:>12}\n", "subsystem", "bytes", "objects");
+  std::ranges::for_each(SUBSYSTEMS, [&](MemorySubsystem subsystem) {
+    const auto usage {get(subsystem)};
+    total += usage;
+    fmt::format_to(out, "{:<16} {:>14} {:>12}\n", ::toString(subsystem), usage.m_nbBytes,
+                   usage.m_nbObjects);
+  });
+  fmt::format_to(out, "{:<16} {:>14} {:>12}\n", "total", total.m_nbBytes, total.m_nbObjects);
+  return ret;
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "language/MemoryUsage.hpp" // MemoryUsage
+#include <string>
+#include <string_view>
+
+/**
+ * The parts of phud whose memory is accounted.
+ */
+enum class /*[[nodiscard]]*/ MemorySubsystem : short {
+  sitePlayers,     // the players of the last imported Site
+  siteCashGames,   // the cash games of the last imported Site, without their hands
+  siteTournaments, // the tournaments of the last imported Site, without their hands
+  hands,           // the hands of the last imported Site, without their actions
+  actions,         // the actions of the last imported Site
+  playerCache,     // the players met by the import before being handed over
+  pendingSites,    // the parsed sites waiting in the import futures to be merged
+  sqlite           // the memory allocated by SQLite
+};
+
+[[nodiscard]] std::string_view toString(MemorySubsystem subsystem) noexcept;
+
+/**
+ * The memory held by each subsystem, as estimated by the subsystems themselves. The figures are
+ * also exported as the phud_memory_bytes and phud_memory_objects metrics.
+ */
+namespace MemoryAccounting {
+  /**
+   * Sets the memory held by the given subsystem. Thread safe.
+   */
+  void set(MemorySubsystem subsystem, const MemoryUsage& usage);
+
+  /**
+   * Adds to (or subtracts from) the memory held by the given subsystem. Thread safe.
+   */
+  void add(MemorySubsystem subsystem, const MemoryUsage& usage);
+  void subtract(MemorySubsystem subsystem, const MemoryUsage& usage);
+
+  /**
+   * @returns the memory held by the given subsystem. Thread safe.
+   */
+  [[nodiscard]] MemoryUsage get(MemorySubsystem subsystem);
+
+  /**
+   * @returns the memory held by each subsystem, one line per subsystem, and the total
+   */
+  [[nodiscard]] std::string toString();
+} // namespace MemoryAccounting
@@ -0,0 +1,284 @@
+#include "log/Logger.hpp"  // CURRENT_FILE_NAME, fmt::format_to
+#include "log/Metrics.hpp" // Metrics, std::filesystem::path, std::string, std::string_view
+#include <fstream>         // std::ofstream
+#include <functional>      // std::less
+#include <map>
+#include <memory> // std::unique_ptr
+#include <mutex>
+
+static Logger& LOG() {
+  static auto logger = Logger(CURRENT_FILE_NAME);
+  return logger;
+}
+
+namespace fs = std::filesystem;
+
+namespace {
+  // the series of a metric, by labels
+  template <typename METRIC>
+  struct [[nodiscard]] Family final {
+    std::string m_help;
+    std::map<std::string, std::unique_ptr<METRIC>, std::less<>> m_series {};
+  }; // struct Family
+
+  template <typename METRIC>
+  using Families = std::map<std::string, Family<METRIC>, std::less<>>;
+
+  // use a lazy singleton to avoid the static initialization fiasco
+  struct [[nodiscard]] Registry final {
+    Families<Metrics::Counter> m_counters {};
+    Families<Metrics::Gauge> m_gauges {};
+    Families<Metrics::Histogram> m_histograms {};
+    std::mutex m_mutex {};
+  }; // struct Registry
+
+  // intentional leak to avoid exit-time destructor warning, the metrics living as long as phud
+  Registry& getRegistry() {
+    static auto* instance {new Registry()};
+    return *instance;
+  }
+
+  template <typename METRIC>
+  [[nodiscard]] METRIC& getMetric(Families<METRIC>& families, std::string_view name,
+                                  std::string_view help, std::string_view labels) {
+    auto& registry {getRegistry()};
+    std::scoped_lock lock {registry.m_mutex};
+    auto familyIt {families.find(name)};
+
+    if (families.end() == familyIt) {
+      familyIt = families.emplace(std::string(name), Family<METRIC> {std::string(help)}).first;
+    }
+
+    auto& series {familyIt->second.m_series};
+    auto seriesIt {series.find(labels)};
+
+    if (series.end() == seriesIt) {
+      seriesIt = series.emplace(std::string(labels), std::make_unique<METRIC>()).first;
+    }
+
+    return *seriesIt->second;
+  }
+
+  using Output = std::back_insert_iterator<std::string>;
+
+  // 'name{labels}' or 'name' if there is no label
+  void writeSeriesName(Output out, std::string_view name, std::string_view labels) {
+    if (labels.empty()) {
+      fmt::format_to(out, "{}", name);
+    } else {
+      fmt::format_to(out, "{}{{{}}}", name, labels);
+    }
+  }
+
+  void writeHeader(Output out, std::string_view name, std::string_view help,
+                   std::string_view type) {
+    fmt::format_to(out, "# HELP {} {}\n# TYPE {} {}\n", name, help, name, type);
+  }
+
+  template <typename METRIC>
+  void writeFamilies(Output out, const Families<METRIC>& families, std::string_view type) {
+    std::ranges::for_each(families, [&](const auto& nameAndFamily) {
+      const auto& [name, family] {nameAndFamily};
+      writeHeader(out, name, family.m_help, type);
+      std::ranges::for_each(family.m_series, [&](const auto& labelsAndMetric) {
+        writeSeriesName(out, name, labelsAndMetric.first);
+        fmt::format_to(out, " {}\n", labelsAndMetric.second->get());
+      });
+    });
+  }
+
+  void writeHistograms(Output out, const Families<Metrics::Histogram>& families) {
+    constexpr auto& BOUNDS {Metrics::Histogram::BUCKET_BOUNDS_IN_SECONDS};
+    std::ranges::for_each(families, [&](const auto& nameAndFamily) {
+      const auto& [name, family] {nameAndFamily};
+      writeHeader(out, name, family.m_help, "histogram");
+      std::ranges::for_each(family.m_series, [&](const auto& labelsAndMetric) {
+        const auto& [labels, pHistogram] {labelsAndMetric};
+        const auto separator {labels.empty() ? "" : ","};
+
+        for (std::size_t i = 0; i <= BOUNDS.size(); ++i) {
+          const auto bound {BOUNDS.size() == i ? std::string("+Inf")
+                                               : fmt::format("{}", BOUNDS[i])};
+          fmt::format_to(out, "{}_bucket{{{}{}le=\"{}\"}} {}\n", name, labels, separator, bound,
+                         pHistogram->getCumulativeCount(i));
+        }
+
+        writeSeriesName(out, fmt::format("{}_sum", name), labels);
+        fmt::format_to(out, " {}\n", pHistogram->getSumInSeconds());
+        writeSeriesName(out, fmt::format("{}_count", name), labels);
+        fmt::format_to(out, " {}\n", pHistogram->getCount());
+      });
+    });
+  }
+} // anonymous namespace
+
+void Metrics::Histogram::observe(std::chrono::steady_clock::duration latency) noexcept {
+  const auto micros {std::chrono::duration_cast<std::chrono::microseconds>(latency).count()};
+  const auto seconds {std::chrono::duration<double>(latency).count()};
+  const auto it {std::ranges::find_if(BUCKET_BOUNDS_IN_SECONDS,
+                                      [seconds](double bound) { return seconds <= bound; })};
+  const auto bucket {
+      static_cast<std::size_t>(std::distance(BUCKET_BOUNDS_IN_SECONDS.begin(), it))};
+  m_buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+  m_sumInMicros.fetch_add(static_cast<std::uint64_t>(std::max<std::int64_t>(0, micros)),
+                          std::memory_order_relaxed);
+  m_count.fetch_add(1, std::memory_order_relaxed);
+}
+
+/*[[nodiscard]]*/ std::uint64_t
+Metrics::Histogram::getCumulativeCount(std::size_t bucket) const noexcept {
+  std::uint64_t ret {0};
+
+  for (std::size_t i = 0; i <= bucket and i < m_buckets.size(); ++i) {
+    ret += m_buckets[i].load(std::memory_order_relaxed);
+  }
+
+  return ret;
+}
+
+/*[[nodiscard]]*/ double Metrics::Histogram::getSumInSeconds() const noexcept {
+  return static_cast<double>(m_sumInMicros.load(std::memory_order_relaxed)) / 1'000'000.0;
+}
+
+/*[[nodiscard]]*/ Metrics::Counter& Metrics::getCounter(std::string_view name,
+                                                        std::string_view help,
+                                                        std::string_view labels) {
+  return getMetric(getRegistry().m_counters, name, help, labels);
+}
+
+/*[[nodiscard]]*/ Metrics::Gauge& Metrics::getGauge(std::string_view name, std::string_view help,
+                                                    std::string_view labels) {
+  return getMetric(getRegistry().m_gauges, name, help, labels);
+}
+
+/*[[nodiscard]]*/ Metrics::Histogram& Metrics::getHistogram(std::string_view name,
+                                                            std::string_view help,
+                                                            std::string_view labels) {
+  return getMetric(getRegistry().m_histograms, name, help, labels);
+}
+
+/*[[nodiscard]]*/ std::string Metrics::toLabel(std::string_view name, std::string_view value) {
+  std::string ret {name};
+  ret.append("=\"");
+
+  for (const auto c : value) {
+    if ('\\' == c or '"' == c) {
+      ret.push_back('\\');
+      ret.push_back(c);
+    } else if ('\n' == c) {
+      ret.append("\\n");
+    } else {
+      ret.push_back(c);
+    }
+  }
+
+  ret.push_back('"');
+  return ret;
+}
+
+/*[[nodiscard]]*/ std::string Metrics::toPrometheusText() {
+  auto& registry {getRegistry()};
+  std::string ret;
+  auto out {std::back_inserter(ret)};
+  std::scoped_lock lock {registry.m_mutex};
+  writeFamilies(out, registry.m_counters, "counter");
+  writeFamilies(out, registry.m_gauges, "gauge");
+  writeHistograms(out, registry.m_histograms);
+  return ret;
+}
+
+/*[[nodiscard]]*/ bool Metrics::dump(const fs::path& file) {
+  auto tmpFile {file};
+  tmpFile += ".tmp";
+  {
+    std::ofstream os {tmpFile, std::ios::binary | std::ios::trunc};
+    os << toPrometheusText();
+
+    if (!os.flush()) {
+      LOG().error<"Couldn't write the metrics file {}">(tmpFile.string());
+      return false;
+    }
+  }
+  std::error_code ec;
+  fs::rename(tmpFile, file, ec);
+
+  if (ec) {
+    LOG().error<"Couldn't replace the metrics file {}: {}">(file.string(), ec.message());
+    return false;
+  }
+
+  return true;
+}
+
+/*[[nodiscard]]*/ Metrics::Counter& Metrics::getNbFilesParsed() {
+  static auto& ret {getCounter("phud_files_parsed_total", "Number of history files parsed.")};
+  return ret;
+}
+
+/*[[nodiscard]]*/ Metrics::Counter& Metrics::getNbHandsParsed() {
+  static auto& ret {getCounter("phud_hands_parsed_total", "Number of hands parsed.")};
+  return ret;
+}
+
+/*[[nodiscard]]*/ Metrics::Counter& Metrics::getNbHandsInserted() {
+  static auto& ret {getCounter("phud_hands_inserted_total", "Number of hands inserted in the DB.")};
+  return ret;
+}
+
+/*[[nodiscard]]*/ Metrics::Counter& Metrics::getNbBytesRead() {
+  static auto& ret {getCounter("phud_bytes_read_total", "Number of bytes read from the files.")};
+  return ret;
+}
+
+/*[[nodiscard]]*/ Metrics::Counter& Metrics::getNbParseErrors() {
+  static auto& ret {getCounter("phud_parse_errors_total", "Number of history parsing errors.")};
+  return ret;
+}
+
+/*[[nodiscard]]*/ Metrics::Gauge& Metrics::getNbQueuedFiles() {
+  static auto& ret {getGauge("phud_queued_files", "Number of history files waiting to be parsed.")};
+  return ret;
+}
+
+/*[[nodiscard]]*/ Metrics::Counter& Metrics::getNbHistoryFileChanges() {
+  static auto& ret {getCounter("phud_history_file_changes_total",
+                               "Number of changes of the watched history files.")};
+  return ret;
+}
+
+/*[[nodiscard]]*/ Metrics::Counter& Metrics::getNbHistoryFileReloads() {
+  static auto& ret {getCounter("phud_history_file_reloads_total",
+                               "Number of reloads of the watched history files.")};
+  return ret;
+}
+
+/*[[nodiscard]]*/ Metrics::Histogram& Metrics::getDbTransactionLatency() {
+  static auto& ret {
+      getHistogram("phud_db_transaction_seconds", "Duration of the DB transactions.")};
+  return ret;
+}
+
+/*[[nodiscard]]*/ Metrics::Histogram& Metrics::getHudRefreshLatency(std::string_view table) {
+  return getHistogram("phud_hud_refresh_seconds",
+                      "Duration from a history file change to the HUD notification.",
+                      toLabel("table", table));
+}
+
+MetricsExporter::MetricsExporter(const fs::path& file, std::chrono::milliseconds period)
+  : m_file {file},
+    m_task {period, "MetricsExporter"} {
+  LOG().info<"Exporting the metrics to {}">(file.string());
+  m_task.start([this]() {
+    std::ignore = Metrics::dump(m_file);
+    return PeriodicTaskStatus::repeatTask;
+  });
+}
+
+MetricsExporter::~MetricsExporter() {
+  try {
+    m_task.stop();
+    std::ignore = Metrics::dump(m_file);
+  } catch (...) {
+    LOG().error<"Unknown error when exporting the metrics a last time.">();
+  }
+}
@@ -0,0 +1,126 @@
+#pragma once
+
+#include "threads/PeriodicTask.hpp" // PeriodicTask, std::chrono
+#include <array>
+#include <atomic>
+#include <cstdint>    // std::uint64_t, std::int64_t
+#include <filesystem> // std::filesystem::path
+#include <string>
+#include <string_view>
+
+/**
+ * A registry of atomic counters, gauges and latency histograms, exported in the Prometheus text
+ * format. The metrics live as long as the program, so the references returned by the getters can
+ * be kept in static variables to skip the registry lookup in the hot paths, e.g.
+ * static auto& nbFiles {Metrics::getCounter("phud_files_parsed_total", "Files parsed.")};
+ */
+namespace Metrics {
+  class [[nodiscard]] Counter final {
+  private:
+    std::atomic<std::uint64_t> m_value {0};
+
+  public:
+    void increment(std::uint64_t n = 1) noexcept {
+      m_value.fetch_add(n, std::memory_order_relaxed);
+    }
+    [[nodiscard]] std::uint64_t get() const noexcept {
+      return m_value.load(std::memory_order_relaxed);
+    }
+  }; // class Counter
+
+  class [[nodiscard]] Gauge final {
+  private:
+    std::atomic<std::int64_t> m_value {0};
+
+  public:
+    void set(std::int64_t value) noexcept { m_value.store(value, std::memory_order_relaxed); }
+    void add(std::int64_t n) noexcept { m_value.fetch_add(n, std::memory_order_relaxed); }
+    [[nodiscard]] std::int64_t get() const noexcept {
+      return m_value.load(std::memory_order_relaxed);
+    }
+  }; // class Gauge
+
+  /**
+   * A latency histogram with fixed buckets, from 1 ms to 10 s.
+   */
+  class [[nodiscard]] Histogram final {
+  public:
+    static constexpr std::array<double, 13> BUCKET_BOUNDS_IN_SECONDS {
+        0.001, 0.0025, 0.005, 0.01, 0.025, 0.05, 0.1, 0.25, 0.5, 1.0, 2.5, 5.0, 10.0};
+
+  private:
+    // the last bucket counts the values above the last bound
+    std::array<std::atomic<std::uint64_t>, BUCKET_BOUNDS_IN_SECONDS.size() + 1> m_buckets {};
+    std::atomic<std::uint64_t> m_sumInMicros {0};
+    std::atomic<std::uint64_t> m_count {0};
+
+  public:
+    void observe(std::chrono::steady_clock::duration latency) noexcept;
+    /**
+     * @returns the number of values lower or equal to the bound of the given bucket, the last
+     * bucket returning the number of values
+     */
+    [[nodiscard]] std::uint64_t getCumulativeCount(std::size_t bucket) const noexcept;
+    [[nodiscard]] double getSumInSeconds() const noexcept;
+    [[nodiscard]] std::uint64_t getCount() const noexcept {
+      return m_count.load(std::memory_order_relaxed);
+    }
+  }; // class Histogram
+
+  /**
+   * @param labels the labels of the series, as returned by toLabel(), empty for no label
+   * @returns the counter of the given name and labels, created on the 1st call. Thread safe.
+   */
+  [[nodiscard]] Counter& getCounter(std::string_view name, std::string_view help,
+                                    std::string_view labels = "");
+  [[nodiscard]] Gauge& getGauge(std::string_view name, std::string_view help,
+                                std::string_view labels = "");
+  [[nodiscard]] Histogram& getHistogram(std::string_view name, std::string_view help,
+                                        std::string_view labels = "");
+
+  /**
+   * @returns the label 'name="value"', value being escaped
+   */
+  [[nodiscard]] std::string toLabel(std::string_view name, std::string_view value);
+
+  /**
+   * @returns all the metrics in the Prometheus text exposition format
+   */
+  [[nodiscard]] std::string toPrometheusText();
+
+  /**
+   * Writes all the metrics to the given file, replacing it at once so a reader never sees a
+   * partial file.
+   * @returns false if the file couldn't be written
+   */
+  [[nodiscard]] bool dump(const std::filesystem::path& file);
+
+  // the metrics of phud
+  [[nodiscard]] Counter& getNbFilesParsed();
+  [[nodiscard]] Counter& getNbHandsParsed();
+  [[nodiscard]] Counter& getNbHandsInserted();
+  [[nodiscard]] Counter& getNbBytesRead();
+  [[nodiscard]] Counter& getNbParseErrors();
+  [[nodiscard]] Gauge& getNbQueuedFiles();
+  [[nodiscard]] Counter& getNbHistoryFileChanges();
+  [[nodiscard]] Counter& getNbHistoryFileReloads();
+  [[nodiscard]] Histogram& getDbTransactionLatency();
+  [[nodiscard]] Histogram& getHudRefreshLatency(std::string_view table);
+} // namespace Metrics
+
+/**
+ * Dumps the metrics periodically to a file, and a last time when destroyed.
+ */
+class [[nodiscard]] MetricsExporter final {
+private:
+  std::filesystem::path m_file;
+  PeriodicTask m_task;
+
+public:
+  MetricsExporter(const std::filesystem::path& file, std::chrono::milliseconds period);
+  MetricsExporter(const MetricsExporter&) = delete;
+  MetricsExporter(MetricsExporter&&) = delete;
+  MetricsExporter& operator=(const MetricsExporter&) = delete;
+  MetricsExporter& operator=(MetricsExporter&&) = delete;
+  ~MetricsExporter();
+}; // class MetricsExporter
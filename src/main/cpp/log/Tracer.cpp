@@ -0,0 +1,188 @@
+#include "log/Logger.hpp" // CURRENT_FILE_NAME
+#include "log/Tracer.hpp" // std::filesystem::path, std::int64_t, std::string_view
+#include <algorithm> // std::ranges::for_each
+#include <atomic>
+#include <chrono>
+#include <fstream> // std::ofstream
+#include <memory>  // std::shared_ptr
+#include <mutex>
+#include <vector>
+
+static Logger& LOG() {
+  static auto logger = Logger(CURRENT_FILE_NAME);
+  return logger;
+}
+
+namespace {
+  struct [[nodiscard]] TraceEvent final {
+    // Memory layout optimized: largest to smallest to minimize padding
+    std::string_view m_name;
+    std::int64_t m_startMicros;
+    std::int64_t m_durationMicros;
+    std::uint32_t m_threadId;
+  }; // struct TraceEvent
+
+  // the last spans of a thread, the oldest ones being overwritten when it is full
+  struct [[nodiscard]] ThreadSpans final {
+    std::vector<TraceEvent> m_events {};
+    std::size_t m_nbRecorded = 0;
+    // only contended by the start and the stop of the tracing
+    std::mutex m_mutex {};
+
+    void add(const TraceEvent& event) {
+      if (m_events.size() < Tracer::MAX_SPANS_PER_THREAD) {
+        m_events.push_back(event);
+      } else {
+        m_events[m_nbRecorded % Tracer::MAX_SPANS_PER_THREAD] = event;
+      }
+
+      ++m_nbRecorded;
+    }
+
+    // moves the events to the given vector, from the oldest to the newest
+    [[nodiscard]] std::size_t extractTo(std::vector<TraceEvent>& events) {
+      const auto nbDropped {m_nbRecorded - m_events.size()};
+
+      if (m_events.size() < Tracer::MAX_SPANS_PER_THREAD) {
+        events.insert(events.end(), m_events.begin(), m_events.end());
+      } else {
+        const auto oldest {m_events.begin() + static_cast<std::ptrdiff_t>(
+                                                  m_nbRecorded % Tracer::MAX_SPANS_PER_THREAD)};
+        events.insert(events.end(), oldest, m_events.end());
+        events.insert(events.end(), m_events.begin(), oldest);
+      }
+
+      clear();
+      return nbDropped;
+    }
+
+    void clear() {
+      m_events.clear();
+      m_nbRecorded = 0;
+    }
+  }; // struct ThreadSpans
+
+  // use a lazy singleton to avoid the static initialization fiasco
+  struct [[nodiscard]] TraceRecorder final {
+    // the spans of each thread, shared with the thread which records them
+    std::vector<std::shared_ptr<ThreadSpans>> m_threadSpans {};
+    std::mutex m_mutex {};
+    // atomic as the spans of running threads may read it while the tracing restarts
+    std::atomic<std::chrono::steady_clock::rep> m_start {
+        std::chrono::steady_clock::now().time_since_epoch().count()};
+    std::atomic<std::size_t> m_nbDroppedSpans {0};
+    std::atomic<bool> m_enabled {false};
+  }; // struct TraceRecorder
+
+  // intentional leak to avoid exit-time destructor warning
+  TraceRecorder& getRecorder() {
+    static auto* instance {new TraceRecorder()};
+    return *instance;
+  }
+
+  // the spans of the current thread, registered on its 1st span
+  [[nodiscard]] ThreadSpans& getThreadSpans() {
+    thread_local const auto pThreadSpans {[] {
+      auto ret {std::make_shared<ThreadSpans>()};
+      auto& recorder {getRecorder()};
+      std::scoped_lock lock {recorder.m_mutex};
+      recorder.m_threadSpans.push_back(ret);
+      return ret;
+    }()};
+    return *pThreadSpans;
+  }
+
+  // small consecutive ids are easier to read than the std::thread::id values in a trace viewer
+  [[nodiscard]] std::uint32_t getThreadId() noexcept {
+    static std::atomic<std::uint32_t> nbThreads {0};
+    thread_local const auto threadId {++nbThreads};
+    return threadId;
+  }
+
+  void writeEvent(std::ostream& os, const TraceEvent& event) {
+    os << R"({"name":")" << event.m_name << R"(","cat":"phud","ph":"X","pid":1,"tid":)"
+       << event.m_threadId << R"(,"ts":)" << event.m_startMicros << R"(,"dur":)"
+       << event.m_durationMicros << '}';
+  }
+} // anonymous namespace
+
+void Tracer::start() {
+  auto& recorder {getRecorder()};
+  std::scoped_lock lock {recorder.m_mutex};
+  // forget the threads which have ended
+  std::erase_if(recorder.m_threadSpans, [](const auto& p) { return 1 == p.use_count(); });
+  std::ranges::for_each(recorder.m_threadSpans, [](const auto& pThreadSpans) {
+    std::scoped_lock threadLock {pThreadSpans->m_mutex};
+    pThreadSpans->clear();
+  });
+  recorder.m_nbDroppedSpans.store(0);
+  recorder.m_start.store(std::chrono::steady_clock::now().time_since_epoch().count());
+  recorder.m_enabled.store(true, std::memory_order_release);
+  LOG().info<"Tracing started">();
+}
+
+/*[[nodiscard]]*/ bool Tracer::stop(const std::filesystem::path& traceFile) {
+  auto& recorder {getRecorder()};
+  recorder.m_enabled.store(false, std::memory_order_release);
+  std::vector<TraceEvent> events;
+  std::size_t nbDroppedSpans = 0;
+  {
+    std::scoped_lock lock {recorder.m_mutex};
+    std::ranges::for_each(recorder.m_threadSpans, [&](const auto& pThreadSpans) {
+      std::scoped_lock threadLock {pThreadSpans->m_mutex};
+      nbDroppedSpans += pThreadSpans->extractTo(events);
+    });
+  }
+  recorder.m_nbDroppedSpans.store(nbDroppedSpans);
+
+  if (0 < nbDroppedSpans) {
+    LOG().warn<"{} spans dropped, only the last {} spans of each thread are kept">(
+        nbDroppedSpans, MAX_SPANS_PER_THREAD);
+  }
+
+  std::ofstream os {traceFile};
+  os << R"({"displayTimeUnit":"ms","traceEvents":[)";
+
+  for (std::size_t i = 0; i < events.size(); ++i) {
+    os << (0 == i ? "\n" : ",\n");
+    writeEvent(os, events[i]);
+  }
+
+  os << "\n]}\n";
+  os.flush();
+
+  if (!os) {
+    LOG().error<"Couldn't write the trace file {}">(traceFile.string());
+    return false;
+  }
+
+  LOG().info<"{} spans written to the trace file {}">(events.size(), traceFile.string());
+  return true;
+}
+
+/*[[nodiscard]]*/ std::size_t Tracer::getNbDroppedSpans() noexcept {
+  return getRecorder().m_nbDroppedSpans.load();
+}
+
+/*[[nodiscard]]*/ bool Tracer::isEnabled() noexcept {
+  return getRecorder().m_enabled.load(std::memory_order_relaxed);
+}
+
+void Tracer::record(std::string_view name, std::int64_t startMicros, std::int64_t durationMicros) {
+  auto& threadSpans {getThreadSpans()};
+  std::scoped_lock lock {threadSpans.m_mutex};
+
+  if (getRecorder().m_enabled.load(std::memory_order_relaxed)) {
+    threadSpans.add({.m_name = name,
+                     .m_startMicros = startMicros,
+                     .m_durationMicros = durationMicros,
+                     .m_threadId = getThreadId()});
+  }
+}
+
+/*[[nodiscard]]*/ std::int64_t Tracer::nowMicros() noexcept {
+  const std::chrono::steady_clock::duration start {getRecorder().m_start.load()};
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+             std::chrono::steady_clock::now().time_since_epoch() - start)
+      .count();
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstddef>    // std::size_t
+#include <cstdint>    // std::int64_t
+#include <filesystem> // std::filesystem::path
+#include <string_view>
+
+/**
+ * Opt-in recording of timed spans, written as a Chrome trace event JSON file that can be opened in
+ * chrome://tracing or https://ui.perfetto.dev.
+ * When tracing is not started, a span costs one atomic load.
+ * Each thread keeps its last spans in its own bounded buffer, so that a long session neither grows
+ * the memory nor makes the threads wait for each other.
+ */
+namespace Tracer {
+  // beyond it, the oldest spans of a thread are dropped
+  static constexpr std::size_t MAX_SPANS_PER_THREAD {1U << 13};
+
+  /**
+   * Starts recording the spans, previously recorded spans are discarded.
+   */
+  void start();
+
+  /**
+   * Stops recording the spans and writes them to the given file.
+   * @returns false if the file couldn't be written
+   */
+  [[nodiscard]] bool stop(const std::filesystem::path& traceFile);
+
+  /**
+   * @returns the number of spans dropped between the last start and stop
+   */
+  [[nodiscard]] std::size_t getNbDroppedSpans() noexcept;
+
+  [[nodiscard]] bool isEnabled() noexcept;
+
+  /**
+   * Records a span, the name must be a string literal.
+   */
+  void record(std::string_view name, std::int64_t startMicros, std::int64_t durationMicros);
+
+  /**
+   * @returns the number of microseconds since the tracing started
+   */
+  [[nodiscard]] std::int64_t nowMicros() noexcept;
+} // namespace Tracer
+
+/**
+ * Records the time spent in its scope, e.g.
+ * const TraceSpan span {"Database::save"};
+ */
+class [[nodiscard]] TraceSpan final {
+private:
+  std::string_view m_name;
+  std::int64_t m_startMicros;
+
+public:
+  template <std::size_t N>
+  explicit TraceSpan(const char (&name)[N]) noexcept
+    : m_name {name, N - 1},
+      m_startMicros {Tracer::isEnabled() ? Tracer::nowMicros() : -1} {}
+
+  TraceSpan(const TraceSpan&) = delete;
+  TraceSpan(TraceSpan&&) = delete;
+  TraceSpan& operator=(const TraceSpan&) = delete;
+  TraceSpan& operator=(TraceSpan&&) = delete;
+
+  ~TraceSpan() {
+    if (0 <= m_startMicros) {
+      Tracer::record(m_name, m_startMicros, Tracer::nowMicros() - m_startMicros);
+    }
+  }
+}; // class TraceSpan
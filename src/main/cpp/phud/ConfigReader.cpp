@@ -51,6 +51,26 @@ namespace {
             config.historyDirectory = std::filesystem::path(value);
           } else if (key == "logging.pattern") {
             config.loggingPattern = value;
+          } else if (key == "metrics.file") {
+            config.metricsFile = std::filesystem::path(value);
+          } else if (key == "db.profiling") {
+            if ("true" != value and "false" != value) {
+              throw ConfigReaderException(std::format(
+                  "Error at line {}: Invalid db profiling '{}', should be true or false", lineNb,
+                  value));
+            }
+
+            config.isSqlProfilingEnabled = "true" == value;
+          } else if (key == "tracing.file") {
+            config.tracingFile = std::filesystem::path(value);
+          } else if (key == "logging.overflow") {
+            try {
+              config.loggingOverflowPolicy = toLoggingOverflowPolicy(value);
+            } catch (const std::exception& e) {
+              throw ConfigReaderException(
+                  std::format("Error at line {}: Invalid logging overflow policy '{}': {}", lineNb,
+                              value, e.what()));
+            }
           } else {
             throw ConfigReaderException(
                 std::format("Error at line {}: unknown configuration key: '{}'", lineNb, key));
@@ -75,8 +95,16 @@ namespace {
       file << "# Logging pattern (spdlog format): %Y-%m-%d for YYYY-MM-DD, %Y%m%d for YYYYMMDD\n";
       file << "# See https://github.com/gabime/spdlog/wiki/3.-Custom-formatting#pattern-flags\n";
       file << "logging.pattern=[%Y%m%d %H:%M:%S.%e] [%l] [%t] %v\n\n";
+      file << "# When the logging queue is full: block (wait) or drop (lose the oldest message)\n";
+      file << "logging.overflow=block\n\n";
       file << "# History directory (leave empty if no directory configured)\n";
-      file << "history.directory=\n";
+      file << "history.directory=\n\n";
+      file << "# Chrome trace event file written on exit (leave empty to disable the tracing)\n";
+      file << "tracing.file=\n\n";
+      file << "# Prometheus text file updated every 10 seconds (leave empty to disable it)\n";
+      file << "metrics.file=\n\n";
+      file << "# Profile the SQL statements, written on exit next to the database: true or false\n";
+      file << "db.profiling=false\n";
       file.close();
     } else {
       throw ConfigReaderException(
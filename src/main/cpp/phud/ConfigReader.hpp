@@ -6,6 +6,7 @@
 
 // forward declarations
 enum class LoggingLevel : short;
+enum class LoggingOverflowPolicy : short;
 
 /**
  * @brief Configuration reader for PHUD settings
@@ -15,6 +16,10 @@ namespace ConfigReader {
     std::optional<LoggingLevel> loggingLevel = {};
     std::optional<std::filesystem::path> historyDirectory = {};
     std::optional<std::string> loggingPattern = {};
+    std::optional<LoggingOverflowPolicy> loggingOverflowPolicy = {};
+    std::optional<std::filesystem::path> tracingFile = {};
+    std::optional<std::filesystem::path> metricsFile = {};
+    std::optional<bool> isSqlProfilingEnabled = {};
   };
 
   /**
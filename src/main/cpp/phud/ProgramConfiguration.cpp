@@ -25,7 +25,11 @@ ProgramConfiguration::readConfiguration(std::span<const char* const> args) {
   }();
   const auto loggingPattern =
       config.loggingPattern.has_value() ? config.loggingPattern.value() : DEFAULT_LOGGING_PATTERN;
+  const auto loggingOverflowPolicy =
+      config.loggingOverflowPolicy.value_or(LoggingOverflowPolicy::block);
   const auto oHistoryDir = oHistoDirArg.has_value() ? oHistoDirArg : config.historyDirectory;
   const auto histoDirStr = oHistoryDir.has_value() ? oHistoryDir.value().string() : "<none>";
-  return Configuration {oHistoryDir, loggingLevel, loggingPattern};
+  return Configuration {oHistoryDir, loggingLevel, loggingPattern, loggingOverflowPolicy,
+                        config.tracingFile, config.metricsFile,
+                        config.isSqlProfilingEnabled.value_or(false)};
 } // anonymous namespace
@@ -12,6 +12,10 @@ namespace ProgramConfiguration {
     std::optional<std::filesystem::path> historyDirectory;
     LoggingLevel loggingLevel;
     std::string loggingPattern;
+    LoggingOverflowPolicy loggingOverflowPolicy;
+    std::optional<std::filesystem::path> tracingFile;
+    std::optional<std::filesystem::path> metricsFile;
+    bool isSqlProfilingEnabled;
   };
 
   [[nodiscard]] Configuration readConfiguration(std::span<const char* const> args);
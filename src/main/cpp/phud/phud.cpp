@@ -1,11 +1,12 @@
 #include "db/Database.hpp" // std::span
-#include "entities/Site.hpp"
 #include "gui/Gui.hpp"
 #include "gui/HistoryService.hpp"
 #include "gui/TableService.hpp"
 #include "history/PokerSiteHistory.hpp"
 #include "language/limits.hpp" // toSizeT
 #include "log/Logger.hpp"      // CURRENT_FILE_NAME
+#include "log/Metrics.hpp"     // MetricsExporter
+#include "log/Tracer.hpp"      // Tracer
 #include "constants/ProgramInfos.hpp"
 #include "phud/ProgramConfiguration.hpp"
 #include "phud/ProgramArguments.hpp" // ProgramArgumentsException, UserAskedForHelpException
@@ -16,8 +17,10 @@
 
 #include <csignal> // std::signal(), SIG_DFL, SIGABRT
 #include <iostream>
+#include <optional>
 #include <print>
 #include <sstream> // std::ostringstream
+#include <tuple>   // std::ignore
 
 // TODO: padding: in a class, members must be ordered by type size, the biggest in
 //                1st position
@@ -47,6 +50,33 @@ static Logger& LOG() {
   return logger;
 }
 
+/**
+ * Records the spans while phud runs when a trace file is configured, and writes them on exit.
+ */
+struct [[nodiscard]] TracingConfig final {
+  std::optional<std::filesystem::path> m_oTraceFile;
+
+  explicit TracingConfig(const std::optional<std::filesystem::path>& oTraceFile)
+    : m_oTraceFile {oTraceFile} {
+    if (m_oTraceFile.has_value()) {
+      Tracer::start();
+    }
+  }
+
+  TracingConfig(const TracingConfig&) = delete;
+  TracingConfig(TracingConfig&&) = delete;
+  TracingConfig& operator=(const TracingConfig&) = delete;
+  TracingConfig& operator=(TracingConfig&&) = delete;
+
+  ~TracingConfig() {
+    if (m_oTraceFile.has_value()) {
+      std::ignore = Tracer::stop(m_oTraceFile.value());
+    }
+  }
+}; // struct TracingConfig
+
+static constexpr std::chrono::seconds METRICS_EXPORT_PERIOD {10};
+
 static void logErrorAndAbort(int signum) {
   std::signal(signum, SIG_DFL);
   std::ostringstream oss;
@@ -113,22 +143,35 @@ int main(int argc, const char* const* const argv) {
 #  pragma clang diagnostic pop
 #endif
 
-    const auto& [oHistoDir, loggingLevel,
-                 loggingPattern] {ProgramConfiguration::readConfiguration(args)};
-    LoggingConfig _(loggingPattern);
+    const auto& [oHistoDir, loggingLevel, loggingPattern, loggingOverflowPolicy, oTracingFile,
+                 oMetricsFile, isSqlProfilingEnabled] {
+        ProgramConfiguration::readConfiguration(args)};
+    LoggingConfig _(loggingPattern, loggingOverflowPolicy);
+    const TracingConfig tracingConfig {oTracingFile};
+    const auto pMetricsExporter {
+        oMetricsFile.has_value()
+            ? std::make_unique<MetricsExporter>(oMetricsFile.value(), METRICS_EXPORT_PERIOD)
+            : nullptr};
     Logger::setLoggingLevel(loggingLevel);
     std::signal(SIGSEGV, logErrorAndAbort);
     std::signal(SIGABRT, logErrorAndAbort);
     std::signal(SIGINT, logErrorAndAbort);
     LOG().info<"{} is starting">(ProgramInfos::APP_SHORT_NAME);
     Database db(ProgramInfos::DATABASE_NAME);
+
+    if (isSqlProfilingEnabled) {
+      db.enableSqlProfiling();
+    }
+
     TableService ts(db);
     HistoryService hs(db);
 
+    Gui gui(ts, hs);
+
     if (oHistoDir.has_value()) {
       if (const auto historyDir = oHistoDir.value(); PokerSiteHistory::isValidHistory(historyDir)) {
-        const auto site = PokerSiteHistory::load(historyDir);
-        db.save(*site);
+        // the GUI shows the stats already saved while the history is imported in the background
+        gui.importHistory(historyDir);
       } else {
         const auto strDir = oHistoDir.value().string();
         throw PhudException(
@@ -140,8 +183,12 @@ int main(int argc, const char* const* const argv) {
               toString(loggingLevel), loggingPattern, oHistoDir.value().string());
     }
 
-    Gui gui(ts, hs);
     nbErr = gui.run();
+
+    if (const auto nbDropped {Logger::getNbDroppedMessages()}; 0 < nbDropped) {
+      LOG().warn<"{} logging messages were dropped as the logging queue was full">(nbDropped);
+    }
+
     LOG().info<"{} is exiting">(ProgramInfos::APP_SHORT_NAME);
   } catch (const UserAskedForHelpException& e) {
     // if user asks for help, he passed -h in the command line
@@ -0,0 +1,477 @@
+#include "constants/ProgramInfos.hpp"       // APP_VERSION, WINAMAX_SITE_NAME
+#include "db/Database.hpp"                  // Database
+#include "entities/Game.hpp"                // CashGame, Tournament
+#include "entities/Hand.hpp"                // Hand
+#include "entities/Site.hpp"                // Site
+#include "filesystem/FileUtils.hpp"         // phud::filesystem::*
+#include "filesystem/TextFile.hpp"          // TextFile
+#include "history/PokerSiteHistory.hpp"     // PokerSiteHistory
+#include "history/WinamaxHandBuilder.hpp"   // WinamaxHandBuilder
+#include "history/WinamaxHandGenerator.hpp" // WinamaxHandGenerator
+#include "history/WinamaxHistory.hpp"       // WinamaxHistory
+#include "history/WinamaxHistoryStream.hpp" // WinamaxHistoryStream
+#include "log/Logger.hpp"                   // CURRENT_FILE_NAME, fmt::format
+#include "statistics/TableStatistics.hpp"   // TableStatistics
+#include "strings/StringUtils.hpp"          // phud::strings::*
+#include "threads/PlayerCache.hpp"          // PlayerCache
+#include "threads/ThreadSafeQueue.hpp"      // ThreadSafeQueue
+#include <algorithm>                        // std::ranges::sort
+#include <chrono>
+#include <fstream> // std::ofstream
+#include <numeric> // std::accumulate
+#include <optional>
+#include <ranges>
+#include <sstream> // std::istringstream
+#include <thread>  // std::jthread
+
+static Logger& LOG() {
+  static auto logger = Logger(CURRENT_FILE_NAME);
+  return logger;
+}
+
+namespace fs = std::filesystem;
+namespace pf = phud::filesystem;
+namespace ps = phud::strings;
+
+/*
+ * Measures the hot paths of phud on a given history directory, and writes the results in a JSON
+ * file, so that the figures of two releases can be compared. Each benchmark is run once to warm
+ * up, then the given number of times.
+ */
+namespace {
+  struct [[nodiscard]] MyLoggingConfig final {
+    MyLoggingConfig() { Logger::setupConsoleWarnLogging("%v"); }
+    ~MyLoggingConfig() { Logger::shutdownLogging(); }
+  }; // struct MyLoggingConfig
+
+  constexpr std::string_view OUTPUT_FLAG {"-o"};
+  constexpr std::string_view DB_HANDS_FLAG {"--db-hands"};
+  constexpr std::string_view REPETITIONS_FLAG {"--repetitions"};
+  constexpr std::string_view THREADS_FLAG {"--threads"};
+  constexpr std::string_view DEFAULT_OUTPUT_FILE {"phudBench.json"};
+  constexpr std::string_view DEFAULT_DB_HANDS {"10000,1000000,10000000"};
+  constexpr std::size_t DEFAULT_NB_REPETITIONS {5};
+  // the size of the batches saved by phud and dbgen
+  constexpr std::size_t NB_HANDS_PER_SAVE {1'000};
+  // the generated hands are played by this number of distinct groups of players
+  constexpr std::size_t NB_PLAYER_GROUPS {1'000};
+  constexpr std::size_t NB_PLAYER_CACHE_LOOKUPS_PER_THREAD {100'000};
+  constexpr std::size_t NB_PLAYER_CACHE_NAMES {1'000};
+  constexpr std::size_t NB_QUEUE_ITEMS {1'000'000};
+  constexpr std::string_view HAND_START {"Winamax Poker - "};
+
+  struct [[nodiscard]] Arguments final {
+    // Memory layout optimized: largest to smallest to minimize padding
+    fs::path m_historyDir {};
+    fs::path m_outputFile {DEFAULT_OUTPUT_FILE};
+    std::vector<std::size_t> m_dbSizes {};
+    std::size_t m_nbRepetitions = DEFAULT_NB_REPETITIONS;
+    std::size_t m_maxNbThreads = std::max(1U, std::thread::hardware_concurrency());
+  }; // struct Arguments
+
+  struct [[nodiscard]] BenchmarkResult final {
+    // Memory layout optimized: largest to smallest to minimize padding
+    std::string m_name {};
+    std::vector<std::chrono::nanoseconds> m_times {};
+    std::string_view m_unit {};
+    std::size_t m_nbOperations = 0; // done by each repetition
+  }; // struct BenchmarkResult
+
+  void printUsage(std::string_view programName) {
+    LOG().error<"{} -d <history directory> [{} <json file name>] [{} <n>[,<n>...]] "
+                "[{} <n>] [{} <n>]\n">(programName, OUTPUT_FLAG, DB_HANDS_FLAG, REPETITIONS_FLAG,
+                                       THREADS_FLAG);
+  }
+
+  [[nodiscard]] std::vector<std::size_t> toSizes(std::string_view commaSeparatedSizes) {
+    std::vector<std::size_t> ret;
+
+    for (const auto size : commaSeparatedSizes | std::views::split(',')) {
+      if (const auto n {ps::toSizeT(std::string_view(size.begin(), size.end()))}; 0 < n) {
+        ret.push_back(n);
+      }
+    }
+
+    return ret;
+  }
+
+  [[nodiscard]] std::optional<Arguments> getOptionalArguments(std::span<const char* const> args) {
+    Arguments ret {.m_dbSizes = toSizes(DEFAULT_DB_HANDS)};
+
+    // every option has a value
+    if (0 == args.size() % 2) {
+      LOG().error<"Wrong arguments.">();
+      printUsage(args[0]);
+      return {};
+    }
+
+    for (std::size_t i = 1; i < args.size(); i += 2) {
+      const std::string_view flag {args[i]};
+      const std::string_view value {args[i + 1]};
+
+      if ("-d" == flag) {
+        ret.m_historyDir = value;
+      } else if (OUTPUT_FLAG == flag) {
+        ret.m_outputFile = value;
+      } else if (DB_HANDS_FLAG == flag) {
+        ret.m_dbSizes = toSizes(value);
+      } else if (REPETITIONS_FLAG == flag) {
+        ret.m_nbRepetitions = std::max<std::size_t>(1, ps::toSizeT(value));
+      } else if (THREADS_FLAG == flag) {
+        ret.m_maxNbThreads = std::max<std::size_t>(1, ps::toSizeT(value));
+      } else {
+        LOG().error<"Unknown option '{}'.">(flag);
+        printUsage(args[0]);
+        return {};
+      }
+    }
+
+    if (!PokerSiteHistory::isValidHistory(ret.m_historyDir)) {
+      LOG().error<"'{}' is not a valid history directory">(ret.m_historyDir.string());
+      printUsage(args[0]);
+      return {};
+    }
+
+    return ret;
+  }
+
+  /**
+   * Runs the given function once to warm up, then the given number of times.
+   * @param f does the benchmarked operations and returns their number
+   */
+  template <typename F>
+  [[nodiscard]] BenchmarkResult run(std::string name, std::string_view unit,
+                                    std::size_t nbRepetitions, F f) {
+    BenchmarkResult ret {.m_name = std::move(name), .m_unit = unit, .m_nbOperations = f()};
+
+    for (std::size_t i = 0; i < nbRepetitions; ++i) {
+      const auto start {std::chrono::steady_clock::now()};
+      ret.m_nbOperations = f();
+      ret.m_times.push_back(std::chrono::steady_clock::now() - start);
+    }
+
+    return ret;
+  }
+
+  [[nodiscard]] bool isTournament(const fs::path& historyFile) {
+    return ps::contains(historyFile.stem().string(), '(');
+  }
+
+  [[nodiscard]] std::vector<fs::path> getHistoryFiles(const fs::path& historyDir) {
+    return pf::listTxtFilesInDir(historyDir / "history");
+  }
+
+  [[nodiscard]] fs::path getLargestFile(std::span<const fs::path> files) {
+    return *std::ranges::max_element(files, {}, [](const auto& f) { return fs::file_size(f); });
+  }
+
+  [[nodiscard]] BenchmarkResult benchmarkTextFile(std::span<const fs::path> files,
+                                                  std::size_t nbRepetitions) {
+    const auto file {getLargestFile(files)};
+    const auto content {pf::readToString(file)};
+    return run("TextFile::next", "line", nbRepetitions, [&] {
+      TextFile tf {file, content};
+      std::size_t nbLines = 0;
+
+      while (tf.next()) {
+        ++nbLines;
+      }
+
+      return nbLines;
+    });
+  }
+
+  template <typename GAME_TYPE>
+  [[nodiscard]] std::size_t buildHands(const fs::path& file, std::span<const std::string> hands) {
+    PlayerCache cache {ProgramInfos::WINAMAX_SITE_NAME};
+    std::size_t ret = 0;
+
+    for (const auto& hand : hands) {
+      TextFile tf {file, hand};
+      tf.next();
+      ret += nullptr == WinamaxHandBuilder::buildHand<GAME_TYPE>(tf, cache) ? 0 : 1;
+    }
+
+    return ret;
+  }
+
+  [[nodiscard]] BenchmarkResult benchmarkHandBuilder(std::span<const fs::path> files,
+                                                     std::size_t nbRepetitions) {
+    std::vector<std::pair<fs::path, std::vector<std::string>>> fileToHands;
+    std::ranges::transform(files, std::back_inserter(fileToHands), [](const auto& file) {
+      return std::make_pair(file, WinamaxHandGenerator::splitHands(pf::readToString(file)));
+    });
+    return run("WinamaxHandBuilder::buildHand", "hand", nbRepetitions, [&] {
+      std::size_t nbHands = 0;
+
+      for (const auto& [file, hands] : fileToHands) {
+        nbHands += isTournament(file) ? buildHands<Tournament>(file, hands)
+                                      : buildHands<CashGame>(file, hands);
+      }
+
+      return nbHands;
+    });
+  }
+
+  [[nodiscard]] BenchmarkResult benchmarkLoad(const fs::path& historyDir,
+                                              std::size_t nbRepetitions) {
+    const auto nbFiles {getHistoryFiles(historyDir).size()};
+    return run("WinamaxHistory::load", "file", nbRepetitions, [&] {
+      return nullptr == WinamaxHistory::load(historyDir) ? std::size_t {0} : nbFiles;
+    });
+  }
+
+  /**
+   * Fills a database with the given number of generated hands, saved by batches of
+   * NB_HANDS_PER_SAVE hands, and measures the save of each batch and the table statistics reads
+   * of the table of the last hand.
+   */
+  [[nodiscard]] std::vector<BenchmarkResult>
+  benchmarkDatabase(std::span<const std::string> hands, std::size_t nbHands,
+                    const fs::path& workDir, std::size_t nbRepetitions) {
+    const auto dbFile {workDir / fmt::format("phudBench_{}.db", nbHands)};
+    BenchmarkResult save {.m_name = fmt::format("Database::save ({} hands)", nbHands),
+                          .m_unit = "hand",
+                          .m_nbOperations = NB_HANDS_PER_SAVE};
+    std::string table;
+    {
+      Database db {dbFile.string()};
+      WinamaxHandGenerator generator {{.hands = hands,
+                                       .tableName = "",
+                                       .handIdPrefix = "",
+                                       .nbPlayerGroups = NB_PLAYER_GROUPS}};
+
+      for (std::size_t nbGeneratedHands = 0; nbGeneratedHands < nbHands;
+           nbGeneratedHands += NB_HANDS_PER_SAVE) {
+        std::string history;
+
+        for (std::size_t i = 0; i < std::min(NB_HANDS_PER_SAVE, nbHands - nbGeneratedHands); ++i) {
+          history.append(generator.next());
+        }
+
+        table = WinamaxHandGenerator::getTableName(history.substr(history.rfind(HAND_START)));
+        std::istringstream in {history};
+        // the whole history is one batch
+        (void)WinamaxHistoryStream::parse(in, NB_HANDS_PER_SAVE + 1, [&](Site& batch) {
+          const auto start {std::chrono::steady_clock::now()};
+          db.save(batch);
+          save.m_times.push_back(std::chrono::steady_clock::now() - start);
+        });
+      }
+    }
+    const Database db {dbFile.string()};
+    auto read {run(fmt::format("Database::readTableStatistics ({} hands)", nbHands), "read",
+                   nbRepetitions, [&] {
+                     return db.readTableStatistics(ProgramInfos::WINAMAX_SITE_NAME, table).isValid()
+                                ? std::size_t {1}
+                                : std::size_t {0};
+                   })};
+    return {std::move(save), std::move(read)};
+  }
+
+  // 1, 2, 4... maxNbThreads
+  [[nodiscard]] std::vector<std::size_t> getNbThreads(std::size_t maxNbThreads) {
+    std::vector<std::size_t> ret;
+
+    for (std::size_t n = 1; n < maxNbThreads; n *= 2) {
+      ret.push_back(n);
+    }
+
+    ret.push_back(maxNbThreads);
+    return ret;
+  }
+
+  [[nodiscard]] BenchmarkResult benchmarkPlayerCache(std::size_t nbThreads,
+                                                     std::size_t nbRepetitions) {
+    std::vector<std::string> names;
+
+    for (std::size_t i = 0; i < NB_PLAYER_CACHE_NAMES; ++i) {
+      names.push_back(fmt::format("player{}", i));
+    }
+
+    return run(fmt::format("PlayerCache::addIfMissing ({} threads)", nbThreads), "lookup",
+               nbRepetitions, [&] {
+                 const PlayerCache cache {ProgramInfos::WINAMAX_SITE_NAME};
+                 {
+                   std::vector<std::jthread> threads;
+
+                   for (std::size_t t = 0; t < nbThreads; ++t) {
+                     threads.emplace_back([&cache, &names, t] {
+                       for (std::size_t i = 0; i < NB_PLAYER_CACHE_LOOKUPS_PER_THREAD; ++i) {
+                         cache.addIfMissing(names[(i + t) % names.size()]);
+                       }
+                     });
+                   }
+                 } // the threads join here
+                 return nbThreads * NB_PLAYER_CACHE_LOOKUPS_PER_THREAD;
+               });
+  }
+
+  // as many producers as consumers
+  [[nodiscard]] BenchmarkResult benchmarkThreadSafeQueue(std::size_t nbThreadPairs,
+                                                         std::size_t nbRepetitions) {
+    return run(fmt::format("ThreadSafeQueue ({} producers, {} consumers)", nbThreadPairs,
+                           nbThreadPairs),
+               "item", nbRepetitions, [nbThreadPairs] {
+                 const auto nbItemsPerThread {NB_QUEUE_ITEMS / nbThreadPairs};
+                 ThreadSafeQueue<std::size_t> queue;
+                 {
+                   std::vector<std::jthread> threads;
+
+                   for (std::size_t t = 0; t < nbThreadPairs; ++t) {
+                     threads.emplace_back([&queue, nbItemsPerThread] {
+                       for (std::size_t i = 0; i < nbItemsPerThread; ++i) {
+                         queue.push(i);
+                       }
+                     });
+                     threads.emplace_back([&queue, nbItemsPerThread] {
+                       std::size_t item = 0;
+
+                       for (std::size_t i = 0; i < nbItemsPerThread; ++i) {
+                         queue.waitPop(item);
+                       }
+                     });
+                   }
+                 } // the threads join here
+                 return nbItemsPerThread * nbThreadPairs;
+               });
+  }
+
+  struct [[nodiscard]] Statistics final {
+    double m_minNs;
+    double m_medianNs;
+    double m_meanNs;
+    double m_maxNs;
+    double m_nsPerOperation;
+    double m_operationsPerSecond;
+  }; // struct Statistics
+
+  [[nodiscard]] double toNanoseconds(std::chrono::nanoseconds d) noexcept {
+    return static_cast<double>(d.count());
+  }
+
+  // the median repetition gives the figures per operation, as it is the least noisy
+  [[nodiscard]] Statistics getStatistics(const BenchmarkResult& result) {
+    auto times {result.m_times};
+
+    if (times.empty()) {
+      return {};
+    }
+
+    std::ranges::sort(times);
+    const auto median {toNanoseconds(times[times.size() / 2])};
+    const auto nbOperations {static_cast<double>(std::max<std::size_t>(1, result.m_nbOperations))};
+    return {.m_minNs = toNanoseconds(times.front()),
+            .m_medianNs = median,
+            .m_meanNs = toNanoseconds(std::accumulate(times.begin(), times.end(),
+                                                      std::chrono::nanoseconds())) /
+                        static_cast<double>(times.size()),
+            .m_maxNs = toNanoseconds(times.back()),
+            .m_nsPerOperation = median / nbOperations,
+            .m_operationsPerSecond = 0.0 < median ? 1e9 * nbOperations / median : 0.0};
+  }
+
+  [[nodiscard]] std::string toJson(const BenchmarkResult& result) {
+    const auto stats {getStatistics(result)};
+    return fmt::format(
+        R"(    {{"name": "{}", "unit": "{}", "operations": {}, "repetitions": {}, )"
+        R"("minNs": {:.0f}, "medianNs": {:.0f}, "meanNs": {:.0f}, "maxNs": {:.0f}, )"
+        R"("nsPerOperation": {:.3f}, "operationsPerSecond": {:.1f}}})",
+        result.m_name, result.m_unit, result.m_nbOperations, result.m_times.size(), stats.m_minNs,
+        stats.m_medianNs, stats.m_meanNs, stats.m_maxNs, stats.m_nsPerOperation,
+        stats.m_operationsPerSecond);
+  }
+
+  [[nodiscard]] std::string toString(const BenchmarkResult& result) {
+    const auto stats {getStatistics(result)};
+    return fmt::format("{:<56} {:>14.1f} ns/{:<6} {:>14.0f} {}/s", result.m_name,
+                       stats.m_nsPerOperation, result.m_unit, stats.m_operationsPerSecond,
+                       result.m_unit);
+  }
+
+  [[nodiscard]] bool writeJson(const fs::path& jsonFile, const Arguments& arguments,
+                               std::span<const BenchmarkResult> results) {
+    std::ofstream os {jsonFile, std::ios::trunc};
+    os << fmt::format("{{\n  \"version\": \"{}\",\n  \"hardwareConcurrency\": {},\n"
+                      "  \"repetitions\": {},\n  \"benchmarks\": [\n",
+                      ProgramInfos::APP_VERSION, std::thread::hardware_concurrency(),
+                      arguments.m_nbRepetitions);
+
+    for (std::size_t i = 0; i < results.size(); ++i) {
+      os << toJson(results[i]) << (i + 1 < results.size() ? ",\n" : "\n");
+    }
+
+    os << "  ]\n}\n";
+    os.flush();
+
+    if (!os) {
+      LOG().error<"Couldn't write the benchmark file {}">(jsonFile.string());
+      return false;
+    }
+
+    return true;
+  }
+
+  [[nodiscard]] std::vector<BenchmarkResult> benchmark(const Arguments& arguments,
+                                                       const fs::path& workDir) {
+    const auto files {getHistoryFiles(arguments.m_historyDir)};
+    const auto nbRepetitions {arguments.m_nbRepetitions};
+    std::vector<BenchmarkResult> ret;
+    ret.push_back(benchmarkTextFile(files, nbRepetitions));
+    ret.push_back(benchmarkHandBuilder(files, nbRepetitions));
+    ret.push_back(benchmarkLoad(arguments.m_historyDir, nbRepetitions));
+    const auto hands {WinamaxHandGenerator::splitHands(pf::readToString(getLargestFile(files)))};
+
+    for (const auto nbHands : arguments.m_dbSizes) {
+      std::ranges::move(benchmarkDatabase(hands, nbHands, workDir, nbRepetitions),
+                        std::back_inserter(ret));
+    }
+
+    for (const auto nbThreads : getNbThreads(arguments.m_maxNbThreads)) {
+      ret.push_back(benchmarkPlayerCache(nbThreads, nbRepetitions));
+    }
+
+    // a producer and a consumer per pair of threads
+    const auto maxNbThreadPairs {std::max<std::size_t>(1, arguments.m_maxNbThreads / 2)};
+
+    for (const auto nbThreadPairs : getNbThreads(maxNbThreadPairs)) {
+      ret.push_back(benchmarkThreadSafeQueue(nbThreadPairs, nbRepetitions));
+    }
+
+    return ret;
+  }
+} // anonymous namespace
+
+int main(int argc, const char* const argv[]) {
+  std::setlocale(LC_ALL, "en_US.utf8");
+  MyLoggingConfig _;
+
+#ifdef __clang__
+#  pragma clang diagnostic push
+#  pragma clang diagnostic ignored "-Wunsafe-buffer-usage"
+#endif
+
+  const std::span args = {argv, argv + argc};
+
+#ifdef __clang__
+#  pragma clang diagnostic pop
+#endif
+
+  const auto oArguments {getOptionalArguments(args)};
+
+  if (!oArguments.has_value()) {
+    return 1;
+  }
+
+  const auto workDir {fs::temp_directory_path() / "phudBench"};
+  fs::remove_all(workDir);
+  fs::create_directories(workDir);
+  const auto results {benchmark(oArguments.value(), workDir)};
+  fs::remove_all(workDir);
+
+  for (const auto& result : results) {
+    LOG().warn<"{}">(toString(result));
+  }
+
+  return writeJson(oArguments.value().m_outputFile, oArguments.value(), results) ? 0 : 1;
+}
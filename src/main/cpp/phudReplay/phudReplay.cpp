@@ -0,0 +1,497 @@
+#include "db/Database.hpp"                  // Database
+#include "filesystem/DirWatcher.hpp"        // DirWatcher
+#include "filesystem/FileUtils.hpp"         // phud::filesystem::*
+#include "gui/HudLatency.hpp"               // HudLatency, ReloadTrace
+#include "gui/TableService.hpp"             // TableService
+#include "history/PokerSiteHistory.hpp"     // PokerSiteHistory
+#include "history/WinamaxHandGenerator.hpp" // WinamaxHandGenerator
+#include "history/WinamaxHistory.hpp"       // WinamaxHistory
+#include "history/WinamaxHistoryStream.hpp" // WinamaxHistoryStream
+#include "log/Logger.hpp"                   // CURRENT_FILE_NAME, fmt::format
+#include "log/Metrics.hpp"                  // Metrics
+#include "statistics/TableStatistics.hpp"   // TableStatistics
+#include "strings/StringUtils.hpp"          // phud::strings::*
+#include <algorithm>                        // std::ranges::sort
+#include <atomic>
+#include <chrono>
+#include <condition_variable> // std::condition_variable_any
+#include <deque>
+#include <fstream> // std::ofstream
+#include <mutex>
+#include <optional>
+#include <random> // std::mt19937
+#include <ranges>
+#include <thread> // std::jthread
+
+static Logger& LOG() {
+  static auto logger = Logger(CURRENT_FILE_NAME);
+  return logger;
+}
+
+namespace fs = std::filesystem;
+namespace pf = phud::filesystem;
+namespace ps = phud::strings;
+
+/*
+ * Replays a multi-table session: the hands of a history directory are appended to the history
+ * files of N tables of a temporary directory at a given rate, the way the Winamax client writes
+ * them, sometimes in two chunks. The TableService watches each table, reloads its file, saves the
+ * hands and reads the statistics, as phud does. The delay from each hand written to the HUD
+ * notification is measured, and the throughput and latency percentiles are reported.
+ */
+namespace {
+  struct [[nodiscard]] MyLoggingConfig final {
+    MyLoggingConfig() { Logger::setupConsoleWarnLogging("%v"); }
+    ~MyLoggingConfig() { Logger::shutdownLogging(); }
+  }; // struct MyLoggingConfig
+
+  constexpr std::string_view OUTPUT_FLAG {"-o"};
+  constexpr std::string_view TABLES_FLAG {"--tables"};
+  constexpr std::string_view RATE_FLAG {"--hands-per-minute"};
+  constexpr std::string_view DURATION_FLAG {"--duration"};
+  constexpr std::string_view PARTIAL_WRITES_FLAG {"--partial-writes"};
+  constexpr std::string_view COALESCING_WINDOW_FLAG {"--coalescing-window"};
+  constexpr std::size_t DEFAULT_NB_TABLES {12};
+  constexpr std::size_t DEFAULT_HANDS_PER_MINUTE {6};
+  constexpr std::size_t DEFAULT_DURATION_IN_SECONDS {60};
+  constexpr std::size_t DEFAULT_PARTIAL_WRITES_PERCENT {50};
+  // the delay between the two chunks of a hand written in two parts
+  constexpr std::chrono::milliseconds PARTIAL_WRITE_PAUSE {50};
+  // once the replay is over, the time left to the last reloads
+  constexpr std::chrono::seconds DRAIN_TIMEOUT {10};
+  // the generated hands are played by this number of distinct groups of players
+  constexpr std::size_t NB_PLAYER_GROUPS {100};
+  constexpr std::array PERCENTILES {50.0, 90.0, 99.0, 100.0};
+
+  struct [[nodiscard]] Arguments final {
+    // Memory layout optimized: largest to smallest to minimize padding
+    fs::path m_historyDir {};
+    fs::path m_outputFile {};
+    std::chrono::milliseconds m_coalescingWindow {TableService::DEFAULT_COALESCING_WINDOW};
+    std::size_t m_nbTables = DEFAULT_NB_TABLES;
+    std::size_t m_handsPerMinute = DEFAULT_HANDS_PER_MINUTE;
+    std::size_t m_durationInSeconds = DEFAULT_DURATION_IN_SECONDS;
+    std::size_t m_partialWritesPercent = DEFAULT_PARTIAL_WRITES_PERCENT;
+  }; // struct Arguments
+
+  void printUsage(std::string_view programName) {
+    LOG().error<"{} -d <history directory> [{} <n>] [{} <n>] [{} <seconds>] [{} <percent>] "
+                "[{} <ms>] [{} <json file name>]\n">(programName, TABLES_FLAG, RATE_FLAG,
+                                                     DURATION_FLAG, PARTIAL_WRITES_FLAG,
+                                                     COALESCING_WINDOW_FLAG, OUTPUT_FLAG);
+  }
+
+  [[nodiscard]] std::optional<Arguments> getOptionalArguments(std::span<const char* const> args) {
+    Arguments ret;
+
+    // every option has a value
+    if (0 == args.size() % 2) {
+      LOG().error<"Wrong arguments.">();
+      printUsage(args[0]);
+      return {};
+    }
+
+    for (std::size_t i = 1; i < args.size(); i += 2) {
+      const std::string_view flag {args[i]};
+      const std::string_view value {args[i + 1]};
+
+      if ("-d" == flag) {
+        ret.m_historyDir = value;
+      } else if (OUTPUT_FLAG == flag) {
+        ret.m_outputFile = value;
+      } else if (TABLES_FLAG == flag) {
+        ret.m_nbTables = std::max<std::size_t>(1, ps::toSizeT(value));
+      } else if (RATE_FLAG == flag) {
+        ret.m_handsPerMinute = std::max<std::size_t>(1, ps::toSizeT(value));
+      } else if (DURATION_FLAG == flag) {
+        ret.m_durationInSeconds = std::max<std::size_t>(1, ps::toSizeT(value));
+      } else if (PARTIAL_WRITES_FLAG == flag) {
+        ret.m_partialWritesPercent = std::min<std::size_t>(100, ps::toSizeT(value));
+      } else if (COALESCING_WINDOW_FLAG == flag) {
+        ret.m_coalescingWindow = std::chrono::milliseconds(ps::toSizeT(value));
+      } else {
+        LOG().error<"Unknown option '{}'.">(flag);
+        printUsage(args[0]);
+        return {};
+      }
+    }
+
+    if (!PokerSiteHistory::isValidHistory(ret.m_historyDir)) {
+      LOG().error<"'{}' is not a valid history directory">(ret.m_historyDir.string());
+      printUsage(args[0]);
+      return {};
+    }
+
+    return ret;
+  }
+
+  // the table of a tournament hand can't be renamed, so only the cash games are replayed
+  [[nodiscard]] std::vector<std::string> getCashGameHands(const fs::path& historyDir) {
+    std::vector<std::string> ret;
+
+    for (const auto& file : pf::listTxtFilesInDir(historyDir / "history")) {
+      if (!ps::contains(file.stem().string(), '(')) {
+        std::ranges::move(WinamaxHandGenerator::splitHands(pf::readToString(file)),
+                          std::back_inserter(ret));
+      }
+    }
+
+    return ret;
+  }
+
+  // the file Winamax would write the given hand in
+  [[nodiscard]] fs::path getHistoryFile(const fs::path& historyDir, std::string_view hand) {
+    const auto firstLineEnd {hand.find('\n')};
+    const auto tableLine {hand.substr(firstLineEnd + 1)};
+    const auto oStem {WinamaxHistoryStream::toFileStem(hand.substr(0, firstLineEnd),
+                                                       tableLine.substr(0, tableLine.find('\n')))};
+    return historyDir / "history" / fmt::format("{}.txt", oStem.value_or("unknown"));
+  }
+
+  void append(const fs::path& file, std::string_view s) {
+    std::ofstream os {file, std::ios::app | std::ios::binary};
+    os << s;
+  }
+
+  // the client writes the actions first, then the summary
+  [[nodiscard]] std::size_t getPartialWriteSize(std::string_view hand) {
+    const auto pos {hand.find("*** SUMMARY ***")};
+    return std::string_view::npos == pos ? hand.size() / 2 : pos;
+  }
+
+  [[nodiscard]] std::chrono::nanoseconds
+  getPercentile(std::span<const std::chrono::nanoseconds> sortedDurations, double percentile) {
+    if (sortedDurations.empty()) {
+      return {};
+    }
+
+    const auto nb {sortedDurations.size()};
+    const auto rank {static_cast<std::size_t>(percentile / 100.0 * static_cast<double>(nb))};
+    return sortedDurations[std::min(rank, nb - 1)];
+  }
+
+  [[nodiscard]] double toMillis(std::chrono::nanoseconds d) noexcept {
+    return std::chrono::duration<double, std::milli>(d).count();
+  }
+
+  /**
+   * The hands written at a table and their latencies. A hand is considered displayed by the first
+   * HUD notification following its complete write, so a notification of a reload started before
+   * the end of the write can make the latency look a bit shorter. Thread safe.
+   */
+  class [[nodiscard]] ReplayedTable final {
+  private:
+    // Memory layout optimized: largest to smallest to minimize padding
+    std::deque<std::chrono::steady_clock::time_point> m_pendingHands {};
+    std::vector<std::chrono::nanoseconds> m_latencies {};
+    std::string m_name;
+    fs::path m_file;
+    std::mutex m_mutex {};
+    std::size_t m_nbWrittenHands = 0;
+    std::size_t m_nbPartialWrites = 0;
+    std::size_t m_nbNotifications = 0;
+
+  public:
+    explicit ReplayedTable(std::string_view name, fs::path file)
+      : m_name {name},
+        m_file {std::move(file)} {}
+
+    [[nodiscard]] std::string_view getName() const noexcept { return m_name; }
+    [[nodiscard]] const fs::path& getFile() const noexcept { return m_file; }
+
+    void write(std::string_view hand, bool isPartial) {
+      if (isPartial) {
+        const auto size {getPartialWriteSize(hand)};
+        append(m_file, hand.substr(0, size));
+        std::this_thread::sleep_for(PARTIAL_WRITE_PAUSE);
+        append(m_file, hand.substr(size));
+      } else {
+        append(m_file, hand);
+      }
+
+      const std::scoped_lock lock {m_mutex};
+      m_pendingHands.push_back(std::chrono::steady_clock::now());
+      ++m_nbWrittenHands;
+      m_nbPartialWrites += isPartial ? 1 : 0;
+    }
+
+    void notified() {
+      const auto now {std::chrono::steady_clock::now()};
+      const std::scoped_lock lock {m_mutex};
+      ++m_nbNotifications;
+
+      for (; !m_pendingHands.empty(); m_pendingHands.pop_front()) {
+        m_latencies.push_back(now - m_pendingHands.front());
+      }
+    }
+
+    [[nodiscard]] bool hasPendingHands() {
+      const std::scoped_lock lock {m_mutex};
+      return !m_pendingHands.empty();
+    }
+
+    template <typename F>
+    auto withLock(F f) {
+      const std::scoped_lock lock {m_mutex};
+      return f(m_latencies, m_nbWrittenHands, m_nbPartialWrites, m_nbNotifications);
+    }
+  }; // class ReplayedTable
+
+  /**
+   * Writes a hand every interval, the tables being shifted so that they don't write at once.
+   */
+  void replay(std::stop_token stopToken, ReplayedTable& table, WinamaxHandGenerator& generator,
+              const Arguments& arguments, std::size_t tableIndex) {
+    const auto interval {std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::minutes(1)) /
+                         arguments.m_handsPerMinute};
+    auto deadline {std::chrono::steady_clock::now() +
+                   interval * static_cast<long>(tableIndex + 1) /
+                       static_cast<long>(arguments.m_nbTables)};
+    // the same partial writes from one run to another
+    std::mt19937 random {static_cast<std::mt19937::result_type>(tableIndex)};
+    std::uniform_int_distribution<std::size_t> percent {0, 99};
+    std::condition_variable_any cv;
+    std::mutex mutex;
+    std::unique_lock lock {mutex};
+
+    while (!cv.wait_until(lock, stopToken, deadline, [] { return false; }) and
+           !stopToken.stop_requested()) {
+      table.write(generator.next(), percent(random) < arguments.m_partialWritesPercent);
+      deadline += interval;
+    }
+  }
+
+  struct [[nodiscard]] ReplayReport final {
+    // Memory layout optimized: largest to smallest to minimize padding
+    std::vector<std::chrono::nanoseconds> m_latencies {};
+    std::chrono::steady_clock::duration m_duration {};
+    std::chrono::nanoseconds m_worstTableP99 {};
+    std::string m_worstTable {};
+    std::size_t m_nbTables = 0;
+    std::size_t m_nbWrittenHands = 0;
+    std::size_t m_nbPartialWrites = 0;
+    std::size_t m_nbNotifications = 0;
+    std::size_t m_nbFileEvents = 0;
+    std::size_t m_nbReloads = 0;
+
+    [[nodiscard]] double perSecond(std::size_t n) const {
+      const auto seconds {std::chrono::duration<double>(m_duration).count()};
+      return 0.0 < seconds ? static_cast<double>(n) / seconds : 0.0;
+    }
+
+    [[nodiscard]] double perHand(std::size_t n) const {
+      return 0 == m_nbWrittenHands ? 0.0
+                                   : static_cast<double>(n) / static_cast<double>(m_nbWrittenHands);
+    }
+
+    [[nodiscard]] std::size_t getNbUndisplayedHands() const noexcept {
+      return m_nbWrittenHands - m_latencies.size();
+    }
+
+    [[nodiscard]] bool isWithinTarget() const {
+      return 0 == getNbUndisplayedHands() and
+             getPercentile(m_latencies, 99.0) <= HudLatency::TARGET;
+    }
+  }; // struct ReplayReport
+
+  [[nodiscard]] ReplayReport
+  newReport(std::span<const std::unique_ptr<ReplayedTable>> tables,
+            std::chrono::steady_clock::duration duration, std::size_t nbFileEvents) {
+    ReplayReport ret {.m_duration = duration,
+                      .m_nbTables = tables.size(),
+                      .m_nbFileEvents = nbFileEvents,
+                      .m_nbReloads = Metrics::getNbHistoryFileReloads().get()};
+
+    for (const auto& pTable : tables) {
+      pTable->withLock([&](auto latencies, std::size_t nbWrittenHands, std::size_t nbPartialWrites,
+                           std::size_t nbNotifications) {
+        std::ranges::sort(latencies);
+        ret.m_latencies.insert(ret.m_latencies.end(), latencies.begin(), latencies.end());
+        ret.m_nbWrittenHands += nbWrittenHands;
+        ret.m_nbPartialWrites += nbPartialWrites;
+        ret.m_nbNotifications += nbNotifications;
+
+        if (const auto p99 {getPercentile(latencies, 99.0)}; ret.m_worstTableP99 <= p99) {
+          ret.m_worstTableP99 = p99;
+          ret.m_worstTable = pTable->getName();
+        }
+      });
+    }
+
+    std::ranges::sort(ret.m_latencies);
+    return ret;
+  }
+
+  [[nodiscard]] std::string toString(const ReplayReport& report) {
+    std::string ret;
+    auto out {std::back_inserter(ret)};
+    fmt::format_to(out, "{} tables, {} hands written ({} in two parts) in {:.1f} s: ",
+                   report.m_nbTables, report.m_nbWrittenHands, report.m_nbPartialWrites,
+                   std::chrono::duration<double>(report.m_duration).count());
+    fmt::format_to(out,
+                   "{:.1f} hands/s, {:.1f} HUD updates/s, {:.1f} file events/hand, "
+                   "{:.2f} reloads/hand\n",
+                   report.perSecond(report.m_nbWrittenHands),
+                   report.perSecond(report.m_nbNotifications), report.perHand(report.m_nbFileEvents),
+                   report.perHand(report.m_nbReloads));
+    fmt::format_to(out, "hand written -> HUD updated:");
+
+    for (const auto percentile : PERCENTILES) {
+      fmt::format_to(out, " p{:.0f} {:.1f} ms", percentile,
+                     toMillis(getPercentile(report.m_latencies, percentile)));
+    }
+
+    fmt::format_to(out, "\nworst table: '{}', p99 {:.1f} ms\n", report.m_worstTable,
+                   toMillis(report.m_worstTableP99));
+    fmt::format_to(out, "{} hands not displayed, {} the {} ms target\n",
+                   report.getNbUndisplayedHands(), report.isWithinTarget() ? "within" : "BREAKING",
+                   HudLatency::TARGET.count());
+
+    for (const auto& reload : HudLatency::getSlowestRecentReloads(3)) {
+      fmt::format_to(out, "slow {}\n", reload.toString());
+    }
+
+    return ret;
+  }
+
+  [[nodiscard]] bool writeJson(const fs::path& jsonFile, const ReplayReport& report) {
+    std::ofstream os {jsonFile, std::ios::trunc};
+    os << fmt::format("{{\n  \"tables\": {},\n  \"writtenHands\": {},\n  \"partialWrites\": {},\n"
+                      "  \"hudUpdates\": {},\n  \"fileEvents\": {},\n  \"reloads\": {},\n"
+                      "  \"undisplayedHands\": {},\n"
+                      "  \"durationS\": {:.3f},\n  \"handsPerSecond\": {:.3f},\n"
+                      "  \"hudUpdatesPerSecond\": {:.3f},\n",
+                      report.m_nbTables, report.m_nbWrittenHands, report.m_nbPartialWrites,
+                      report.m_nbNotifications, report.m_nbFileEvents, report.m_nbReloads,
+                      report.getNbUndisplayedHands(),
+                      std::chrono::duration<double>(report.m_duration).count(),
+                      report.perSecond(report.m_nbWrittenHands),
+                      report.perSecond(report.m_nbNotifications));
+
+    for (const auto percentile : PERCENTILES) {
+      os << fmt::format("  \"latencyP{:.0f}Ms\": {:.3f},\n", percentile,
+                        toMillis(getPercentile(report.m_latencies, percentile)));
+    }
+
+    os << fmt::format("  \"worstTableP99Ms\": {:.3f},\n  \"withinTarget\": {}\n}}\n",
+                      toMillis(report.m_worstTableP99), report.isWithinTarget());
+    os.flush();
+
+    if (!os) {
+      LOG().error<"Couldn't write the replay report file {}">(jsonFile.string());
+      return false;
+    }
+
+    return true;
+  }
+
+  [[nodiscard]] ReplayReport runReplay(const Arguments& arguments, const fs::path& workDir) {
+    const auto hands {getCashGameHands(arguments.m_historyDir)};
+
+    if (hands.empty()) {
+      LOG().error<"No cash game hand in '{}'">(arguments.m_historyDir.string());
+      return {};
+    }
+
+    std::vector<std::unique_ptr<WinamaxHandGenerator>> generators;
+    std::vector<std::unique_ptr<ReplayedTable>> tables;
+
+    // the first hand of each table is written before the TableService looks for its file
+    for (std::size_t i = 0; i < arguments.m_nbTables; ++i) {
+      const auto tableName {fmt::format("Replay {}", i + 1)};
+      const auto handIdPrefix {fmt::format("{}-", i + 1)};
+      auto pGenerator {std::make_unique<WinamaxHandGenerator>(
+          WinamaxHandGenerator::Params {.hands = hands,
+                                        .tableName = tableName,
+                                        .handIdPrefix = handIdPrefix,
+                                        .nbPlayerGroups = NB_PLAYER_GROUPS})};
+      const auto firstHand {pGenerator->next()};
+      const auto file {getHistoryFile(workDir, firstHand)};
+      append(file, firstHand);
+      tables.push_back(std::make_unique<ReplayedTable>(tableName, file));
+      generators.push_back(std::move(pGenerator));
+    }
+
+    Database db {(workDir / "phudReplay.db").string()};
+    std::atomic<std::size_t> nbFileEvents {0};
+    const auto pDirWatcher {DirWatcher::create(workDir / "history")};
+    pDirWatcher->start([&nbFileEvents](const fs::path&) { ++nbFileEvents; });
+    // one service monitors all the tables, as in the GUI
+    TableService service {db};
+    service.setPokerSiteHistory(std::make_shared<WinamaxHistory>());
+    service.setHistoryDir(workDir);
+    service.setCoalescingWindow(arguments.m_coalescingWindow);
+
+    for (const auto& pTable : tables) {
+      const auto title {fmt::format("Winamax {} / 0,01-0,02 NL Holdem", pTable->getName())};
+
+      if (const auto error {service.startProducingStats(
+              title, [&table = *pTable](TableStatistics&&) { table.notified(); })};
+          !error.empty()) {
+        LOG().error<"{}">(error);
+      }
+    }
+
+    LOG().warn<"Replaying {} tables at {} hands/min each for {} s in {}">(
+        arguments.m_nbTables, arguments.m_handsPerMinute, arguments.m_durationInSeconds,
+        workDir.string());
+    const auto start {std::chrono::steady_clock::now()};
+    {
+      std::vector<std::jthread> writers;
+
+      for (std::size_t i = 0; i < tables.size(); ++i) {
+        writers.emplace_back(replay, std::ref(*tables[i]), std::ref(*generators[i]),
+                             std::cref(arguments), i);
+      }
+
+      std::this_thread::sleep_for(std::chrono::seconds(arguments.m_durationInSeconds));
+    } // the writers stop and join here
+    const auto duration {std::chrono::steady_clock::now() - start};
+
+    for (const auto drainEnd {std::chrono::steady_clock::now() + DRAIN_TIMEOUT};
+         std::chrono::steady_clock::now() < drainEnd and
+         std::ranges::any_of(tables, [](const auto& pTable) { return pTable->hasPendingHands(); });
+         std::this_thread::sleep_for(std::chrono::milliseconds(100))) {}
+
+    service.stopProducingStats();
+    pDirWatcher->stop();
+    return newReport(tables, duration, nbFileEvents.load());
+  }
+} // anonymous namespace
+
+int main(int argc, const char* const argv[]) {
+  std::setlocale(LC_ALL, "en_US.utf8");
+  MyLoggingConfig _;
+
+#ifdef __clang__
+#  pragma clang diagnostic push
+#  pragma clang diagnostic ignored "-Wunsafe-buffer-usage"
+#endif
+
+  const std::span args = {argv, argv + argc};
+
+#ifdef __clang__
+#  pragma clang diagnostic pop
+#endif
+
+  const auto oArguments {getOptionalArguments(args)};
+
+  if (!oArguments.has_value()) {
+    return 1;
+  }
+
+  const auto workDir {fs::temp_directory_path() / "phudReplay"};
+  fs::remove_all(workDir);
+  fs::create_directories(workDir / "history");
+  const auto report {runReplay(oArguments.value(), workDir)};
+  fs::remove_all(workDir);
+  LOG().warn<"{}">(toString(report));
+
+  if (const auto& jsonFile {oArguments.value().m_outputFile};
+      !jsonFile.empty() and !writeJson(jsonFile, report)) {
+    return 1;
+  }
+
+  return report.isWithinTarget() ? 0 : 2;
+}
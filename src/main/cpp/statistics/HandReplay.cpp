@@ -0,0 +1,349 @@
+#include "entities/Action.hpp"         // Action, ActionType, Street
+#include "entities/Hand.hpp"           // Hand
+#include "entities/Seat.hpp"           // Seat
+#include "statistics/HandReplay.hpp"   // HandReplay, HandStore, StatCounters
+#include <algorithm>                   // std::ranges::find, std::ranges::transform
+#include <cstddef>                     // std::size_t
+
+namespace {
+  constexpr auto NO_SEAT {TableConstants::MAX_SEATS};
+
+  // the statistics about the continuation bet of a postflop street
+  struct [[nodiscard]] ContinuationBetStats final {
+    Stat m_bet;
+    Stat m_foldTo;
+    Stat m_call;
+    Stat m_raise;
+    Stat m_foldToRaise;
+  }; // struct ContinuationBetStats
+
+  // indexed by the postflop street
+  constexpr std::array CONTINUATION_BET_STATS {
+      ContinuationBetStats {Stat::flopContinuationBet, Stat::foldToFlopContinuationBet,
+                            Stat::callFlopContinuationBet, Stat::raiseAfterFlopContinuationBet,
+                            Stat::foldToRaiseAfterFlopContinuationBet},
+      ContinuationBetStats {Stat::turnContinuationBet, Stat::foldToTurnContinuationBet,
+                            Stat::callTurnContinuationBet, Stat::raiseAfterTurnContinuationBet,
+                            Stat::foldToRaiseAfterTurnContinuationBet},
+      ContinuationBetStats {Stat::riverContinuationBet, Stat::foldToRiverContinuationBet,
+                            Stat::callRiverContinuationBet, Stat::raiseAfterRiverContinuationBet,
+                            Stat::foldToRaiseAfterRiverContinuationBet}};
+
+  [[nodiscard]] constexpr std::size_t toIndex(Stat stat) noexcept {
+    return static_cast<std::size_t>(stat);
+  }
+
+  [[nodiscard]] constexpr bool isStealPosition(TablePosition position) noexcept {
+    return TablePosition::cutOff == position or TablePosition::button == position or
+           TablePosition::smallBlind == position;
+  }
+
+  [[nodiscard]] constexpr bool isBlind(TablePosition position) noexcept {
+    return TablePosition::smallBlind == position or TablePosition::bigBlind == position;
+  }
+
+  /**
+   * The state of a hand being replayed, updated by each action in a single pass.
+   */
+  class [[nodiscard]] Replayer final {
+  private:
+    // Memory layout optimized: largest to smallest to minimize padding
+    HandReplay::SeatCounters m_counters {};
+    std::size_t m_previousAggressor = NO_SEAT; // the aggressor of the previous street
+    std::size_t m_aggressor = NO_SEAT;         // the aggressor of the current street
+    std::size_t m_openRaiser = NO_SEAT;        // the first preflop raiser
+    std::size_t m_firstBettor = NO_SEAT;       // the first bettor of the current street
+    std::size_t m_continuationBettor = NO_SEAT;
+    std::size_t m_donkBettor = NO_SEAT;
+    std::size_t m_checkRaiser = NO_SEAT;
+    std::size_t m_stealer = NO_SEAT; // the steal attempt nobody called or raised yet
+    int m_nbRaises = 0;              // the number of bets and raises on the current street
+    tablePosition::SeatPositions m_positions;
+    std::array<bool, TableConstants::MAX_SEATS> m_isInHand {};
+    std::array<bool, TableConstants::MAX_SEATS> m_hasFolded {};
+    std::array<bool, TableConstants::MAX_SEATS> m_hasSeenFlop {};
+    std::array<bool, TableConstants::MAX_SEATS> m_hasActed {};   // on the current street
+    std::array<bool, TableConstants::MAX_SEATS> m_hasChecked {}; // on the current street
+    Street m_street = Street::preflop;
+    bool m_isFoldedTo = true; // no preflop call or raise yet
+
+    // counts the 1st opportunity of the hand only
+    void count(std::size_t seat, Stat stat, bool hasOccurred) noexcept {
+      auto& counters {m_counters[seat]};
+
+      if (0 == counters.m_nbOpportunities[toIndex(stat)]) {
+        counters.m_nbOpportunities[toIndex(stat)] = 1;
+        counters.m_nbOccurrences[toIndex(stat)] = hasOccurred ? 1 : 0;
+      }
+    }
+
+    // counts one opportunity per hand, which occurred if any action of the hand made it occur
+    void countAny(std::size_t seat, Stat stat, bool hasOccurred) noexcept {
+      auto& counters {m_counters[seat]};
+      counters.m_nbOpportunities[toIndex(stat)] = 1;
+
+      if (hasOccurred) {
+        counters.m_nbOccurrences[toIndex(stat)] = 1;
+      }
+    }
+
+    void startStreet(Street street) noexcept {
+      const auto hasAggressor {NO_SEAT != m_aggressor and !m_hasFolded[m_aggressor]};
+      m_previousAggressor = hasAggressor ? m_aggressor : NO_SEAT;
+      m_aggressor = NO_SEAT;
+      m_firstBettor = NO_SEAT;
+      m_continuationBettor = NO_SEAT;
+      m_donkBettor = NO_SEAT;
+      m_checkRaiser = NO_SEAT;
+      m_nbRaises = 0;
+      m_hasActed.fill(false);
+      m_hasChecked.fill(false);
+      m_street = street;
+    }
+
+    void onPreflopAction(std::size_t seat, ActionType type, bool isAggressive) noexcept {
+      countAny(seat, Stat::voluntaryPutMoneyInPot, isAggressive or ActionType::call == type);
+      countAny(seat, Stat::preFlopRaise, isAggressive);
+      countAny(seat, Stat::limpOrCallPreFlopRaise, ActionType::call == type);
+
+      if (1 == m_nbRaises and seat != m_openRaiser) {
+        count(seat, Stat::foldToPreFlopRaise, ActionType::fold == type);
+        count(seat, Stat::preFlopThreeBet, isAggressive);
+      } else if (2 == m_nbRaises and seat == m_openRaiser) {
+        count(seat, Stat::foldToPreFlopThreeBet, ActionType::fold == type);
+        count(seat, Stat::callPreFlopThreeBet, ActionType::call == type);
+      }
+
+      onPreflopSteal(seat, type, isAggressive);
+
+      if (isAggressive and 0 == m_nbRaises) {
+        m_openRaiser = seat;
+      }
+    }
+
+    void onPreflopSteal(std::size_t seat, ActionType type, bool isAggressive) noexcept {
+      const auto position {m_positions[seat]};
+      const auto isSteal {m_isFoldedTo and isStealPosition(position)};
+
+      if (isSteal) {
+        count(seat, Stat::stealAttempt, isAggressive);
+      } else if (NO_SEAT != m_stealer and seat != m_stealer and isBlind(position)) {
+        count(seat, Stat::foldToSteal, ActionType::fold == type);
+      }
+
+      if (isAggressive) {
+        m_stealer = isSteal ? seat : NO_SEAT;
+      } else if (ActionType::call == type) {
+        m_stealer = NO_SEAT;
+      }
+
+      m_isFoldedTo = m_isFoldedTo and ActionType::fold == type;
+    }
+
+    [[nodiscard]] const ContinuationBetStats& getContinuationBetStats() const {
+      return CONTINUATION_BET_STATS.at(static_cast<std::size_t>(m_street) -
+                                       static_cast<std::size_t>(Street::flop));
+    }
+
+    [[nodiscard]] bool canDonkBet(std::size_t seat) const noexcept {
+      return Street::flop == m_street and NO_SEAT != m_previousAggressor and
+             seat != m_previousAggressor and !m_hasActed[m_previousAggressor];
+    }
+
+    void onFirstPostflopDecision(std::size_t seat, ActionType type, bool isAggressive) {
+      const auto& stats {getContinuationBetStats()};
+
+      if (seat == m_previousAggressor) {
+        count(seat, stats.m_bet, isAggressive);
+
+        if (isAggressive) {
+          m_continuationBettor = seat;
+        }
+      } else if (canDonkBet(seat)) {
+        count(seat, Stat::donkBet, isAggressive);
+
+        if (isAggressive) {
+          m_donkBettor = seat;
+        }
+      }
+
+      if (isAggressive) {
+        m_firstBettor = seat;
+      } else if (ActionType::check == type) {
+        m_hasChecked[seat] = true;
+      }
+    }
+
+    void onFacingBet(std::size_t seat, ActionType type, bool isAggressive) {
+      const auto& stats {getContinuationBetStats()};
+
+      if (NO_SEAT != m_continuationBettor and seat != m_continuationBettor) {
+        count(seat, stats.m_foldTo, ActionType::fold == type);
+        count(seat, stats.m_call, ActionType::call == type);
+        count(seat, stats.m_raise, isAggressive);
+      }
+
+      if (NO_SEAT != m_donkBettor and seat == m_previousAggressor) {
+        count(seat, Stat::foldToDonkBet, ActionType::fold == type);
+        count(seat, Stat::callDonkBet, ActionType::call == type);
+        count(seat, Stat::raiseAfterDonkBet, isAggressive);
+      }
+
+      if (Street::flop == m_street and m_hasChecked[seat]) {
+        count(seat, Stat::flopCheckRaise, isAggressive);
+
+        if (isAggressive) {
+          m_checkRaiser = seat;
+        }
+      }
+    }
+
+    void onFacingRaise(std::size_t seat, ActionType type) {
+      const auto& stats {getContinuationBetStats()};
+
+      if (seat == m_continuationBettor) {
+        count(seat, stats.m_foldToRaise, ActionType::fold == type);
+      }
+
+      if (seat == m_donkBettor) {
+        count(seat, Stat::foldToRaiseAfterDonkBet, ActionType::fold == type);
+      }
+
+      if (NO_SEAT != m_checkRaiser and seat == m_firstBettor) {
+        count(seat, Stat::foldToFlopCheckRaise, ActionType::fold == type);
+        count(seat, Stat::callFlopCheckRaise, ActionType::call == type);
+      }
+    }
+
+    void onPostflopAction(std::size_t seat, ActionType type, bool isAggressive) {
+      auto& counters {m_counters[seat]};
+
+      if (isAggressive) {
+        ++counters.m_nbOccurrences[toIndex(Stat::aggressionFactor)];
+      } else if (ActionType::call == type) {
+        ++counters.m_nbOpportunities[toIndex(Stat::aggressionFactor)];
+      }
+
+      if (Street::flop == m_street) {
+        m_hasSeenFlop[seat] = true;
+      }
+
+      if (0 == m_nbRaises) {
+        onFirstPostflopDecision(seat, type, isAggressive);
+      } else if (1 == m_nbRaises) {
+        onFacingBet(seat, type, isAggressive);
+      } else if (2 == m_nbRaises) {
+        onFacingRaise(seat, type);
+      }
+    }
+
+  public:
+    explicit Replayer(const tablePosition::SeatPositions& positions) noexcept
+      : m_positions {positions} {}
+
+    void onAction(std::size_t seat, Street street, ActionType type) {
+      if (NO_SEAT <= seat or Street::none == street) {
+        return;
+      }
+
+      if (street != m_street) {
+        startStreet(street);
+      }
+
+      const auto isAggressive {ActionType::bet == type or ActionType::raise == type};
+      m_isInHand[seat] = true;
+
+      if (Street::preflop == street) {
+        onPreflopAction(seat, type, isAggressive);
+      } else {
+        onPostflopAction(seat, type, isAggressive);
+      }
+
+      if (isAggressive) {
+        ++m_nbRaises;
+        m_aggressor = seat;
+      } else if (ActionType::fold == type) {
+        m_hasFolded[seat] = true;
+      }
+
+      m_hasActed[seat] = true;
+    }
+
+    [[nodiscard]] HandReplay::SeatCounters finish() noexcept {
+      std::size_t nbPlayersAtShowdown = 0;
+
+      for (std::size_t seat = 0; seat < NO_SEAT; ++seat) {
+        if (m_isInHand[seat] and !m_hasFolded[seat]) {
+          ++nbPlayersAtShowdown;
+        }
+      }
+
+      for (std::size_t seat = 0; seat < NO_SEAT; ++seat) {
+        if (m_isInHand[seat]) {
+          m_counters[seat].m_nbHands = 1;
+        }
+
+        if (m_hasSeenFlop[seat]) {
+          count(seat, Stat::wentToShowDown, !m_hasFolded[seat] and 2 <= nbPlayersAtShowdown);
+        }
+      }
+
+      return m_counters;
+    }
+  }; // class Replayer
+} // anonymous namespace
+
+/*[[nodiscard]]*/ HandReplay::SeatCounters HandReplay::replay(const Hand& hand) {
+  const auto& seats {hand.getSeats()};
+  Replayer replayer {getPositions(hand)};
+  std::ranges::for_each(hand.viewActions(), [&](const Action* pAction) {
+    const auto seat {std::ranges::find(seats, pAction->getPlayerName()) - seats.begin()};
+    replayer.onAction(static_cast<std::size_t>(seat), pAction->getStreet(), pAction->getType());
+  });
+  return replayer.finish();
+}
+
+/*[[nodiscard]]*/ HandReplay::SeatCounters
+HandReplay::replay(const HandStore::HandRecord& hand,
+                   std::span<const HandStore::ActionRecord> actions) {
+  const auto& seats {hand.m_seatPlayers};
+  Replayer replayer {getPositions(hand)};
+  std::ranges::for_each(actions, [&](const HandStore::ActionRecord& action) {
+    const auto seat {std::ranges::find(seats, action.m_player) - seats.begin()};
+    replayer.onAction(static_cast<std::size_t>(seat), static_cast<Street>(action.m_street),
+                      static_cast<ActionType>(action.m_type));
+  });
+  return replayer.finish();
+}
+
+/*[[nodiscard]]*/ std::vector<PositionalStatCounters>
+HandReplay::replay(const HandStore::Reader& reader) {
+  std::vector<PositionalStatCounters> ret(reader.getNbPlayers());
+  std::ranges::for_each(reader.viewHands(), [&](const HandStore::HandRecord& hand) {
+    const auto seatCounters {replay(hand, reader.viewActions(hand))};
+    const auto positions {getPositions(hand)};
+
+    for (std::size_t seat = 0; seat < NO_SEAT; ++seat) {
+      if (const auto player {hand.m_seatPlayers[seat]};
+          0 != seatCounters[seat].m_nbHands and player < ret.size()) {
+        ret[player].add(positions[seat], seatCounters[seat]);
+      }
+    }
+  });
+  return ret;
+}
+
+/*[[nodiscard]]*/ tablePosition::SeatPositions HandReplay::getPositions(const Hand& hand) {
+  std::array<bool, TableConstants::MAX_SEATS> isSeated {};
+  std::ranges::transform(hand.getSeats(), isSeated.begin(),
+                         [](const auto& player) { return !player.empty(); });
+  return tablePosition::fromSeats(isSeated, hand.getButtonSeat());
+}
+
+/*[[nodiscard]]*/ tablePosition::SeatPositions
+HandReplay::getPositions(const HandStore::HandRecord& hand) {
+  std::array<bool, TableConstants::MAX_SEATS> isSeated {};
+  std::ranges::transform(hand.m_seatPlayers, isSeated.begin(),
+                         [](auto player) { return HandStore::NO_PLAYER != player; });
+  return tablePosition::fromSeats(isSeated, static_cast<Seat>(hand.m_buttonSeat));
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "constants/TableConstants.hpp" // TableConstants::MAX_SEATS
+#include "db/HandStore.hpp"             // HandStore, std::span, std::vector
+#include "statistics/StatCounters.hpp"  // StatCounters, PositionalStatCounters, tablePosition
+
+// forward declarations
+class Hand;
+
+/**
+ * Computes the statistics of the players by replaying the actions of each hand once, in their
+ * order, tracking the preflop aggressor, the raise depth and the state of each street. The
+ * position of each player is derived from the seats and the button of the hand.
+ */
+class [[nodiscard]] HandReplay final {
+public:
+  // the counters of a hand, indexed as the seats of the hand
+  using SeatCounters = std::array<StatCounters, TableConstants::MAX_SEATS>;
+
+  /**
+   * @returns the counters of each seated player of the given hand, the seats without player or
+   * without action being left empty.
+   */
+  [[nodiscard]] static SeatCounters replay(const Hand& hand);
+
+  /**
+   * Same as above, for a hand read from the hand store.
+   */
+  [[nodiscard]] static SeatCounters replay(const HandStore::HandRecord& hand,
+                                           std::span<const HandStore::ActionRecord> actions);
+
+  /**
+   * Replays all the hands of the given store, in a single pass over its records.
+   * @returns the counters of each player by position, indexed by player id
+   */
+  [[nodiscard]] static std::vector<PositionalStatCounters> replay(const HandStore::Reader& reader);
+
+  /**
+   * @returns the position of each seated player of the given hand
+   */
+  [[nodiscard]] static tablePosition::SeatPositions getPositions(const Hand& hand);
+
+  /**
+   * Same as above, for a hand read from the hand store.
+   */
+  [[nodiscard]] static tablePosition::SeatPositions
+  getPositions(const HandStore::HandRecord& hand);
+}; // class HandReplay
@@ -8,6 +8,56 @@ PlayerStatistics::PlayerStatistics(const Params& p) noexcept
     m_nbHands {p.nbHands},
     m_isHero {p.isHero} {}
 
+PlayerStatistics::PlayerStatistics(const CountersParams& p) noexcept
+  : PlayerStatistics(p, p.counters.getAll()) {}
+
+PlayerStatistics::PlayerStatistics(const CountersParams& p, const StatCounters& all) noexcept
+  : m_playerName {p.playerName},
+    m_siteName {p.siteName},
+    m_voluntaryPutMoneyInPot {all.getPercentage(Stat::voluntaryPutMoneyInPot)},
+    m_preflopRaise {all.getPercentage(Stat::preFlopRaise)},
+    m_aggressionFactor {all.getRatio(Stat::aggressionFactor)},
+    m_limpOrCallPreFlopRaise {all.getPercentage(Stat::limpOrCallPreFlopRaise)},
+    m_foldToPreFlopRaise {all.getPercentage(Stat::foldToPreFlopRaise)},
+    m_preFlopThreeBet {all.getPercentage(Stat::preFlopThreeBet)},
+    m_foldToPreFlopThreeBet {all.getPercentage(Stat::foldToPreFlopThreeBet)},
+    m_callPreFlopThreeBet {all.getPercentage(Stat::callPreFlopThreeBet)},
+    m_wentToShowDown {all.getPercentage(Stat::wentToShowDown)},
+    m_flopContinuationBet {all.getPercentage(Stat::flopContinuationBet)},
+    m_foldToFlopContinuationBet {all.getPercentage(Stat::foldToFlopContinuationBet)},
+    m_callFlopContinuationBet {all.getPercentage(Stat::callFlopContinuationBet)},
+    m_raiseAfterFlopContinuationBet {
+        all.getPercentage(Stat::raiseAfterFlopContinuationBet)},
+    m_foldToRaiseAfterFlopContinuationBet {
+        all.getPercentage(Stat::foldToRaiseAfterFlopContinuationBet)},
+    m_turnContinuationBet {all.getPercentage(Stat::turnContinuationBet)},
+    m_foldToTurnContinuationBet {all.getPercentage(Stat::foldToTurnContinuationBet)},
+    m_callTurnContinuationBet {all.getPercentage(Stat::callTurnContinuationBet)},
+    m_raiseAfterTurnContinuationBet {
+        all.getPercentage(Stat::raiseAfterTurnContinuationBet)},
+    m_foldToRaiseAfterTurnContinuationBet {
+        all.getPercentage(Stat::foldToRaiseAfterTurnContinuationBet)},
+    m_riverContinuationBet {all.getPercentage(Stat::riverContinuationBet)},
+    m_foldToRiverContinuationBet {all.getPercentage(Stat::foldToRiverContinuationBet)},
+    m_callRiverContinuationBet {all.getPercentage(Stat::callRiverContinuationBet)},
+    m_raiseAfterRiverContinuationBet {
+        all.getPercentage(Stat::raiseAfterRiverContinuationBet)},
+    m_foldToRaiseAfterRiverContinuationBet {
+        all.getPercentage(Stat::foldToRaiseAfterRiverContinuationBet)},
+    m_donkBet {all.getPercentage(Stat::donkBet)},
+    m_foldToDonkBet {all.getPercentage(Stat::foldToDonkBet)},
+    m_callDonkBet {all.getPercentage(Stat::callDonkBet)},
+    m_raiseAfterDonkBet {all.getPercentage(Stat::raiseAfterDonkBet)},
+    m_foldToRaiseAfterDonkBet {all.getPercentage(Stat::foldToRaiseAfterDonkBet)},
+    m_flopCheckRaise {all.getPercentage(Stat::flopCheckRaise)},
+    m_callFlopCheckRaise {all.getPercentage(Stat::callFlopCheckRaise)},
+    m_foldToFlopCheckRaise {all.getPercentage(Stat::foldToFlopCheckRaise)},
+    m_stealAttempt {all.getPercentage(Stat::stealAttempt)},
+    m_foldToSteal {all.getPercentage(Stat::foldToSteal)},
+    m_positionalCounters {p.counters},
+    m_nbHands {static_cast<int>(all.m_nbHands)},
+    m_isHero {p.isHero} {}
+
 PlayerStatistics::~PlayerStatistics() = default;
 
 
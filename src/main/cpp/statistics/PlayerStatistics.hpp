@@ -1,6 +1,7 @@
 #pragma once
 
-#include "language/limits.hpp" // toInt
+#include "language/limits.hpp"         // toInt
+#include "statistics/StatCounters.hpp" // StatCounters, PositionalStatCounters, TablePosition
 #include <string>
 #include <string_view>
 
@@ -51,6 +52,11 @@ private:
   double m_flopCheckRaise {0};
   double m_callFlopCheckRaise {0};
   double m_foldToFlopCheckRaise {0};
+  double m_stealAttempt {0};
+  double m_foldToSteal {0};
+
+  // the counters by position (4 bytes each, alignment 4), empty when built from Params
+  PositionalStatCounters m_positionalCounters {};
 
   // int (4 bytes, alignment 4)
   int m_nbHands;
@@ -68,7 +74,24 @@ public:
     double pfr;
   };
 
+  struct [[nodiscard]] CountersParams final {
+    std::string_view playerName;
+    std::string_view siteName;
+    const PositionalStatCounters& counters;
+    bool isHero;
+  };
+
   explicit PlayerStatistics(const Params& p) noexcept;
+  /**
+   * Builds all the statistics from the counters computed by the HandReplay.
+   */
+  explicit PlayerStatistics(const CountersParams& p) noexcept;
+
+private:
+  // all is the sum of the positional counters, computed once
+  PlayerStatistics(const CountersParams& p, const StatCounters& all) noexcept;
+
+public:
   PlayerStatistics(const PlayerStatistics&) = delete;
   PlayerStatistics(PlayerStatistics&&) = delete;
   PlayerStatistics& operator=(const PlayerStatistics&) = delete;
@@ -174,4 +197,15 @@ public:
   [[nodiscard]] constexpr double getFoldToFlopCheckRaise() const noexcept {
     return m_foldToFlopCheckRaise;
   }
+  [[nodiscard]] constexpr double getStealAttempt() const noexcept { return m_stealAttempt; }
+  [[nodiscard]] constexpr double getFoldToSteal() const noexcept { return m_foldToSteal; }
+
+  /**
+   * @returns the percentage of the given statistic at the given position, e.g. the steal attempts
+   * on the button or the folds to a steal in the big blind. 0 if built from Params.
+   * position is not TablePosition::none
+   */
+  [[nodiscard]] constexpr double getPercentage(Stat stat, TablePosition position) const noexcept {
+    return m_positionalCounters.get(position).getPercentage(stat);
+  }
 }; // class PlayerStatistics
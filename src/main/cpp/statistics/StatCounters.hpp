@@ -0,0 +1,179 @@
+#pragma once
+
+#include "entities/TablePosition.hpp" // TablePosition, tablePosition, std::array, std::size_t
+#include <cstdint>                    // std::uint32_t
+
+/**
+ * The statistics computed by replaying the hands. Each one is counted as a number of occurrences
+ * out of a number of opportunities, both counted at most once per hand, except the aggression
+ * factor. A player has the opportunity of a statistic at the first decision matching its
+ * situation. The postflop aggressor of a street is the last player to bet or raise on it, the
+ * preflop aggressor being the last preflop raiser.
+ */
+enum class /*[[nodiscard]]*/ Stat : short {
+  /** calls, bets or raises preflop / acts preflop */
+  voluntaryPutMoneyInPot,
+  /** bets or raises preflop / acts preflop */
+  preFlopRaise,
+  /** postflop bets and raises / postflop calls, counted for each action */
+  aggressionFactor,
+  /** calls preflop / acts preflop */
+  limpOrCallPreFlopRaise,
+  /** folds / faces the first preflop raise, not being the raiser */
+  foldToPreFlopRaise,
+  /** raises / faces the first preflop raise, not being the raiser */
+  preFlopThreeBet,
+  /** folds / faces a 3-bet after the first preflop raise */
+  foldToPreFlopThreeBet,
+  /** calls / faces a 3-bet after the first preflop raise */
+  callPreFlopThreeBet,
+  /** does not fold until the showdown / sees the flop */
+  wentToShowDown,
+  /** bets / is the preflop aggressor and acts on the flop before any bet */
+  flopContinuationBet,
+  /** folds / faces a flop continuation bet */
+  foldToFlopContinuationBet,
+  /** calls / faces a flop continuation bet */
+  callFlopContinuationBet,
+  /** raises / faces a flop continuation bet */
+  raiseAfterFlopContinuationBet,
+  /** folds / faces a raise after the own flop continuation bet */
+  foldToRaiseAfterFlopContinuationBet,
+  /** bets / is the flop aggressor and acts on the turn before any bet */
+  turnContinuationBet,
+  /** folds / faces a turn continuation bet */
+  foldToTurnContinuationBet,
+  /** calls / faces a turn continuation bet */
+  callTurnContinuationBet,
+  /** raises / faces a turn continuation bet */
+  raiseAfterTurnContinuationBet,
+  /** folds / faces a raise after the own turn continuation bet */
+  foldToRaiseAfterTurnContinuationBet,
+  /** bets / is the turn aggressor and acts on the river before any bet */
+  riverContinuationBet,
+  /** folds / faces a river continuation bet */
+  foldToRiverContinuationBet,
+  /** calls / faces a river continuation bet */
+  callRiverContinuationBet,
+  /** raises / faces a river continuation bet */
+  raiseAfterRiverContinuationBet,
+  /** folds / faces a raise after the own river continuation bet */
+  foldToRaiseAfterRiverContinuationBet,
+  /** bets / acts on the flop before any bet and before the preflop aggressor, who is still in */
+  donkBet,
+  /** folds / is the preflop aggressor facing a flop donk bet */
+  foldToDonkBet,
+  /** calls / is the preflop aggressor facing a flop donk bet */
+  callDonkBet,
+  /** raises / is the preflop aggressor facing a flop donk bet */
+  raiseAfterDonkBet,
+  /** folds / faces a raise after the own donk bet */
+  foldToRaiseAfterDonkBet,
+  /** raises / faces a bet on the flop after checking */
+  flopCheckRaise,
+  /** calls / faces a flop check-raise after the own bet */
+  callFlopCheckRaise,
+  /** folds / faces a flop check-raise after the own bet */
+  foldToFlopCheckRaise,
+  /** raises / is folded to preflop, on the cut-off, the button or the small blind */
+  stealAttempt,
+  /** folds / faces a steal attempt in the blinds, without any call or raise after it */
+  foldToSteal
+};
+
+static constexpr std::size_t NB_STATS {static_cast<std::size_t>(Stat::foldToSteal) + 1};
+
+/**
+ * The counters of all the statistics of a player, as plain arrays so that the counters of several
+ * hands or players are merged by adding them element by element.
+ */
+struct [[nodiscard]] StatCounters final {
+  // Memory layout optimized: largest to smallest to minimize padding
+  std::array<std::uint32_t, NB_STATS> m_nbOccurrences {};
+  std::array<std::uint32_t, NB_STATS> m_nbOpportunities {};
+  std::uint32_t m_nbHands = 0;
+
+  constexpr StatCounters& operator+=(const StatCounters& other) noexcept {
+    for (std::size_t i = 0; i < NB_STATS; ++i) {
+      m_nbOccurrences[i] += other.m_nbOccurrences[i];
+      m_nbOpportunities[i] += other.m_nbOpportunities[i];
+    }
+
+    m_nbHands += other.m_nbHands;
+    return *this;
+  }
+
+  [[nodiscard]] constexpr std::uint32_t getNbOccurrences(Stat stat) const noexcept {
+    return m_nbOccurrences[static_cast<std::size_t>(stat)];
+  }
+
+  [[nodiscard]] constexpr std::uint32_t getNbOpportunities(Stat stat) const noexcept {
+    return m_nbOpportunities[static_cast<std::size_t>(stat)];
+  }
+
+  /**
+   * @returns the percentage of the opportunities where the statistic occurred, 0 without any
+   * opportunity
+   */
+  [[nodiscard]] constexpr double getPercentage(Stat stat) const noexcept {
+    return 100.0 * getRatio(stat);
+  }
+
+  /**
+   * @returns the number of occurrences divided by the number of opportunities, 0 without any
+   * opportunity
+   */
+  [[nodiscard]] constexpr double getRatio(Stat stat) const noexcept {
+    const auto nbOpportunities {getNbOpportunities(stat)};
+    return 0 == nbOpportunities ? 0.0
+                                : static_cast<double>(getNbOccurrences(stat)) / nbOpportunities;
+  }
+
+  [[nodiscard]] constexpr bool operator==(const StatCounters&) const noexcept = default;
+}; // struct StatCounters
+
+/**
+ * The counters of all the statistics of a player, one block for each position. The blocks are
+ * contiguous, so that the counters of a position are read at once and the blocks are summed
+ * element by element.
+ */
+struct [[nodiscard]] PositionalStatCounters final {
+  std::array<StatCounters, tablePosition::NB_POSITIONS> m_positions {};
+
+  constexpr PositionalStatCounters& operator+=(const PositionalStatCounters& other) noexcept {
+    for (std::size_t i = 0; i < tablePosition::NB_POSITIONS; ++i) {
+      m_positions[i] += other.m_positions[i];
+    }
+
+    return *this;
+  }
+
+  /**
+   * Adds the counters of a player at the given position, ignored for TablePosition::none.
+   */
+  constexpr void add(TablePosition position, const StatCounters& counters) noexcept {
+    if (TablePosition::none != position) {
+      m_positions[tablePosition::toArrayIndex(position)] += counters;
+    }
+  }
+
+  // position is not TablePosition::none
+  [[nodiscard]] constexpr const StatCounters& get(TablePosition position) const noexcept {
+    return m_positions[tablePosition::toArrayIndex(position)];
+  }
+
+  /**
+   * @returns the counters of all the positions
+   */
+  [[nodiscard]] constexpr StatCounters getAll() const noexcept {
+    StatCounters ret;
+
+    for (const auto& counters : m_positions) {
+      ret += counters;
+    }
+
+    return ret;
+  }
+
+  [[nodiscard]] constexpr bool operator==(const PositionalStatCounters&) const noexcept = default;
+}; // struct PositionalStatCounters
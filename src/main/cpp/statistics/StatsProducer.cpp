@@ -1,8 +1,8 @@
-#include "db/Database.hpp"
 #include "language/Validator.hpp"
 #include "log/Logger.hpp"
 #include "statistics/PlayerStatistics.hpp"
 #include "statistics/StatsProducer.hpp" // std::array, toMilliseconds, std::unique_ptr
+#include "statistics/StatsStore.hpp"
 #include "statistics/TableStatistics.hpp"
 #include "threads/PeriodicTask.hpp"
 #include "threads/ThreadSafeQueue.hpp"
@@ -14,16 +14,13 @@ static Logger& LOG() {
 
 struct [[nodiscard]] StatsProducer::Implementation final {
   PeriodicTask m_task;
-  std::string m_site;
   std::string m_table;
-  const Database& m_db;
+  const StatsStore& m_store;
 
   explicit Implementation(const StatsProducerArgs& args)
     : m_task {args.reloadPeriod, "StatsProducer"},
-      m_site {args.site},
       m_table {args.tableWindowName},
-      m_db {args.db} {
-    validation::requireNonEmpty(args.site, "site");
+      m_store {args.store} {
     validation::requireNonEmpty(args.tableWindowName, "tableWindowName");
   }
 };
@@ -35,13 +32,11 @@ StatsProducer::~StatsProducer() = default;
 
 void StatsProducer::start(ThreadSafeQueue<TableStatistics>& statsQueue) const {
   m_pImpl->m_task.start([this, &statsQueue]() {
-    if (auto stats {m_pImpl->m_db.readTableStatistics(m_pImpl->m_site, m_pImpl->m_table)};
-        stats.isValid()) {
-      LOG().debug<"Got stats from db.">();
+    if (auto stats {m_pImpl->m_store.getTableStatistics(m_pImpl->m_table)}; stats.isValid()) {
+      LOG().debug<"Got stats from memory.">();
       statsQueue.push(std::move(stats));
     } else {
-      LOG().debug<"Got no stats from db yet for table {} on site {}.">(m_pImpl->m_table,
-                                                                       m_pImpl->m_site);
+      LOG().debug<"Got no stats yet for table {}.">(m_pImpl->m_table);
     }
     return PeriodicTaskStatus::repeatTask;
   });
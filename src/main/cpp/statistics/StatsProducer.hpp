@@ -2,9 +2,10 @@
 
 #include <chrono>
 #include <memory> // std::unique_ptr
+#include <string_view>
 
 // forward declarations
-class Database;
+class StatsStore;
 struct TableStatistics;
 template <typename T>
 class ThreadSafeQueue;
@@ -17,9 +18,9 @@ private:
 public:
   struct [[nodiscard]] StatsProducerArgs final {
     std::chrono::milliseconds reloadPeriod;
-    std::string_view site;
     std::string_view tableWindowName;
-    const Database& db;
+    // fed by the saves of the sites, see Database::addSiteObserver()
+    const StatsStore& store;
   };
   explicit StatsProducer(const StatsProducerArgs& args);
   StatsProducer(const StatsProducer&) = delete;
@@ -0,0 +1,168 @@
+#include "entities/Game.hpp"               // CashGame, Tournament
+#include "entities/Hand.hpp"               // Hand
+#include "entities/Player.hpp"             // Player
+#include "entities/Seat.hpp"               // Seat, tableSeat
+#include "entities/Site.hpp"               // Site
+#include "language/Validator.hpp"          // validation::require
+#include "statistics/HandReplay.hpp"       // HandReplay, PositionalStatCounters
+#include "statistics/PlayerStatistics.hpp" // PlayerStatistics
+#include "statistics/StatsStore.hpp"       // StatsStore, HandStore
+#include "statistics/TableStatistics.hpp"  // TableStatistics
+#include <algorithm>                       // std::ranges::for_each
+#include <functional>                      // std::equal_to, std::hash
+#include <mutex>                           // std::scoped_lock
+#include <unordered_map>
+#include <unordered_set>
+
+namespace {
+  // allows to find a player or a table from a std::string_view without building a std::string
+  struct [[nodiscard]] StringHash final {
+    using is_transparent = void;
+
+    [[nodiscard]] std::size_t operator()(std::string_view s) const noexcept {
+      return std::hash<std::string_view> {}(s);
+    }
+  }; // struct StringHash
+
+  template <typename T>
+  using StringMap = std::unordered_map<std::string, T, StringHash, std::equal_to<>>;
+
+  // the players of the last hand of a table
+  struct [[nodiscard]] TableState final {
+    // Memory layout optimized: largest to smallest to minimize padding
+    std::array<std::string, TableConstants::MAX_SEATS> m_seats {};
+    std::int64_t m_startDate = 0;
+    Seat m_maxSeats = Seat::seatUnknown;
+  }; // struct TableState
+} // anonymous namespace
+
+struct [[nodiscard]] StatsStore::Implementation final {
+  // Memory layout optimized: largest to smallest to minimize padding
+  StringMap<PositionalStatCounters> m_playerCounters {};
+  StringMap<TableState> m_tables {};
+  std::unordered_set<std::uint64_t> m_handIdHashes {};
+  std::unordered_set<std::string, StringHash, std::equal_to<>> m_heroes {};
+  std::string m_site;
+  mutable std::mutex m_mutex {};
+
+  explicit Implementation(std::string_view site)
+    : m_site {site} {}
+
+  // adds the counters of a hand, which players and positions are given by seat
+  void addCounters(const HandReplay::SeatCounters& counters, const auto& seatPlayers,
+                   const tablePosition::SeatPositions& positions) {
+    for (std::size_t seat = 0; seat < counters.size(); ++seat) {
+      if (0 != counters[seat].m_nbHands) {
+        const std::string_view player {seatPlayers[seat]};
+        auto it {m_playerCounters.find(player)};
+
+        if (m_playerCounters.end() == it) {
+          it = m_playerCounters.try_emplace(std::string(player)).first;
+        }
+
+        it->second.add(positions[seat], counters[seat]);
+      }
+    }
+  }
+
+  // keeps the hand if it is the last one of its table
+  void updateTable(const Hand& hand) {
+    const auto startDate {hand.getStartDate().toEpochSeconds()};
+    auto it {m_tables.find(hand.getTableName())};
+
+    if (m_tables.end() == it) {
+      it = m_tables.try_emplace(hand.getTableName()).first;
+    } else if (startDate < it->second.m_startDate) {
+      return;
+    }
+
+    it->second = {
+        .m_seats = hand.getSeats(), .m_startDate = startDate, .m_maxSeats = hand.getMaxSeats()};
+  }
+
+  // @returns true if the hand was not counted yet
+  [[nodiscard]] bool add(const Hand& hand) {
+    const auto isNew {m_handIdHashes.insert(HandStore::hashHandId(hand.getId())).second};
+
+    if (isNew) {
+      addCounters(HandReplay::replay(hand), hand.getSeats(), HandReplay::getPositions(hand));
+    }
+
+    // the hands counted from the hand store give their table when they are added
+    updateTable(hand);
+    return isNew;
+  }
+
+  [[nodiscard]] std::size_t add(const auto& games) {
+    std::size_t ret = 0;
+    std::ranges::for_each(games, [this, &ret](const auto* pGame) {
+      std::ranges::for_each(pGame->viewHands(), [this, &ret](const Hand* pHand) {
+        ret += add(*pHand) ? 1 : 0;
+      });
+    });
+    return ret;
+  }
+}; // struct StatsStore::Implementation
+
+StatsStore::StatsStore(std::string_view site)
+  : m_pImpl {std::make_unique<Implementation>(site)} {}
+
+StatsStore::~StatsStore() = default;
+
+std::size_t StatsStore::load(const HandStore::Reader& reader) {
+  const std::scoped_lock lock {m_pImpl->m_mutex};
+  std::size_t ret = 0;
+  std::array<std::string_view, TableConstants::MAX_SEATS> seatPlayers {};
+  std::ranges::for_each(reader.viewHands(), [&](const HandStore::HandRecord& hand) {
+    if (m_pImpl->m_handIdHashes.insert(hand.m_handIdHash).second) {
+      std::ranges::transform(hand.m_seatPlayers, seatPlayers.begin(),
+                             [&reader](auto id) { return reader.getPlayerName(id); });
+      m_pImpl->addCounters(HandReplay::replay(hand, reader.viewActions(hand)), seatPlayers,
+                           HandReplay::getPositions(hand));
+      ++ret;
+    }
+  });
+  return ret;
+}
+
+std::size_t StatsStore::add(const Site& site) {
+  validation::require(m_pImpl->m_site == site.getName(), "adding the hands of another site");
+  const std::scoped_lock lock {m_pImpl->m_mutex};
+  std::ranges::for_each(site.viewPlayers(), [this](const Player* pPlayer) {
+    if (pPlayer->isHero()) {
+      m_pImpl->m_heroes.insert(pPlayer->getName());
+    }
+  });
+  return m_pImpl->add(site.viewCashGames()) + m_pImpl->add(site.viewTournaments());
+}
+
+/*[[nodiscard]]*/ TableStatistics StatsStore::getTableStatistics(std::string_view table) const {
+  const std::scoped_lock lock {m_pImpl->m_mutex};
+  const auto tableIt {m_pImpl->m_tables.find(table)};
+
+  if (m_pImpl->m_tables.end() == tableIt) {
+    return {};
+  }
+
+  static const PositionalStatCounters NO_COUNTERS {};
+  const auto& [seats, startDate, maxSeats] {tableIt->second};
+  std::array<std::unique_ptr<PlayerStatistics>, TableConstants::MAX_SEATS> playerStats {};
+
+  for (std::size_t seat = 0; seat < seats.size(); ++seat) {
+    if (const auto& player {seats[seat]}; !player.empty()) {
+      const auto it {m_pImpl->m_playerCounters.find(player)};
+      playerStats[seat] = std::make_unique<PlayerStatistics>(PlayerStatistics::CountersParams {
+          .playerName = player,
+          .siteName = m_pImpl->m_site,
+          .counters = m_pImpl->m_playerCounters.end() == it ? NO_COUNTERS : it->second,
+          .isHero = m_pImpl->m_heroes.contains(player)});
+    }
+  }
+
+  return {m_pImpl->m_site, table, maxSeats, std::move(playerStats)};
+}
+
+/*[[nodiscard]]*/ std::size_t StatsStore::getNbHands() const {
+  const std::scoped_lock lock {m_pImpl->m_mutex};
+  return m_pImpl->m_handIdHashes.size();
+}
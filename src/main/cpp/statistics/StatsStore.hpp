@@ -0,0 +1,52 @@
+#pragma once
+
+#include "db/HandStore.hpp" // HandStore::Reader, std::filesystem::path
+#include <cstddef>          // std::size_t
+#include <memory>           // std::unique_ptr
+#include <string_view>
+
+// forward declarations
+class Site;
+struct TableStatistics;
+
+/**
+ * The statistics of the players of a poker site, kept in memory as counters of occurrences and
+ * opportunities so that each new hand is added to them in place. Built once from the hand store,
+ * then fed by the parsed hands, each hand being counted once whatever the number of times it is
+ * added. The statistics of a table are assembled from memory, without any disk access.
+ * Thread safe.
+ */
+class [[nodiscard]] StatsStore final {
+private:
+  struct Implementation;
+  std::unique_ptr<Implementation> m_pImpl;
+
+public:
+  explicit StatsStore(std::string_view site);
+  StatsStore(const StatsStore&) = delete;
+  StatsStore(StatsStore&&) = delete;
+  StatsStore& operator=(const StatsStore&) = delete;
+  StatsStore& operator=(StatsStore&&) = delete;
+  ~StatsStore();
+
+  /**
+   * Counts the hands of the given hand store not counted yet. The hand store doesn't know the
+   * tables, so the tables are known from the added sites only.
+   * @returns the number of hands counted
+   */
+  std::size_t load(const HandStore::Reader& reader);
+
+  /**
+   * Counts the hands of the given site not counted yet, and keeps the last hand of each table.
+   * @returns the number of hands counted
+   */
+  std::size_t add(const Site& site);
+
+  /**
+   * @returns the statistics of the players seated at the last hand of the given table, or invalid
+   * statistics if no hand of the table was added.
+   */
+  [[nodiscard]] TableStatistics getTableStatistics(std::string_view table) const;
+
+  [[nodiscard]] std::size_t getNbHands() const;
+}; // class StatsStore
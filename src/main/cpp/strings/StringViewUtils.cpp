@@ -122,7 +122,8 @@ std::string phud::strings::replaceAll(std::string_view s, char oldC, char newC)
   auto pos = ret.find(oldStr);
 
   while (std::string_view::npos != pos) {
-    pos = ret.replace(pos, oldStr.size(), newStr).find(oldStr);
+    // searches after the replacement, as newStr can contain oldStr
+    pos = ret.replace(pos, oldStr.size(), newStr).find(oldStr, pos + newStr.size());
   }
 
   return ret;
@@ -1,5 +1,6 @@
 #include "system/Time.hpp"
 #include <spdlog/fmt/bundled/format.h> // fmt::format
+#include <chrono>                      // std::chrono::sys_days
 #include <iomanip>                     // std::get_time
 #include <sstream>                     // std::istringstream, std::ostringstream
 #include <utility>                     // std::exchange
@@ -49,8 +50,6 @@ Time& Time::operator=(Time&& other) noexcept {
   return *this;
 }
 
-static constexpr std::string_view SQLITE_DATE_FORMAT {"%Y-%m-%d %H:%M:%S"};
-
 std::string Time::toSqliteDate() const {
   // "2014-10-31 00:45:01"
   std::ostringstream oss;
@@ -58,6 +57,17 @@ std::string Time::toSqliteDate() const {
   return oss.str();
 }
 
+std::int64_t Time::toEpochSeconds() const noexcept {
+  namespace sc = std::chrono;
+  const auto& tm = *m_pTimeData;
+  const sc::sys_days day {sc::year {tm.tm_year + 1900} /
+                         sc::month {static_cast<unsigned>(tm.tm_mon + 1)} /
+                         sc::day {static_cast<unsigned>(tm.tm_mday)}};
+  const auto time =
+      day + sc::hours {tm.tm_hour} + sc::minutes {tm.tm_min} + sc::seconds {tm.tm_sec};
+  return time.time_since_epoch().count();
+}
+
 bool Time::operator==(const Time& other) const noexcept {
   return this == &other ? true
                         : m_pTimeData->tm_sec == other.m_pTimeData->tm_sec and
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "language/PhudException.hpp" // PhudException, std::string_view
+#include <cstdint>                    // std::int64_t
 #include <memory>                     // std::unique_ptr
 
 // forward declaration
@@ -25,6 +26,10 @@ public:
   Time& operator=(Time&&) noexcept;
   [[nodiscard]] bool operator==(const Time&) const noexcept;
   [[nodiscard]] std::string toSqliteDate() const;
+  /**
+   * @returns the number of seconds since 1970-01-01 00:00:00, the time being considered as UTC.
+   */
+  [[nodiscard]] std::int64_t toEpochSeconds() const noexcept;
 }; // class Time
 
 class [[nodiscard]] TimeException final : public PhudException {
@@ -38,3 +43,5 @@ static constexpr std::string_view WINAMAX_HISTORY_TIME_FORMAT {
 // Tuesday, September 14, 18:33:39 CEST 2021
 static constexpr std::string_view PMU_HISTORY_TIME_FORMAT {"%A, %B %d, %H:%M:%S %Y"};
 // ex: Tuesday, September 14, 18:33:39 2021
+static constexpr std::string_view SQLITE_DATE_FORMAT {"%Y-%m-%d %H:%M:%S"};
+// ex: 2014-10-31 00:45:01
@@ -0,0 +1,80 @@
+#include "log/Logger.hpp" // CURRENT_FILE_NAME
+#include "threads/DelayedExecutor.hpp"
+#include <condition_variable> // std::condition_variable_any
+#include <map>
+#include <mutex>
+#include <thread> // std::jthread
+
+static Logger& LOG() {
+  static auto logger = Logger(CURRENT_FILE_NAME);
+  return logger;
+}
+
+struct [[nodiscard]] DelayedExecutor::Implementation final {
+  // Memory layout optimized: largest to smallest to minimize padding
+  // the expiry time -> the callbacks to call, in the order of their expiry
+  std::multimap<std::chrono::steady_clock::time_point, std::function<void()>> m_callbacks {};
+  std::condition_variable_any m_cv {};
+  std::mutex m_mutex {};
+  std::jthread m_thread {};
+
+  // once the stop is requested, the waiting callbacks are called at once
+  void callExpiredCallbacks(const std::stop_token& stopToken) {
+    std::unique_lock lock {m_mutex};
+
+    while (!stopToken.stop_requested() or !m_callbacks.empty()) {
+      if (m_callbacks.empty()) {
+        m_cv.wait(lock, stopToken, [this] { return !m_callbacks.empty(); });
+        continue;
+      }
+
+      if (const auto expiry {m_callbacks.begin()->first};
+          !stopToken.stop_requested() and std::chrono::steady_clock::now() < expiry) {
+        // woken up by the stop request and by a callback that expires earlier
+        m_cv.wait_until(lock, stopToken, expiry,
+                        [this, expiry] { return m_callbacks.begin()->first < expiry; });
+        continue;
+      }
+
+      const auto callback {std::move(m_callbacks.begin()->second)};
+      m_callbacks.erase(m_callbacks.begin());
+      // the callback may add a callback
+      lock.unlock();
+
+      try {
+        callback();
+      } catch (const std::exception& e) {
+        LOG().error<"A delayed callback failed: {}">(e.what());
+      } catch (...) {
+        LOG().error<"A delayed callback failed: unknown error">();
+      }
+
+      lock.lock();
+    }
+  }
+}; // struct DelayedExecutor::Implementation
+
+DelayedExecutor::DelayedExecutor()
+  : m_pImpl {std::make_unique<Implementation>()} {
+  m_pImpl->m_thread = std::jthread([pImpl = m_pImpl.get()](const std::stop_token& stopToken) {
+    pImpl->callExpiredCallbacks(stopToken);
+  });
+}
+
+DelayedExecutor::~DelayedExecutor() {
+  try {
+    m_pImpl->m_thread.request_stop();
+    m_pImpl->m_thread.join();
+  } catch (...) { // can't throw in a destructor
+    LOG().error<"Unknown error during the stop of DelayedExecutor.">();
+  }
+}
+
+void DelayedExecutor::executeAfter(std::chrono::milliseconds delay,
+                                   std::function<void()> callback) const {
+  {
+    const std::scoped_lock lock {m_pImpl->m_mutex};
+    m_pImpl->m_callbacks.emplace(std::chrono::steady_clock::now() + delay, std::move(callback));
+  }
+  m_pImpl->m_cv.notify_one();
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <chrono>
+#include <functional> // std::function
+#include <memory>     // std::unique_ptr
+
+/**
+ * Calls the given callbacks once their delay has expired, from a single timer thread. The callbacks
+ * are expected to submit their work to the ThreadPool, so that waiting for a delay never blocks a
+ * pool worker.
+ */
+class [[nodiscard]] DelayedExecutor final {
+private:
+  struct Implementation;
+  std::unique_ptr<Implementation> m_pImpl;
+
+public:
+  DelayedExecutor();
+  DelayedExecutor(const DelayedExecutor&) = delete;
+  DelayedExecutor(DelayedExecutor&&) = delete;
+  DelayedExecutor& operator=(const DelayedExecutor&) = delete;
+  DelayedExecutor& operator=(DelayedExecutor&&) = delete;
+  /**
+   * Calls the waiting callbacks at once, then stops the timer thread.
+   */
+  ~DelayedExecutor();
+
+  /**
+   * Calls the given callback from the timer thread once the delay has expired.
+   */
+  void executeAfter(std::chrono::milliseconds delay, std::function<void()> callback) const;
+}; // class DelayedExecutor
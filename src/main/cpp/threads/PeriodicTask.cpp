@@ -66,7 +66,9 @@ bool PeriodicTask::isRunning() const noexcept {
 
 void PeriodicTask::start(const std::function<PeriodicTaskStatus()>& task) const {
   m_pImpl->m_taskIsStopped = false;
-  m_pImpl->m_futureTaskResult = ThreadPool::submit([this, task]() {
+  // the loop occupies a thread pool worker as long as the task runs
+  using enum ThreadPool::TaskCategory;
+  m_pImpl->m_futureTaskResult = ThreadPool::submit(periodic, [this, task]() {
     do {
       auto lock = std::unique_lock<std::mutex>(m_pImpl->m_mutex);
       const auto timeout = std::chrono::steady_clock::now() + m_pImpl->m_period;
@@ -47,6 +47,19 @@ bool PlayerCache::isEmpty() const {
   return m_pImpl->m_players.empty();
 }
 
+MemoryUsage PlayerCache::getMemoryUsage() const {
+  // a tree node holds 3 pointers and a color, aligned on a pointer, and the entry
+  using Entry = decltype(m_pImpl->m_players)::value_type;
+  constexpr auto NODE_SIZE {4 * sizeof(void*) + sizeof(Entry)};
+  const std::scoped_lock lock(m_pImpl->m_mutex);
+  MemoryUsage ret {.m_nbBytes = sizeof(Implementation), .m_nbObjects = 0};
+  std::ranges::for_each(m_pImpl->m_players, [&ret](const auto& nameToPlayer) {
+    ret += nameToPlayer.second->getMemoryUsage();
+    ret.m_nbBytes += NODE_SIZE + memory::getHeapSize(nameToPlayer.first);
+  });
+  return ret;
+}
+
 std::vector<std::unique_ptr<Player>> PlayerCache::extractPlayers() {
   const std::scoped_lock lock(m_pImpl->m_mutex);
   std::vector<std::unique_ptr<Player>> ret;
@@ -1,6 +1,7 @@
 #pragma once
 
-#include <memory> // std::unique_ptr
+#include "language/MemoryUsage.hpp" // MemoryUsage
+#include <memory>                     // std::unique_ptr
 #include <string_view>
 #include <vector>
 
@@ -24,4 +25,8 @@ public:
   void addIfMissing(std::string_view playerName) const;
   [[nodiscard]] std::vector<std::unique_ptr<Player>> extractPlayers();
   [[nodiscard]] bool isEmpty() const;
+  /**
+   * @returns an estimate of the memory held by the cached players. Thread safe.
+   */
+  [[nodiscard]] MemoryUsage getMemoryUsage() const;
 }; // class PlayerCache
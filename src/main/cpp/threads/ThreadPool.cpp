@@ -0,0 +1,153 @@
+#include "log/Logger.hpp"          // CURRENT_FILE_NAME, fmt::format_to
+#include "log/Metrics.hpp"         // Metrics
+#include "threads/ThreadPool.hpp" // ThreadPool, std::chrono, std::string, std::string_view
+#include <array>
+#include <atomic>
+
+static Logger& LOG() {
+  static auto logger = Logger(CURRENT_FILE_NAME);
+  return logger;
+}
+
+namespace {
+  using ThreadPool::TaskCategory;
+
+  constexpr std::array CATEGORIES {TaskCategory::importParse, TaskCategory::dbSave,
+                                   TaskCategory::statsRead, TaskCategory::periodic,
+                                   TaskCategory::other};
+
+  struct [[nodiscard]] CategoryStatistics final {
+    // Memory layout optimized: largest to smallest to minimize padding
+    std::atomic<std::int64_t> m_totalWaitMicros {0};
+    std::atomic<std::int64_t> m_maxWaitMicros {0};
+    std::atomic<std::int64_t> m_totalRunMicros {0};
+    std::atomic<std::int64_t> m_maxRunMicros {0};
+    std::atomic<std::uint64_t> m_nbCompleted {0};
+    std::atomic<std::int64_t> m_nbQueued {0};
+    std::atomic<std::int64_t> m_nbRunning {0};
+    // exported series, as the statistics above
+    Metrics::Histogram& m_waitTime;
+    Metrics::Histogram& m_runTime;
+    Metrics::Gauge& m_nbQueuedTasks;
+    Metrics::Gauge& m_nbRunningTasks;
+
+    explicit CategoryStatistics(TaskCategory category)
+      : m_waitTime {Metrics::getHistogram("phud_task_wait_seconds",
+                                          "Duration of the tasks in the thread pool queue.",
+                                          Metrics::toLabel("category", toString(category)))},
+        m_runTime {Metrics::getHistogram("phud_task_run_seconds",
+                                         "Duration of the tasks run by the thread pool.",
+                                         Metrics::toLabel("category", toString(category)))},
+        m_nbQueuedTasks {Metrics::getGauge("phud_tasks_queued",
+                                           "Number of tasks waiting for a thread pool worker.",
+                                           Metrics::toLabel("category", toString(category)))},
+        m_nbRunningTasks {Metrics::getGauge("phud_tasks_running",
+                                            "Number of tasks run by the thread pool.",
+                                            Metrics::toLabel("category", toString(category)))} {}
+  }; // struct CategoryStatistics
+
+  // intentional leak to avoid exit-time destructor warning, tasks can run until the exit
+  [[nodiscard]] CategoryStatistics& getStatistics(TaskCategory category) {
+    static auto* instance {new std::array<CategoryStatistics, CATEGORIES.size()> {
+        CategoryStatistics(CATEGORIES[0]), CategoryStatistics(CATEGORIES[1]),
+        CategoryStatistics(CATEGORIES[2]), CategoryStatistics(CATEGORIES[3]),
+        CategoryStatistics(CATEGORIES[4])}};
+    return (*instance)[static_cast<std::size_t>(category)];
+  }
+
+  void updateMax(std::atomic<std::int64_t>& max, std::int64_t value) noexcept {
+    auto current {max.load(std::memory_order_relaxed)};
+
+    while (current < value and
+           !max.compare_exchange_weak(current, value, std::memory_order_relaxed)) {}
+  }
+
+  [[nodiscard]] std::int64_t toMicros(std::chrono::steady_clock::duration d) noexcept {
+    return std::chrono::duration_cast<std::chrono::microseconds>(d).count();
+  }
+} // anonymous namespace
+
+/*[[nodiscard]]*/ std::string_view ThreadPool::toString(TaskCategory category) noexcept {
+  switch (category) {
+    case TaskCategory::importParse: return "import-parse";
+    case TaskCategory::dbSave: return "db-save";
+    case TaskCategory::statsRead: return "stats-read";
+    case TaskCategory::periodic: return "periodic";
+    case TaskCategory::other: return "other";
+  }
+
+  return "unknown";
+}
+
+void ThreadPool::TaskRecorder::onQueued(TaskCategory category) noexcept {
+  auto& stats {getStatistics(category)};
+  stats.m_nbQueued.fetch_add(1, std::memory_order_relaxed);
+  stats.m_nbQueuedTasks.add(1);
+}
+
+ThreadPool::TaskRecorder::TaskRecorder(
+    TaskCategory category, std::optional<std::chrono::steady_clock::time_point> submitTime)
+  : m_start {std::chrono::steady_clock::now()},
+    m_category {category} {
+  auto& stats {getStatistics(category)};
+
+  if (submitTime.has_value()) {
+    const auto wait {m_start - submitTime.value()};
+    stats.m_nbQueued.fetch_sub(1, std::memory_order_relaxed);
+    stats.m_nbQueuedTasks.add(-1);
+    stats.m_totalWaitMicros.fetch_add(toMicros(wait), std::memory_order_relaxed);
+    updateMax(stats.m_maxWaitMicros, toMicros(wait));
+    stats.m_waitTime.observe(wait);
+  }
+
+  stats.m_nbRunning.fetch_add(1, std::memory_order_relaxed);
+  stats.m_nbRunningTasks.add(1);
+}
+
+ThreadPool::TaskRecorder::~TaskRecorder() {
+  const auto run {std::chrono::steady_clock::now() - m_start};
+  auto& stats {getStatistics(m_category)};
+  stats.m_nbRunning.fetch_sub(1, std::memory_order_relaxed);
+  stats.m_nbRunningTasks.add(-1);
+  stats.m_totalRunMicros.fetch_add(toMicros(run), std::memory_order_relaxed);
+  updateMax(stats.m_maxRunMicros, toMicros(run));
+  stats.m_runTime.observe(run);
+  stats.m_nbCompleted.fetch_add(1, std::memory_order_relaxed);
+}
+
+/*[[nodiscard]]*/ ThreadPool::TaskStatistics
+ThreadPool::getTaskStatistics(TaskCategory category) noexcept {
+  const auto& stats {getStatistics(category)};
+  const auto get = [](const auto& atomicValue) {
+    return atomicValue.load(std::memory_order_relaxed);
+  };
+  return {.m_totalWaitTime = std::chrono::microseconds(get(stats.m_totalWaitMicros)),
+          .m_maxWaitTime = std::chrono::microseconds(get(stats.m_maxWaitMicros)),
+          .m_totalRunTime = std::chrono::microseconds(get(stats.m_totalRunMicros)),
+          .m_maxRunTime = std::chrono::microseconds(get(stats.m_maxRunMicros)),
+          .m_nbCompleted = get(stats.m_nbCompleted),
+          .m_nbQueued = get(stats.m_nbQueued),
+          .m_nbRunning = get(stats.m_nbRunning)};
+}
+
+/*[[nodiscard]]*/ std::string ThreadPool::getTaskStatisticsAsString() {
+  std::string ret;
+  auto out {std::back_inserter(ret)};
+  fmt::format_to(out, "{:<14} {:>7} {:>7} {:>10} {:>14} {:>14} {:>14} {:>14}\n", "category",
+                 "queued", "running", "completed", "wait (ms)", "max wait (ms)", "run (ms)",
+                 "max run (ms)");
+  std::ranges::for_each(CATEGORIES, [&out](TaskCategory category) {
+    const auto s {getTaskStatistics(category)};
+    const auto toMillis = [](std::chrono::microseconds us) { return us.count() / 1000.0; };
+    fmt::format_to(out, "{:<14} {:>7} {:>7} {:>10} {:>14.3f} {:>14.3f} {:>14.3f} {:>14.3f}\n",
+                   toString(category), s.m_nbQueued, s.m_nbRunning, s.m_nbCompleted,
+                   toMillis(s.m_totalWaitTime), toMillis(s.m_maxWaitTime),
+                   toMillis(s.m_totalRunTime), toMillis(s.m_maxRunTime));
+  });
+  return ret;
+}
+
+void ThreadPool::stop() {
+  stlab::pre_exit();
+  LOG().info<"Thread pool tasks:\n{}">(getTaskStatisticsAsString());
+}
@@ -2,17 +2,116 @@
 
 #include <stlab/concurrency/future.hpp> // stlab::async, std::forward
 #include <stlab/concurrency/default_executor.hpp>
+#include <chrono>
+#include <cstdint>    // std::uint64_t
+#include <functional> // std::invoke
+#include <optional>
+#include <string>
+#include <string_view>
 
 template <typename T>
 using Future = stlab::future<T>;
 
 namespace ThreadPool {
+  /**
+   * What a task does, to tell which kind of task occupies the pool.
+   */
+  enum class /*[[nodiscard]]*/ TaskCategory : short {
+    importParse, // parsing of history files
+    dbSave,      // saving into the database
+    statsRead,   // reading statistics from the database
+    periodic,    // a PeriodicTask loop, occupying a worker as long as it runs
+    other
+  };
+
+  [[nodiscard]] std::string_view toString(TaskCategory category) noexcept;
+
+  /**
+   * The telemetry of the tasks of a category, since the program start.
+   */
+  struct [[nodiscard]] TaskStatistics final {
+    // Memory layout optimized: largest to smallest to minimize padding
+    std::chrono::microseconds m_totalWaitTime; // from the submission to the start
+    std::chrono::microseconds m_maxWaitTime;
+    std::chrono::microseconds m_totalRunTime;
+    std::chrono::microseconds m_maxRunTime;
+    std::uint64_t m_nbCompleted;
+    std::int64_t m_nbQueued;
+    std::int64_t m_nbRunning;
+  }; // struct TaskStatistics
+
+  /**
+   * @returns the telemetry of the given category. Thread safe.
+   */
+  [[nodiscard]] TaskStatistics getTaskStatistics(TaskCategory category) noexcept;
+
+  /**
+   * @returns the telemetry of each category, one line per category.
+   */
+  [[nodiscard]] std::string getTaskStatisticsAsString();
+
+  /**
+   * Records the telemetry of a task while it runs.
+   */
+  class [[nodiscard]] TaskRecorder final {
+  private:
+    std::chrono::steady_clock::time_point m_start;
+    TaskCategory m_category;
+
+  public:
+    /**
+     * @param submitTime when the task was queued, nothing if the task was not queued by submit()
+     */
+    TaskRecorder(TaskCategory category,
+                 std::optional<std::chrono::steady_clock::time_point> submitTime);
+    TaskRecorder(const TaskRecorder&) = delete;
+    TaskRecorder(TaskRecorder&&) = delete;
+    TaskRecorder& operator=(const TaskRecorder&) = delete;
+    TaskRecorder& operator=(TaskRecorder&&) = delete;
+    ~TaskRecorder();
+
+    // counts a task as queued, to be called before creating its TaskRecorder
+    static void onQueued(TaskCategory category) noexcept;
+  }; // class TaskRecorder
+
+  /**
+   * Runs the given function in the thread pool, recording its queue wait and run times under the
+   * given category.
+   */
+  template <typename F, typename... ARGS>
+  [[nodiscard]] Future<std::invoke_result_t<F, ARGS...>> submit(TaskCategory category, F&& f,
+                                                                ARGS&&... args) {
+    TaskRecorder::onQueued(category);
+    return stlab::async(
+        stlab::default_executor,
+        [category, submitTime = std::chrono::steady_clock::now(),
+         fn = std::forward<F>(f)]<typename... A>(A&&... a) mutable {
+          const TaskRecorder recorder {category, submitTime};
+          return std::invoke(fn, std::forward<A>(a)...);
+        },
+        std::forward<ARGS>(args)...);
+  }
+
   template <typename F, typename... ARGS>
   [[nodiscard]] Future<std::invoke_result_t<F, ARGS...>> submit(F&& f, ARGS&&... args) {
-    return stlab::async(stlab::default_executor, std::forward<F>(f), std::forward<ARGS>(args)...);
+    return submit(TaskCategory::other, std::forward<F>(f), std::forward<ARGS>(args)...);
   }
 
-  inline void stop() {
-    stlab::pre_exit();
+  /**
+   * @returns the given function, recording its run time under the given category. To be used for
+   * the continuations, which are not queued by submit(), e.g.
+   * future.then(ThreadPool::recorded(TaskCategory::dbSave, [](...) { ... }))
+   */
+  template <typename F>
+  [[nodiscard]] auto recorded(TaskCategory category, F&& f) {
+    return [category, fn = std::forward<F>(f)]<typename... A>(A&&... a) mutable {
+      const TaskRecorder recorder {category, std::nullopt};
+      return std::invoke(fn, std::forward<A>(a)...);
+    };
   }
+
+  /**
+   * Waits for the running tasks and logs the telemetry of the tasks.
+   */
+  void stop();
 } // namespace ThreadPool
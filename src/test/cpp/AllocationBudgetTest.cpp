@@ -0,0 +1,128 @@
+#include "TestInfrastructure.hpp"         // BOOST_* macros, phud::test::*
+#include "AllocationCounter.hpp"          // AllocationCounter
+#include "constants/ProgramInfos.hpp"     // WINAMAX_SITE_NAME
+#include "db/Database.hpp"                // Database
+#include "entities/Game.hpp"              // Tournament
+#include "entities/Hand.hpp"              // Hand
+#include "entities/Site.hpp"              // Site
+#include "filesystem/FileUtils.hpp"       // phud::filesystem::*
+#include "filesystem/TextFile.hpp"        // TextFile
+#include "gui/TableService.hpp"           // TableService
+#include "history/PokerSiteHistory.hpp"     // PokerSiteHistory
+#include "history/WinamaxHandBuilder.hpp"   // WinamaxHandBuilder
+#include "history/WinamaxHandGenerator.hpp" // WinamaxHandGenerator
+#include "history/WinamaxHistory.hpp"       // WinamaxHistory
+#include "statistics/TableStatistics.hpp"   // TableStatistics
+#include "threads/PlayerCache.hpp"          // PlayerCache
+#include <ranges>
+
+namespace pf = phud::filesystem;
+namespace pt = phud::test;
+
+/*
+ * The number of heap allocations allowed for each operation of the live reload path, measured
+ * with some margin. A change that allocates for each line or each action exceeds them.
+ * The checked iterators of MSVC allocate a proxy for each container, hence the factor.
+ */
+namespace {
+#if defined(_ITERATOR_DEBUG_LEVEL) and 0 < _ITERATOR_DEBUG_LEVEL
+  constexpr std::size_t BUDGET_FACTOR {3};
+#else
+  constexpr std::size_t BUDGET_FACTOR {1};
+#endif
+  // reading a whole file only grows the line buffer a few times
+  constexpr std::size_t TEXT_FILE_NEXT_BUDGET {8 * BUDGET_FACTOR};
+  // a hand of 9 players and 12 actions
+  constexpr std::size_t BUILD_HAND_BUDGET {200 * BUDGET_FACTOR};
+  // a table of 6 players
+  constexpr std::size_t READ_TABLE_STATISTICS_BUDGET {32 * BUDGET_FACTOR};
+  // the history file is reloaded entirely, so this is the reload of a 5 hands file
+  constexpr std::size_t TABLE_SERVICE_RELOAD_BUDGET {2'000 * BUDGET_FACTOR};
+} // anonymous namespace
+
+BOOST_AUTO_TEST_SUITE(AllocationBudgetTest)
+
+BOOST_AUTO_TEST_CASE(AllocationBudgetTest_textFileNextShouldNotAllocateForEachLine) {
+  TextFile tf {pt::getFileFromTestResources(
+      "Winamax/simpleTHisto/history/20160331_Kill The Fish(152800689)_real_holdem_no-limit.txt")};
+  const AllocationCounter counter;
+  std::size_t nbLines = 0;
+
+  while (tf.next()) {
+    ++nbLines;
+  }
+
+  BOOST_REQUIRE(1'000 < nbLines);
+  BOOST_REQUIRE(TEXT_FILE_NEXT_BUDGET >= counter.getNbAllocations());
+}
+
+BOOST_AUTO_TEST_CASE(AllocationBudgetTest_buildHandShouldStayWithinItsBudget) {
+  const auto file {pt::getFileFromTestResources(
+      "Winamax/hands/20141119_Freeroll(99427750)_real_holdem_no-limit.txt")};
+  PlayerCache cache {ProgramInfos::WINAMAX_SITE_NAME};
+  {
+    // the players are already known on the live path
+    TextFile tf {file};
+    tf.next();
+    BOOST_REQUIRE(nullptr != WinamaxHandBuilder::buildHand<Tournament>(tf, cache));
+  }
+  TextFile tf {file};
+  tf.next();
+  const AllocationCounter counter;
+  const auto pHand {WinamaxHandBuilder::buildHand<Tournament>(tf, cache)};
+  const auto nbAllocations {counter.getNbAllocations()};
+  BOOST_REQUIRE(12 == pHand->viewActions().size());
+  BOOST_REQUIRE_MESSAGE(BUILD_HAND_BUDGET >= nbAllocations,
+                        nbAllocations << " allocations to build a hand");
+}
+
+BOOST_AUTO_TEST_CASE(AllocationBudgetTest_readTableStatisticsShouldStayWithinItsBudget) {
+  const auto pSite {PokerSiteHistory::load(pt::getDirFromTestResources("Winamax/simpleTHisto"))};
+  Database db;
+  db.save(*pSite);
+  constexpr std::string_view TABLE {"Kill The Fish(152800689)#004"};
+  // the first read prepares the statements
+  BOOST_REQUIRE(db.readTableStatistics(ProgramInfos::WINAMAX_SITE_NAME, TABLE).isValid());
+  const AllocationCounter counter;
+  const auto stats {db.readTableStatistics(ProgramInfos::WINAMAX_SITE_NAME, TABLE)};
+  const auto nbAllocations {counter.getNbAllocations()};
+  BOOST_REQUIRE(stats.isValid());
+  BOOST_REQUIRE_MESSAGE(READ_TABLE_STATISTICS_BUDGET >= nbAllocations,
+                        nbAllocations << " allocations to read the table statistics");
+}
+
+BOOST_AUTO_TEST_CASE(AllocationBudgetTest_tableServiceReloadShouldStayWithinItsBudget) {
+  const auto hands {WinamaxHandGenerator::splitHands(pf::readToString(pt::getFileFromTestResources(
+      "Winamax/simpleCGHisto/history/20150309_Colorado 1_real_holdem_no-limit.txt")))};
+  BOOST_REQUIRE(5 == hands.size());
+  const pt::TmpDir root {"AllocationBudgetTest_tableServiceReloadShouldStayWithinItsBudget"};
+  const pt::TmpDir dir {root / "history"};
+  const pt::TmpFile file {dir / "20150309_Colorado 1_real_holdem_no-limit.txt"};
+  std::ranges::for_each(hands | std::views::take(4), [&](const auto& hand) { file.print(hand); });
+  Database db;
+  TableService service {db};
+  service.setPokerSiteHistory(std::make_shared<WinamaxHistory>());
+  service.setHistoryDir(root.path());
+  pt::Notifications notifications {1};
+  const pt::LogDisabler _;
+  BOOST_REQUIRE(service
+                    .startProducingStats("Winamax Colorado 1 / 0,01-0,02 NL Holdem",
+                                         [&notifications](TableStatistics&&) {
+                                           notifications.notify(0);
+                                         })
+                    .empty());
+  // the initial reload registers the metrics and prepares the statements
+  BOOST_REQUIRE(notifications.waitFor(0, 1));
+  const AllocationCounter counter {AllocationCounter::Scope::allThreads};
+  // the allocations done until the notification, read under the lock of the notifications
+  std::size_t nbAllocations = 0;
+  notifications.setOnNotify([&] { nbAllocations = counter.getNbAllocations(); });
+  const auto nbNotifications {notifications.getNbNotifications(0)};
+  file.print(hands[4]);
+  BOOST_REQUIRE(notifications.waitFor(0, nbNotifications + 1));
+  service.stopProducingStats();
+  BOOST_REQUIRE_MESSAGE(TABLE_SERVICE_RELOAD_BUDGET >= nbAllocations,
+                        nbAllocations << " allocations to reload a table");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
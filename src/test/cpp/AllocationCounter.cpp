@@ -0,0 +1,54 @@
+#include "AllocationCounter.hpp"
+#include <atomic>
+#include <cstdlib> // std::malloc, std::free
+#include <new>     // std::bad_alloc
+
+namespace {
+  // the counters must not allocate, as they are updated by the allocation functions
+  std::atomic<std::size_t> nbAllocations {0};
+  std::atomic<std::size_t> nbBytes {0};
+  thread_local std::size_t nbThreadAllocations {0};
+  thread_local std::size_t nbThreadBytes {0};
+
+  [[nodiscard]] std::size_t getNbAllocations(AllocationCounter::Scope scope) noexcept {
+    return AllocationCounter::Scope::thisThread == scope
+               ? nbThreadAllocations
+               : nbAllocations.load(std::memory_order_relaxed);
+  }
+
+  [[nodiscard]] std::size_t getNbBytes(AllocationCounter::Scope scope) noexcept {
+    return AllocationCounter::Scope::thisThread == scope ? nbThreadBytes
+                                                         : nbBytes.load(std::memory_order_relaxed);
+  }
+} // anonymous namespace
+
+// the other forms of operator new and delete call those ones
+void* operator new(std::size_t size) {
+  nbAllocations.fetch_add(1, std::memory_order_relaxed);
+  nbBytes.fetch_add(size, std::memory_order_relaxed);
+  ++nbThreadAllocations;
+  nbThreadBytes += size;
+
+  if (auto* p = std::malloc(0 == size ? 1 : size); nullptr != p) {
+    return p;
+  }
+
+  throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+
+void operator delete(void* p, std::size_t /*size*/) noexcept { std::free(p); }
+
+AllocationCounter::AllocationCounter(Scope scope) noexcept
+  : m_nbAllocationsAtStart {::getNbAllocations(scope)},
+    m_nbBytesAtStart {::getNbBytes(scope)},
+    m_scope {scope} {}
+
+/*[[nodiscard]]*/ std::size_t AllocationCounter::getNbAllocations() const noexcept {
+  return ::getNbAllocations(m_scope) - m_nbAllocationsAtStart;
+}
+
+/*[[nodiscard]]*/ std::size_t AllocationCounter::getNbBytes() const noexcept {
+  return ::getNbBytes(m_scope) - m_nbBytesAtStart;
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstddef> // std::size_t
+
+/**
+ * Counts the heap allocations done through the global operator new while it is alive. The
+ * unitTests executable replaces the global allocation functions to do so.
+ */
+class [[nodiscard]] AllocationCounter final {
+public:
+  enum class /*[[nodiscard]]*/ Scope : short {
+    thisThread, // counts the allocations of the thread that created the counter
+    allThreads  // counts the allocations of every thread, e.g. those of the thread pool
+  };
+
+private:
+  std::size_t m_nbAllocationsAtStart;
+  std::size_t m_nbBytesAtStart;
+  Scope m_scope;
+
+public:
+  explicit AllocationCounter(Scope scope = Scope::thisThread) noexcept;
+  AllocationCounter(const AllocationCounter&) = delete;
+  AllocationCounter(AllocationCounter&&) = delete;
+  AllocationCounter& operator=(const AllocationCounter&) = delete;
+  AllocationCounter& operator=(AllocationCounter&&) = delete;
+  ~AllocationCounter() = default;
+
+  /**
+   * @returns the number of allocations done since the counter creation
+   */
+  [[nodiscard]] std::size_t getNbAllocations() const noexcept;
+
+  /**
+   * @returns the number of bytes allocated since the counter creation
+   */
+  [[nodiscard]] std::size_t getNbBytes() const noexcept;
+}; // class AllocationCounter
@@ -1,5 +1,6 @@
 #include "TestInfrastructure.hpp"
 #include "db/Database.hpp"
+#include "db/SqlProfiler.hpp" // SqlStatementProfile
 #include "entities/Game.hpp"
 #include "entities/Player.hpp"
 #include "entities/Seat.hpp"
@@ -7,7 +8,8 @@
 #include "filesystem/FileUtils.hpp" // phud::filesystem
 #include "history/PokerSiteHistory.hpp"
 #include "constants/ProgramInfos.hpp"
-#include <gsl/gsl> // gsl::finally
+#include <gsl/gsl>   // gsl::finally
+#include <sqlite3.h> // sqlite3*
 
 namespace fs = std::filesystem;
 namespace pt = phud::test;
@@ -68,6 +70,104 @@ BOOST_AUTO_TEST_CASE(DatabaseTest_shouldGetCorrectTableMaxSeat) {
                                                     "Kill The Fish(152800689)#004"));
 }
 
+BOOST_AUTO_TEST_CASE(DatabaseTest_profilingShouldRecordEachLogicalStatement) {
+  const auto pSite = PokerSiteHistory::load(pt::getDirFromTestResources("Winamax/simpleCGHisto"));
+  BOOST_REQUIRE(nullptr != pSite);
+  Database db;
+  BOOST_REQUIRE(db.getSqlProfiles().empty());
+  db.enableSqlProfiling();
+  db.save(*pSite->viewCashGames().front());
+  std::ignore = db.getTableMaxSeat(ProgramInfos::WINAMAX_SITE_NAME, "Colorado 1");
+  const auto& profiles {db.getSqlProfiles()};
+  const auto getProfile = [&profiles](std::string_view name) {
+    const auto it {std::ranges::find(profiles, name, &SqlStatementProfile::m_name)};
+    BOOST_REQUIRE(profiles.end() != it);
+    return *it;
+  };
+  BOOST_REQUIRE(5 == getProfile("INSERT_HAND").m_nbRows);
+  BOOST_REQUIRE(1 == getProfile("INSERT_HAND").m_nbCalls);
+  BOOST_REQUIRE(1 == getProfile("GET_MAX_SEATS_BY_SITE_AND_TABLE_NAME").m_nbCalls);
+  BOOST_REQUIRE(1 == getProfile("GET_MAX_SEATS_BY_SITE_AND_TABLE_NAME").m_nbRows);
+  BOOST_REQUIRE(
+      std::ranges::is_sorted(profiles, std::greater {}, &SqlStatementProfile::m_totalTime));
+}
+
+BOOST_AUTO_TEST_CASE(DatabaseTest_savingTheSameHandsAgainShouldNotAddHands) {
+  const auto pSite = PokerSiteHistory::load(pt::getDirFromTestResources("Winamax/simpleCGHisto"));
+  Database db;
+  BOOST_REQUIRE(0 == db.getNbHands());
+  db.save(*pSite);
+  const auto nbHands {db.getNbHands()};
+  const auto nbActions {db.getNbActions()};
+  BOOST_REQUIRE(0 < nbHands);
+  BOOST_REQUIRE(0 < nbActions);
+  db.save(*pSite);
+  BOOST_REQUIRE(nbHands == db.getNbHands());
+  BOOST_REQUIRE(nbActions == db.getNbActions());
+}
+
+BOOST_AUTO_TEST_CASE(DatabaseTest_openingAnOlderDatabaseShouldRemoveTheDuplicatedActions) {
+  const auto pSite = PokerSiteHistory::load(pt::getDirFromTestResources("Winamax/simpleCGHisto"));
+  const pt::TmpDir tmpDir {"DatabaseTest_openingAnOlderDatabaseShouldRemoveTheDuplicatedActions"};
+  const auto dbFile {tmpDir / "phud.db"};
+  std::size_t nbActions {0};
+  {
+    Database db {dbFile};
+    db.save(*pSite);
+    nbActions = db.getNbActions();
+  }
+  // an older database has no unique index, so saving the same hands again duplicated the actions
+  sqlite3* pDb {nullptr};
+  BOOST_REQUIRE(SQLITE_OK == sqlite3_open(dbFile.c_str(), &pDb));
+  BOOST_REQUIRE(SQLITE_OK == sqlite3_exec(pDb, R"raw(
+DROP INDEX ActionByHand;
+INSERT INTO Action (street, handId, playerName, actionType, actionIndex, betAmount)
+  SELECT street, handId, playerName, actionType, actionIndex, betAmount FROM Action;
+)raw",
+                                          nullptr, nullptr, nullptr));
+  BOOST_REQUIRE(SQLITE_OK == sqlite3_close(pDb));
+  Database db {dbFile};
+  BOOST_REQUIRE(nbActions == db.getNbActions());
+  db.save(*pSite);
+  BOOST_REQUIRE(nbActions == db.getNbActions());
+}
+
+BOOST_AUTO_TEST_CASE(DatabaseTest_savingASiteShouldCallTheSiteObservers) {
+  const auto pSite = PokerSiteHistory::load(pt::getDirFromTestResources("Winamax/simpleCGHisto"));
+  Database db;
+  std::vector<std::size_t> nbHandsBySave;
+  const auto observerId {db.addSiteObserver(
+      [&nbHandsBySave](const Site& site) { nbHandsBySave.push_back(site.getNbHands()); })};
+  db.save(*pSite);
+  BOOST_REQUIRE((std::vector {pSite->getNbHands()}) == nbHandsBySave);
+  db.removeSiteObserver(observerId);
+  db.save(*pSite);
+  BOOST_REQUIRE(1 == nbHandsBySave.size());
+}
+
+BOOST_AUTO_TEST_CASE(DatabaseTest_historyFileStampsShouldBeReplacedBySavingThemAgain) {
+  Database db;
+  BOOST_REQUIRE(db.readHistoryFileStamps().empty());
+  const std::vector<HistoryFileStamp> stamps {
+      {.m_fileName = "20150309_Colorado 1_real_holdem_no-limit.txt",
+       .m_size = 1234,
+       .m_lastWriteTime = 5678},
+      {.m_fileName = "20150309_Player's table_real_holdem_no-limit.txt",
+       .m_size = 4321,
+       .m_lastWriteTime = 8765}};
+  db.save(stamps);
+  auto read {db.readHistoryFileStamps()};
+  std::ranges::sort(read, {}, &HistoryFileStamp::m_fileName);
+  BOOST_REQUIRE(stamps == read);
+  const std::vector<HistoryFileStamp> changed {{.m_fileName = stamps[0].m_fileName,
+                                                .m_size = 2345,
+                                                .m_lastWriteTime = 6789}};
+  db.save(changed);
+  read = db.readHistoryFileStamps();
+  std::ranges::sort(read, {}, &HistoryFileStamp::m_fileName);
+  BOOST_REQUIRE((std::vector<HistoryFileStamp> {changed[0], stamps[1]}) == read);
+}
+
 BOOST_AUTO_TEST_CASE(DatabaseTest_creatingInMemoryDatabaseShouldNotCreateFile) {
   Database inMemoryDb;
   BOOST_REQUIRE(!pf::isFile(fs::path(inMemoryDb.getDbName())));
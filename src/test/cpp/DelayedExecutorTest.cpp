@@ -0,0 +1,56 @@
+#include "TestInfrastructure.hpp"
+#include "threads/DelayedExecutor.hpp"
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
+namespace {
+  constexpr std::chrono::seconds CALL_TIMEOUT {5};
+
+  // the ids of the called callbacks, in the order of their calls
+  class [[nodiscard]] Calls final {
+  private:
+    // Memory layout optimized: largest to smallest to minimize padding
+    std::condition_variable m_cv {};
+    std::mutex m_mutex {};
+    std::vector<int> m_ids {};
+
+  public:
+    void add(int id) {
+      const std::scoped_lock lock {m_mutex};
+      m_ids.push_back(id);
+      m_cv.notify_all();
+    }
+
+    [[nodiscard]] std::vector<int> waitFor(std::size_t nbCalls) {
+      std::unique_lock lock {m_mutex};
+      m_cv.wait_for(lock, CALL_TIMEOUT, [&] { return nbCalls <= m_ids.size(); });
+      return m_ids;
+    }
+  }; // class Calls
+} // anonymous namespace
+
+BOOST_AUTO_TEST_SUITE(DelayedExecutorTest)
+
+BOOST_AUTO_TEST_CASE(DelayedExecutorTest_callbacksShouldBeCalledInTheOrderOfTheirExpiry) {
+  Calls calls;
+  const DelayedExecutor executor;
+  const auto start {std::chrono::steady_clock::now()};
+  executor.executeAfter(std::chrono::milliseconds {200}, [&calls] { calls.add(2); });
+  executor.executeAfter(std::chrono::milliseconds {50}, [&calls] { calls.add(1); });
+  BOOST_REQUIRE((std::vector {1, 2}) == calls.waitFor(2));
+  BOOST_REQUIRE(std::chrono::milliseconds {200} <= std::chrono::steady_clock::now() - start);
+}
+
+BOOST_AUTO_TEST_CASE(DelayedExecutorTest_destroyingShouldCallTheWaitingCallbacksAtOnce) {
+  Calls calls;
+  const auto start {std::chrono::steady_clock::now()};
+  {
+    const DelayedExecutor executor;
+    executor.executeAfter(std::chrono::hours {1}, [&calls] { calls.add(1); });
+  }
+  BOOST_REQUIRE((std::vector {1}) == calls.waitFor(1));
+  BOOST_REQUIRE(std::chrono::steady_clock::now() - start < CALL_TIMEOUT);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -44,4 +44,34 @@ BOOST_AUTO_TEST_CASE(DirWatcherTest_DetectingChangedFilesShouldWork) {
   BOOST_REQUIRE(tmpFile.path().stem().string() == changedFiles.front());
 }
 
+BOOST_AUTO_TEST_CASE(DirWatcherTest_PollingShouldDetectTheAddedAndModifiedFiles) {
+  const pt::TmpDir tmpDir("DirWatcherTest_PollingShouldDetectTheAddedAndModifiedFiles_tmpDir");
+  const pt::TmpFile tmpFile(tmpDir / "someTmpFile.txt");
+  tmpFile.print("yop");
+  const auto dw = DirWatcher::create(tmpDir.path(), DirWatcher::Backend::polling);
+  std::vector<std::string> changedFiles;
+  std::condition_variable cv;
+  std::mutex mutex;
+  dw->start([&cv, &mutex, &changedFiles](const fs::path& file) {
+    std::lock_guard<std::mutex> lock(mutex);
+    changedFiles.push_back(file.stem().string());
+    cv.notify_one();
+  });
+  auto tb =
+      TimeBomb::create(TB_PERIOD, "DirWatcherTest_PollingShouldDetectTheAddedAndModifiedFiles");
+  tmpFile.print("yip");
+  const pt::TmpFile addedFile(tmpDir / "someAddedFile.txt");
+  const pt::TmpFile ignoredFile(tmpDir / "someIgnoredFile.dat");
+
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    cv.wait_for(lock, std::chrono::seconds(2), [&]() { return 2 <= changedFiles.size(); });
+  }
+
+  dw->stop();
+  BOOST_REQUIRE(dw->isStopped());
+  std::ranges::sort(changedFiles);
+  BOOST_REQUIRE((std::vector<std::string> {"someAddedFile", "someTmpFile"}) == changedFiles);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
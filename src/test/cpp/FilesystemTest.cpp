@@ -41,6 +41,21 @@ BOOST_AUTO_TEST_CASE(FilesystemTest_listingSubDirShouldListOnlyDirectories) {
   BOOST_REQUIRE(pf::listSubDirs(child.path()).empty());
 }
 
+BOOST_AUTO_TEST_CASE(FilesystemTest_sortingByMostRecentFirstShouldUseTheDatePrefix) {
+  pt::TmpDir tmpDir {"FilesystemTest_sortingByMostRecentFirstShouldUseTheDatePrefix"};
+  pt::TmpFile oldFile {tmpDir / "20141031_Double or Nothing(98932321)_real_holdem_no-limit.txt"};
+  pt::TmpFile newFile {tmpDir / "20250924_Wichita 08_real_holdem_no-limit.txt"};
+  pt::TmpFile middleFile {tmpDir / "20160331_Kill The Fish(152800689)_real_holdem_no-limit.txt"};
+  oldFile.print("yop");
+  newFile.print("yop");
+  middleFile.print("yop");
+  const auto files {pf::sortByMostRecentFirst(pf::listTxtFilesInDir(tmpDir.path()))};
+  BOOST_REQUIRE(3 == files.size());
+  BOOST_REQUIRE(newFile.path() == files[0]);
+  BOOST_REQUIRE(middleFile.path() == files[1]);
+  BOOST_REQUIRE(oldFile.path() == files[2]);
+}
+
 BOOST_AUTO_TEST_CASE(TextFileTest_readFileToStringsShouldSucceed) {
   BOOST_TEST(!pf::readToString(
                   pt::getFileFromTestResources("Winamax/sabre_laser/history/20141116_Double or "
@@ -0,0 +1,134 @@
+#include "TestInfrastructure.hpp"       // BOOST_* macros, phud::test::*
+#include "db/Database.hpp"              // Database
+#include "db/HandStore.hpp"             // HandStore
+#include "entities/Action.hpp"          // ActionType, Street
+#include "entities/Game.hpp"            // CashGame, Tournament
+#include "entities/Hand.hpp"            // Hand
+#include "entities/Site.hpp"            // Site
+#include "history/PokerSiteHistory.hpp" // PokerSiteHistory
+#include "statistics/HandReplay.hpp"    // HandReplay, PositionalStatCounters
+#include "statistics/PlayerStatistics.hpp"
+#include <unordered_map>
+
+namespace pt = phud::test;
+
+namespace {
+  [[nodiscard]] HandStore::ActionRecord newAction(HandStore::PlayerId player, Street street,
+                                                  ActionType type) {
+    return {.m_betAmount = 0,
+            .m_player = player,
+            .m_index = 0,
+            .m_street = static_cast<std::uint8_t>(street),
+            .m_type = static_cast<std::uint8_t>(type)};
+  }
+
+  void requireStat(const StatCounters& counters, Stat stat, std::uint32_t nbOccurrences,
+                   std::uint32_t nbOpportunities) {
+    BOOST_REQUIRE(nbOccurrences == counters.getNbOccurrences(stat));
+    BOOST_REQUIRE(nbOpportunities == counters.getNbOpportunities(stat));
+  }
+} // anonymous namespace
+
+BOOST_AUTO_TEST_SUITE(HandReplayTest)
+
+BOOST_AUTO_TEST_CASE(HandReplayTest_replayingAHandShouldCountTheStatsOfEachPlayer) {
+  HandStore::HandRecord hand {};
+  hand.m_seatPlayers.fill(HandStore::NO_PLAYER);
+  hand.m_seatPlayers[0] = 10;
+  hand.m_seatPlayers[1] = 11;
+  hand.m_seatPlayers[2] = 12;
+  hand.m_buttonSeat = 0;
+  // 10 opens, 11 3-bets, 12 folds, 10 calls, then 10 check-raises the continuation bet of 11
+  const std::array actions {newAction(10, Street::preflop, ActionType::raise),
+                            newAction(11, Street::preflop, ActionType::raise),
+                            newAction(12, Street::preflop, ActionType::fold),
+                            newAction(10, Street::preflop, ActionType::call),
+                            newAction(10, Street::flop, ActionType::check),
+                            newAction(11, Street::flop, ActionType::bet),
+                            newAction(10, Street::flop, ActionType::raise),
+                            newAction(11, Street::flop, ActionType::fold)};
+  const auto counters {HandReplay::replay(hand, actions)};
+  const auto& opener {counters[0]};
+  BOOST_REQUIRE(1 == opener.m_nbHands);
+  requireStat(opener, Stat::voluntaryPutMoneyInPot, 1, 1);
+  requireStat(opener, Stat::preFlopRaise, 1, 1);
+  requireStat(opener, Stat::foldToPreFlopThreeBet, 0, 1);
+  requireStat(opener, Stat::callPreFlopThreeBet, 1, 1);
+  requireStat(opener, Stat::donkBet, 0, 1);
+  requireStat(opener, Stat::flopCheckRaise, 1, 1);
+  requireStat(opener, Stat::raiseAfterFlopContinuationBet, 1, 1);
+  requireStat(opener, Stat::foldToFlopContinuationBet, 0, 1);
+  requireStat(opener, Stat::aggressionFactor, 1, 0);
+  requireStat(opener, Stat::wentToShowDown, 0, 1);
+  // the button is the 1st to act with 3 players
+  requireStat(opener, Stat::stealAttempt, 1, 1);
+  const auto& threeBettor {counters[1]};
+  requireStat(threeBettor, Stat::foldToPreFlopRaise, 0, 1);
+  requireStat(threeBettor, Stat::preFlopThreeBet, 1, 1);
+  requireStat(threeBettor, Stat::flopContinuationBet, 1, 1);
+  requireStat(threeBettor, Stat::foldToRaiseAfterFlopContinuationBet, 1, 1);
+  requireStat(threeBettor, Stat::foldToFlopCheckRaise, 1, 1);
+  requireStat(threeBettor, Stat::callFlopCheckRaise, 0, 1);
+  // the small blind re-raised the steal attempt
+  requireStat(threeBettor, Stat::foldToSteal, 0, 1);
+  const auto& folder {counters[2]};
+  requireStat(folder, Stat::voluntaryPutMoneyInPot, 0, 1);
+  // the first raise was 3-bet before the folder had to act
+  requireStat(folder, Stat::foldToPreFlopRaise, 0, 0);
+  requireStat(folder, Stat::wentToShowDown, 0, 0);
+  requireStat(folder, Stat::foldToSteal, 0, 0);
+  BOOST_REQUIRE(0 == counters[3].m_nbHands);
+  const auto positions {HandReplay::getPositions(hand)};
+  BOOST_REQUIRE(TablePosition::button == positions[0]);
+  BOOST_REQUIRE(TablePosition::smallBlind == positions[1]);
+  BOOST_REQUIRE(TablePosition::bigBlind == positions[2]);
+  PositionalStatCounters positional;
+  positional.add(positions[0], opener);
+  const PlayerStatistics stats {
+      {.playerName = "opener", .siteName = "site", .counters = positional, .isHero = false}};
+  BOOST_REQUIRE(100 == stats.getVoluntaryPutMoneyInPot());
+  BOOST_REQUIRE(100 == stats.getPreFlopRaise());
+  BOOST_REQUIRE_CLOSE(100.0, stats.getFlopCheckRaise(), 0.01);
+  BOOST_REQUIRE_CLOSE(0.0, stats.getFoldToThreeBet(), 0.01);
+  BOOST_REQUIRE_CLOSE(100.0, stats.getStealAttempt(), 0.01);
+  BOOST_REQUIRE_CLOSE(100.0, stats.getPercentage(Stat::stealAttempt, TablePosition::button), 0.01);
+  BOOST_REQUIRE_CLOSE(0.0, stats.getPercentage(Stat::stealAttempt, TablePosition::cutOff), 0.01);
+}
+
+BOOST_AUTO_TEST_CASE(HandReplayTest_replayingTheHandStoreShouldGiveTheCountersOfTheHands) {
+  const pt::TmpDir tmpDir {"HandReplayTest_replayingTheHandStoreShouldGiveTheCountersOfTheHands"};
+  const auto pSite = PokerSiteHistory::load(pt::getDirFromTestResources("Winamax/simpleTHisto"));
+  Database db {tmpDir / "phud.db"};
+  db.save(*pSite);
+  const HandStore::Reader reader {db.getHandStoreFile()};
+  const auto storeCounters {HandReplay::replay(reader)};
+  std::unordered_map<std::string, PositionalStatCounters> handCounters;
+  std::ranges::for_each(pSite->viewTournaments(), [&handCounters](const Tournament* pGame) {
+    std::ranges::for_each(pGame->viewHands(), [&handCounters](const Hand* pHand) {
+      const auto counters {HandReplay::replay(*pHand)};
+      const auto positions {HandReplay::getPositions(*pHand)};
+
+      for (std::size_t seat = 0; seat < counters.size(); ++seat) {
+        if (0 != counters[seat].m_nbHands) {
+          handCounters[pHand->getSeats()[seat]].add(positions[seat], counters[seat]);
+        }
+      }
+    });
+  });
+  BOOST_REQUIRE(reader.getNbPlayers() == storeCounters.size());
+  BOOST_REQUIRE(handCounters.size() == storeCounters.size());
+
+  for (HandStore::PlayerId id = 0; id < storeCounters.size(); ++id) {
+    BOOST_REQUIRE(handCounters.at(std::string(reader.getPlayerName(id))) == storeCounters[id]);
+  }
+
+  BOOST_REQUIRE(std::ranges::all_of(storeCounters, [](const PositionalStatCounters& positional) {
+    const auto counters {positional.getAll()};
+    return 0 == positional.get(TablePosition::bigBlind).getNbOpportunities(Stat::stealAttempt) and
+           counters.getNbOpportunities(Stat::voluntaryPutMoneyInPot) <= counters.m_nbHands and
+           counters.getNbOccurrences(Stat::preFlopRaise) <=
+               counters.getNbOccurrences(Stat::voluntaryPutMoneyInPot);
+  }));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,127 @@
+#include "TestInfrastructure.hpp" // BOOST_* macros, phud::test::*
+#include "db/Database.hpp"
+#include "db/HandStore.hpp"
+#include "entities/Site.hpp"
+#include "history/PokerSiteHistory.hpp"
+#include <algorithm> // std::ranges::equal
+#include <array>
+#include <fstream> // std::ofstream
+#include <numeric> // std::transform_reduce
+#include <unordered_set>
+
+namespace pt = phud::test;
+
+[[nodiscard]] static std::size_t countActions(const HandStore::Reader& reader) {
+  return std::transform_reduce(reader.viewHands().begin(), reader.viewHands().end(),
+                               std::size_t {0}, std::plus {},
+                               [&reader](const auto& h) { return reader.viewActions(h).size(); });
+}
+
+BOOST_AUTO_TEST_SUITE(HandStoreTest)
+
+BOOST_AUTO_TEST_CASE(HandStoreTest_savingASiteShouldWriteEachHandOnce) {
+  pt::TmpDir tmpDir {"HandStoreTest_savingASiteShouldWriteEachHandOnce"};
+  const auto pSite = PokerSiteHistory::load(pt::getDirFromTestResources("Winamax/simpleTHisto"));
+  Database db {tmpDir / "phud.db"};
+  db.save(*pSite);
+  db.save(*pSite);
+  const HandStore::Reader reader {db.getHandStoreFile()};
+  BOOST_REQUIRE(216 == reader.viewHands().size());
+  BOOST_REQUIRE(30 == reader.getNbPlayers());
+  BOOST_REQUIRE(0 < countActions(reader));
+  const auto& firstHand = reader.viewHands().front();
+  BOOST_REQUIRE(std::ranges::any_of(firstHand.m_seatPlayers, [&reader](auto id) {
+    return "lemonchelo69" == reader.getPlayerName(id);
+  }));
+  BOOST_REQUIRE(std::ranges::all_of(reader.viewActions(firstHand), [&reader](const auto& a) {
+    return !reader.getPlayerName(a.m_player).empty();
+  }));
+}
+
+BOOST_AUTO_TEST_CASE(HandStoreTest_rebuildingFromTheDatabaseShouldGiveTheSameHands) {
+  pt::TmpDir tmpDir {"HandStoreTest_rebuildingFromTheDatabaseShouldGiveTheSameHands"};
+  const auto pSite = PokerSiteHistory::load(pt::getDirFromTestResources("Winamax/simpleTHisto"));
+  Database db {tmpDir / "phud.db"};
+  db.save(*pSite);
+  std::unordered_set<std::uint64_t> savedHandIds;
+  std::size_t nbSavedActions {0};
+  {
+    const HandStore::Reader reader {db.getHandStoreFile()};
+    std::ranges::for_each(reader.viewHands(),
+                          [&](const auto& h) { savedHandIds.insert(h.m_handIdHash); });
+    nbSavedActions = countActions(reader);
+  }
+  BOOST_REQUIRE(216 == db.rebuildHandStore());
+  const HandStore::Reader reader {db.getHandStoreFile()};
+  BOOST_REQUIRE(std::ranges::all_of(reader.viewHands(), [&](const auto& h) {
+    return savedHandIds.contains(h.m_handIdHash);
+  }));
+  BOOST_REQUIRE(nbSavedActions == countActions(reader));
+}
+
+BOOST_AUTO_TEST_CASE(HandStoreTest_reopeningAfterACrashShouldDropTheIncompleteRecords) {
+  pt::TmpDir tmpDir {"HandStoreTest_reopeningAfterACrashShouldDropTheIncompleteRecords"};
+  const auto pSite = PokerSiteHistory::load(pt::getDirFromTestResources("Winamax/simpleTHisto"));
+  std::filesystem::path file;
+  {
+    Database db {tmpDir / "phud.db"};
+    db.save(*pSite);
+    file = db.getHandStoreFile();
+  }
+  // a crash while writing the actions of the last hand, then the name of a new player
+  const auto actionFile {std::filesystem::path(file).concat(".actions")};
+  std::filesystem::resize_file(actionFile, std::filesystem::file_size(actionFile) -
+                                               sizeof(HandStore::ActionRecord) - 1);
+  std::ofstream(std::filesystem::path(file).concat(".players"), std::ios::app) << "incomplete";
+  HandStore store {file};
+  BOOST_REQUIRE(215 == store.getNbHands());
+  const auto player {store.getPlayerId("newPlayer")};
+  BOOST_REQUIRE(30 == player);
+  HandStore::HandRecord hand {};
+  hand.m_handIdHash = HandStore::hashHandId("newHand");
+  hand.m_seatPlayers.fill(HandStore::NO_PLAYER);
+  hand.m_seatPlayers[0] = player;
+  const std::array actions {HandStore::ActionRecord {.m_betAmount = 0,
+                                                     .m_player = player,
+                                                     .m_index = 0,
+                                                     .m_street = 0,
+                                                     .m_type = 0}};
+  store.append(hand, actions);
+  store.flush();
+  const HandStore::Reader reader {file};
+  BOOST_REQUIRE(216 == reader.viewHands().size());
+  BOOST_REQUIRE("newPlayer" == reader.getPlayerName(player));
+  const auto newActions {reader.viewActions(reader.viewHands().back())};
+  BOOST_REQUIRE(1 == newActions.size());
+  BOOST_REQUIRE(player == newActions.front().m_player);
+}
+
+BOOST_AUTO_TEST_CASE(HandStoreTest_readingDuringAnAppendShouldNotModifyTheFiles) {
+  pt::TmpDir tmpDir {"HandStoreTest_readingDuringAnAppendShouldNotModifyTheFiles"};
+  const auto pSite = PokerSiteHistory::load(pt::getDirFromTestResources("Winamax/simpleTHisto"));
+  Database db {tmpDir / "phud.db"};
+  db.save(*pSite);
+  const auto file {db.getHandStoreFile()};
+  const std::array files {file, std::filesystem::path(file).concat(".actions"),
+                          std::filesystem::path(file).concat(".players")};
+  // the beginning of an action, of a hand and of a player name being appended
+  std::ofstream(files[1], std::ios::app | std::ios::binary) << "action";
+  std::ofstream(files[0], std::ios::app | std::ios::binary) << "hand";
+  std::ofstream(files[2], std::ios::app | std::ios::binary) << "player";
+  std::array<std::uintmax_t, 3> sizes {};
+  std::ranges::transform(files, sizes.begin(),
+                         [](const auto& f) { return std::filesystem::file_size(f); });
+  const HandStore::Reader reader {file};
+  BOOST_REQUIRE(216 == reader.viewHands().size());
+  BOOST_REQUIRE(30 == reader.getNbPlayers());
+  BOOST_REQUIRE(std::ranges::equal(files, sizes, {}, [](const auto& f) {
+    return std::filesystem::file_size(f);
+  }));
+}
+
+BOOST_AUTO_TEST_CASE(HandStoreTest_inMemoryDatabaseShouldHaveNoHandStore) {
+  Database db;
+  BOOST_REQUIRE(db.getHandStoreFile().empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,46 @@
+#include "TestInfrastructure.hpp" // BOOST_* macros
+#include "gui/HudLatency.hpp"     // ReloadTrace, HudLatency
+
+using namespace std::chrono_literals;
+
+[[nodiscard]] static ReloadTrace newReload(std::string_view table,
+                                           std::chrono::milliseconds readDuration) {
+  const auto start {std::chrono::steady_clock::now()};
+  ReloadTrace ret {table, start};
+  ret.mark(ReloadStage::fileReloaded, start + 2ms);
+  ret.mark(ReloadStage::statisticsRead, start + 2ms + readDuration);
+  ret.mark(ReloadStage::observerNotified, start + 11ms + readDuration);
+  return ret;
+}
+
+BOOST_AUTO_TEST_SUITE(HudLatencyTest)
+
+BOOST_AUTO_TEST_CASE(HudLatencyTest_reloadTraceShouldGiveTheDurationOfEachStage) {
+  const auto reload {newReload("HudLatencyTest table 1", 20ms)};
+  BOOST_REQUIRE(2ms == reload.getStageDuration(ReloadStage::fileReloaded));
+  BOOST_REQUIRE(20ms == reload.getStageDuration(ReloadStage::statisticsRead));
+  BOOST_REQUIRE(9ms == reload.getStageDuration(ReloadStage::observerNotified));
+  BOOST_REQUIRE(31ms == reload.getTotalDuration());
+  BOOST_REQUIRE(reload.getId() != newReload("HudLatencyTest table 1", 20ms).getId());
+  BOOST_REQUIRE(reload.toString().contains("statisticsRead 20.0 ms"));
+}
+
+BOOST_AUTO_TEST_CASE(HudLatencyTest_recentReloadsShouldGiveTheSlowestReloadsAndTheP99) {
+  constexpr std::string_view TABLE {"HudLatencyTest table 2"};
+  BOOST_REQUIRE(!HudLatency::getRecentP99(TABLE).has_value());
+
+  for (auto i = 0; i < 99; ++i) {
+    HudLatency::record(newReload(TABLE, 20ms));
+  }
+
+  HudLatency::record(newReload(TABLE, 500ms));
+  BOOST_REQUIRE(31ms == HudLatency::getRecentP99(TABLE));
+  HudLatency::record(newReload(TABLE, 400ms));
+  BOOST_REQUIRE(411ms == HudLatency::getRecentP99(TABLE));
+  const auto& slowest {HudLatency::getSlowestRecentReloads(2)};
+  BOOST_REQUIRE(2 == slowest.size());
+  BOOST_REQUIRE(511ms == slowest[0].getTotalDuration());
+  BOOST_REQUIRE(411ms == slowest[1].getTotalDuration());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
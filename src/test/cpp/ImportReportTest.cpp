@@ -0,0 +1,59 @@
+#include "TestInfrastructure.hpp"     // BOOST_* macros, phud::test::*
+#include "entities/Site.hpp"          // Site
+#include "filesystem/FileUtils.hpp"   // phud::filesystem::*
+#include "history/ImportReport.hpp"   // ImportReport, ImportedFile, ImportPhase
+#include "history/WinamaxHistory.hpp" // WinamaxHistory
+
+namespace pf = phud::filesystem;
+namespace pt = phud::test;
+
+using namespace std::chrono_literals;
+
+BOOST_AUTO_TEST_SUITE(ImportReportTest)
+
+BOOST_AUTO_TEST_CASE(ImportReportTest_insertTimeShouldBeSharedInProportionOfTheHands) {
+  ImportReport report;
+  report.addFile({.m_file = "a.txt", .m_readTime = 1ms, .m_parseTime = 4ms, .m_nbHands = 1});
+  report.addFile({.m_file = "b.txt", .m_readTime = 2ms, .m_parseTime = 6ms, .m_nbHands = 3});
+  report.addInsertTime(40ms);
+  report.addFile({.m_file = "c.txt", .m_error = "bad", .m_readTime = 1ms, .m_nbHands = 0});
+  report.addInsertTime(5ms);
+  report.addTime(ImportPhase::merge, 3ms);
+  report.stop();
+  BOOST_REQUIRE(4ms == report.getTime(ImportPhase::read));
+  BOOST_REQUIRE(10ms == report.getTime(ImportPhase::parse));
+  BOOST_REQUIRE(3ms == report.getTime(ImportPhase::merge));
+  BOOST_REQUIRE(45ms == report.getTime(ImportPhase::insert));
+  BOOST_REQUIRE(4 == report.getNbHands());
+  const auto files {report.getFiles()};
+  BOOST_REQUIRE(3 == files.size());
+  BOOST_REQUIRE("b.txt" == files[0].m_file);
+  BOOST_REQUIRE(30ms == files[0].m_insertTime);
+  BOOST_REQUIRE("a.txt" == files[1].m_file);
+  BOOST_REQUIRE(10ms == files[1].m_insertTime);
+  BOOST_REQUIRE(5ms == files[2].m_insertTime);
+  BOOST_REQUIRE(report.toString().contains("3 files (1 in error)"));
+}
+
+BOOST_AUTO_TEST_CASE(ImportReportTest_loadShouldReportEachFileAndEachPhase) {
+  const auto pReport {std::make_shared<ImportReport>()};
+  WinamaxHistory history;
+  history.setImportReport(pReport);
+  std::size_t nbBatches = 0;
+  const auto pSite {history.load(pt::getDirFromTestResources("Winamax/simpleCGHisto"), nullptr,
+                                 nullptr, ImportOrder::directory,
+                                 [&nbBatches](Site&) { ++nbBatches; })};
+  BOOST_REQUIRE(nullptr != pSite);
+  BOOST_REQUIRE(1 == nbBatches);
+  const auto files {pReport->getFiles()};
+  BOOST_REQUIRE(1 == files.size());
+  BOOST_REQUIRE(files[0].m_error.empty());
+  BOOST_REQUIRE(5 == files[0].m_nbHands);
+  BOOST_REQUIRE(0 < files[0].m_nbBytes);
+  BOOST_REQUIRE(0ms < files[0].m_parseTime);
+  pt::TmpFile csvFile;
+  BOOST_REQUIRE(pReport->writeCsv(csvFile.path()));
+  BOOST_REQUIRE(pf::readToString(csvFile.path()).contains("Colorado 1_real_holdem_no-limit.txt"));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
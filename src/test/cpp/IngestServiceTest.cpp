@@ -0,0 +1,98 @@
+#include "TestInfrastructure.hpp"            // BOOST_* macros, phud::test::*
+#include "db/Database.hpp"                  // Database
+#include "entities/Site.hpp"                // Site
+#include "filesystem/FileUtils.hpp"         // phud::filesystem
+#include "gui/IngestService.hpp"            // IngestService
+#include "history/PokerSiteHistory.hpp"     // PokerSiteHistory
+#include "history/WinamaxHandGenerator.hpp" // WinamaxHandGenerator
+#include <thread>                           // std::this_thread
+
+namespace pf = phud::filesystem;
+namespace pt = phud::test;
+
+namespace {
+  constexpr std::chrono::seconds INGEST_TIMEOUT {5};
+  constexpr std::chrono::milliseconds INGEST_PERIOD {20};
+
+  [[nodiscard]] bool waitFor(const IngestService& service, std::size_t nbIngestedHands) {
+    const auto deadline {std::chrono::steady_clock::now() + INGEST_TIMEOUT};
+
+    while (service.getNbIngestedHands() < nbIngestedHands) {
+      if (deadline < std::chrono::steady_clock::now()) {
+        return false;
+      }
+
+      std::this_thread::sleep_for(INGEST_PERIOD);
+    }
+
+    return nbIngestedHands == service.getNbIngestedHands();
+  }
+} // anonymous namespace
+
+BOOST_AUTO_TEST_SUITE(IngestServiceTest)
+
+BOOST_AUTO_TEST_CASE(IngestServiceTest_startingWithAnInvalidHistoryDirShouldFail) {
+  const pt::TmpDir root {"IngestServiceTest_startingWithAnInvalidHistoryDirShouldFail"};
+  Database db;
+  IngestService service {db};
+  const pt::LogDisabler _;
+  BOOST_REQUIRE(false == service.start(root.path()));
+  BOOST_REQUIRE(false == service.isStarted());
+}
+
+BOOST_AUTO_TEST_CASE(IngestServiceTest_appendedHandsShouldBeSavedOnceComplete) {
+  const auto hands {WinamaxHandGenerator::splitHands(pf::readToString(pt::getFileFromTestResources(
+      "Winamax/simpleCGHisto/history/20150309_Colorado 1_real_holdem_no-limit.txt")))};
+  const pt::TmpDir root {"IngestServiceTest_appendedHandsShouldBeSavedOnceComplete"};
+  const pt::TmpDir dir {root / "history"};
+  const pt::TmpFile positioning {dir / "winamax_positioning_file.dat"};
+  const pt::TmpFile file {dir / "20150309_Replay 1_real_holdem_no-limit.txt"};
+  WinamaxHandGenerator generator {
+      {.hands = hands, .tableName = "Replay 1", .handIdPrefix = "r1-", .nbPlayerGroups = 1}};
+  // the hands already written are left to the history import
+  file.print(generator.next());
+  Database db;
+  IngestService service {db};
+  const pt::LogDisabler _;
+  BOOST_REQUIRE(service.start(root.path(), INGEST_PERIOD));
+  file.print(generator.next());
+  BOOST_REQUIRE(waitFor(service, 1));
+  // a hand being written is saved once complete
+  const auto hand {generator.next()};
+  const auto summary {hand.find("*** SUMMARY ***")};
+  file.print(hand.substr(0, summary));
+  std::this_thread::sleep_for(INGEST_PERIOD * 5);
+  BOOST_REQUIRE(1 == service.getNbIngestedHands());
+  file.print(hand.substr(summary));
+  BOOST_REQUIRE(waitFor(service, 2));
+  service.stop();
+  BOOST_REQUIRE(false == service.isStarted());
+}
+
+BOOST_AUTO_TEST_CASE(IngestServiceTest_importingTheIngestedHandsAgainShouldNotAddRows) {
+  const auto hands {WinamaxHandGenerator::splitHands(pf::readToString(pt::getFileFromTestResources(
+      "Winamax/simpleCGHisto/history/20150309_Colorado 1_real_holdem_no-limit.txt")))};
+  const pt::TmpDir root {"IngestServiceTest_importingTheIngestedHandsAgainShouldNotAddRows"};
+  const pt::TmpDir dir {root / "history"};
+  const pt::TmpFile positioning {dir / "winamax_positioning_file.dat"};
+  const pt::TmpFile file {dir / "20150309_Replay 1_real_holdem_no-limit.txt"};
+  WinamaxHandGenerator generator {
+      {.hands = hands, .tableName = "Replay 1", .handIdPrefix = "r1-", .nbPlayerGroups = 1}};
+  Database db;
+  IngestService service {db};
+  const pt::LogDisabler _;
+  BOOST_REQUIRE(service.start(root.path(), INGEST_PERIOD));
+  file.print(generator.next());
+  file.print(generator.next());
+  BOOST_REQUIRE(waitFor(service, 2));
+  service.stop();
+  const auto nbHands {db.getNbHands()};
+  const auto nbActions {db.getNbActions()};
+  BOOST_REQUIRE(2 == nbHands);
+  // the hands of a monitored table are also saved by the reload of its history file
+  db.save(*PokerSiteHistory::load(root.path()));
+  BOOST_REQUIRE(nbHands == db.getNbHands());
+  BOOST_REQUIRE(nbActions == db.getNbActions());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,106 @@
+#include "TestInfrastructure.hpp" // BOOST_* macros, phud::test::*
+#include "log/Logger.hpp"         // Logger, MinLevelLogger
+#include <spdlog/async.h>         // spdlog::async_logger, spdlog::init_thread_pool
+#include <spdlog/sinks/base_sink.h>
+#include <future>                 // std::promise, std::shared_future
+#include <mutex>
+
+namespace pt = phud::test;
+
+namespace {
+  // counts how many times it has been formatted
+  struct [[nodiscard]] FormatCounter final {
+    int& m_nbFormats;
+  };
+
+  // a sink which writing is blocked until released, so that the async queue gets full
+  class [[nodiscard]] BlockedSink final : public spdlog::sinks::base_sink<std::mutex> {
+  private:
+    std::shared_future<void> m_released;
+
+  protected:
+    void sink_it_(const spdlog::details::log_msg&) override { m_released.wait(); }
+    void flush_() override {}
+
+  public:
+    explicit BlockedSink(std::shared_future<void> released)
+      : m_released {std::move(released)} {}
+  }; // class BlockedSink
+} // anonymous namespace
+
+template <>
+struct fmt::formatter<FormatCounter> : fmt::formatter<std::string_view> {
+  auto format(const FormatCounter& counter, format_context& ctx) const {
+    ++counter.m_nbFormats;
+    return fmt::formatter<std::string_view>::format("counter", ctx);
+  }
+};
+
+BOOST_AUTO_TEST_SUITE(LoggerTest)
+
+BOOST_AUTO_TEST_CASE(LoggerTest_disabledLevelsShouldNotBeFormatted) {
+  const pt::LogDisabler _;
+  Logger::setLoggingLevel(LoggingLevel::warn);
+  BOOST_REQUIRE(!Logger::isEnabled(LoggingLevel::debug));
+  BOOST_REQUIRE(Logger::isEnabled(LoggingLevel::error));
+  int nbFormats {0};
+  Logger logger {"LoggerTest"};
+  logger.debug<"{}">(FormatCounter {nbFormats});
+  logger.info<"{}">(FormatCounter {nbFormats});
+  BOOST_REQUIRE(0 == nbFormats);
+  logger.warn<"{}">(FormatCounter {nbFormats});
+  BOOST_REQUIRE(1 == nbFormats);
+}
+
+BOOST_AUTO_TEST_CASE(LoggerTest_levelsBelowTheMinimumShouldNotBeCompiled) {
+  const pt::LogDisabler _;
+  Logger::setLoggingLevel(LoggingLevel::trace);
+  int nbFormats {0};
+  MinLevelLogger<LoggingLevel::info> logger {"LoggerTest"};
+  logger.trace<"{}">(FormatCounter {nbFormats});
+  logger.debug<"{}">(FormatCounter {nbFormats});
+  BOOST_REQUIRE(0 == nbFormats);
+  logger.info<"{}">(FormatCounter {nbFormats});
+  BOOST_REQUIRE(1 == nbFormats);
+}
+
+BOOST_AUTO_TEST_CASE(LoggerTest_overflowPolicyShouldBeReadFromItsName) {
+  BOOST_REQUIRE(LoggingOverflowPolicy::block == toLoggingOverflowPolicy("block"));
+  BOOST_REQUIRE(LoggingOverflowPolicy::drop == toLoggingOverflowPolicy("drop"));
+  BOOST_REQUIRE("drop" == toString(LoggingOverflowPolicy::drop));
+  BOOST_CHECK_THROW(std::ignore = toLoggingOverflowPolicy("wait"), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(LoggerTest_blockingPolicyShouldNotDropMessages) {
+  const pt::LogDisabler _;
+  Logger::setLoggingLevel(LoggingLevel::trace);
+  Logger logger {"LoggerTest"};
+
+  for (auto i = 0; i < 10'000; ++i) {
+    logger.trace<"message {}">(i);
+  }
+
+  BOOST_REQUIRE(0 == Logger::getNbDroppedMessages());
+}
+
+BOOST_AUTO_TEST_CASE(LoggerTest_droppingPolicyShouldDropTheOldestMessagesWhenTheQueueIsFull) {
+  // the messages of the other loggers still go to the previous queue, kept alive here
+  const auto pPreviousThreadPool {spdlog::thread_pool()};
+  spdlog::init_thread_pool(8, 1);
+  std::promise<void> release;
+  auto pLogger {std::make_shared<spdlog::async_logger>(
+      "LoggerTest", std::make_shared<BlockedSink>(release.get_future().share()),
+      spdlog::thread_pool(), spdlog::async_overflow_policy::overrun_oldest)};
+
+  for (auto i = 0; i < 100; ++i) {
+    pLogger->info("message {}", i);
+  }
+
+  const auto nbDroppedMessages {Logger::getNbDroppedMessages()};
+  release.set_value();
+  pLogger.reset();
+  spdlog::details::registry::instance().set_tp(pPreviousThreadPool);
+  BOOST_REQUIRE(0 < nbDroppedMessages);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,42 @@
+#include "TestInfrastructure.hpp"       // BOOST_* macros, phud::test::*
+#include "entities/Game.hpp"            // CashGame
+#include "entities/Hand.hpp"            // Hand
+#include "entities/Site.hpp"            // Site, SiteMemoryUsage
+#include "history/PokerSiteHistory.hpp" // PokerSiteHistory
+#include "log/MemoryAccounting.hpp"     // MemoryAccounting
+
+namespace pt = phud::test;
+
+BOOST_AUTO_TEST_SUITE(MemoryAccountingTest)
+
+BOOST_AUTO_TEST_CASE(MemoryAccountingTest_siteMemoryUsageShouldCountEachEntity) {
+  const auto pSite = PokerSiteHistory::load(pt::getDirFromTestResources("Winamax/simpleCGHisto"));
+  BOOST_REQUIRE(nullptr != pSite);
+  const auto usage {pSite->getMemoryUsage()};
+  BOOST_REQUIRE(pSite->viewPlayers().size() == usage.m_players.m_nbObjects);
+  BOOST_REQUIRE(1 == usage.m_cashGames.m_nbObjects);
+  BOOST_REQUIRE(0 == usage.m_tournaments.m_nbObjects);
+  BOOST_REQUIRE(0 == usage.m_tournaments.m_nbBytes);
+  const auto& hands {pSite->viewCashGames().front()->viewHands()};
+  BOOST_REQUIRE(hands.size() == usage.m_hands.m_nbObjects);
+  BOOST_REQUIRE(pSite->getNbHands() == usage.m_hands.m_nbObjects);
+  BOOST_REQUIRE(hands.size() * sizeof(Hand) <= usage.m_hands.m_nbBytes);
+  BOOST_REQUIRE(0 < usage.m_actions.m_nbObjects);
+  BOOST_REQUIRE(usage.m_players + usage.m_cashGames + usage.m_hands + usage.m_actions ==
+                usage.getTotal());
+}
+
+BOOST_AUTO_TEST_CASE(MemoryAccountingTest_subsystemUsageShouldBeUpdatedAndReported) {
+  MemoryAccounting::set(MemorySubsystem::siteTournaments, {.m_nbBytes = 1000, .m_nbObjects = 3});
+  MemoryAccounting::add(MemorySubsystem::siteTournaments, {.m_nbBytes = 500, .m_nbObjects = 2});
+  MemoryAccounting::subtract(MemorySubsystem::siteTournaments,
+                             {.m_nbBytes = 300, .m_nbObjects = 1});
+  BOOST_REQUIRE((MemoryUsage {.m_nbBytes = 1200, .m_nbObjects = 4}) ==
+                MemoryAccounting::get(MemorySubsystem::siteTournaments));
+  const auto report {MemoryAccounting::toString()};
+  BOOST_REQUIRE(report.contains("siteTournaments"));
+  BOOST_REQUIRE(report.contains("1200"));
+  BOOST_REQUIRE(report.contains("total"));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
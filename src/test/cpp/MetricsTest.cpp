@@ -0,0 +1,52 @@
+#include "TestInfrastructure.hpp"   // BOOST_* macros, phud::test::*
+#include "filesystem/FileUtils.hpp" // phud::filesystem
+#include "log/Metrics.hpp"          // Metrics
+
+namespace fs = std::filesystem;
+namespace pf = phud::filesystem;
+namespace pt = phud::test;
+
+BOOST_AUTO_TEST_SUITE(MetricsTest)
+
+BOOST_AUTO_TEST_CASE(MetricsTest_gettingAMetricTwiceShouldGiveTheSameMetric) {
+  auto& counter {Metrics::getCounter("metricstest_counter_total", "A counter.")};
+  const auto before {counter.get()};
+  Metrics::getCounter("metricstest_counter_total", "A counter.").increment(2);
+  BOOST_REQUIRE(before + 2 == counter.get());
+  BOOST_REQUIRE(&counter != &Metrics::getCounter("metricstest_counter_total", "A counter.",
+                                                 Metrics::toLabel("table", "Colorado 1")));
+}
+
+BOOST_AUTO_TEST_CASE(MetricsTest_histogramShouldCountTheValuesByBucket) {
+  Metrics::Histogram histogram;
+  histogram.observe(std::chrono::milliseconds(3));
+  histogram.observe(std::chrono::milliseconds(30));
+  histogram.observe(std::chrono::seconds(20));
+  BOOST_REQUIRE(0 == histogram.getCumulativeCount(1));   // <= 2.5 ms
+  BOOST_REQUIRE(1 == histogram.getCumulativeCount(2));   // <= 5 ms
+  BOOST_REQUIRE(2 == histogram.getCumulativeCount(5));   // <= 50 ms
+  BOOST_REQUIRE(2 == histogram.getCumulativeCount(12));  // <= 10 s
+  BOOST_REQUIRE(3 == histogram.getCumulativeCount(13));  // +Inf
+  BOOST_REQUIRE(3 == histogram.getCount());
+  BOOST_TEST(20.033 == histogram.getSumInSeconds(), boost::test_tools::tolerance(1e-9));
+}
+
+BOOST_AUTO_TEST_CASE(MetricsTest_metricsShouldBeExportedInPrometheusTextFormat) {
+  pt::TmpDir tmpDir {"MetricsTest_metricsShouldBeExportedInPrometheusTextFormat"};
+  Metrics::getGauge("metricstest_gauge", "A gauge.").set(-3);
+  Metrics::getHistogram("metricstest_latency_seconds", "A latency.",
+                        Metrics::toLabel("table", R"(The "Fish")"))
+      .observe(std::chrono::milliseconds(40));
+  const auto metricsFile {fs::path(tmpDir / "metrics.prom")};
+  BOOST_REQUIRE(Metrics::dump(metricsFile));
+  const auto text {pf::readToString(metricsFile)};
+  BOOST_REQUIRE(text.contains("# TYPE metricstest_gauge gauge\nmetricstest_gauge -3\n"));
+  BOOST_REQUIRE(text.contains("# TYPE metricstest_latency_seconds histogram\n"));
+  BOOST_REQUIRE(
+      text.contains(R"(metricstest_latency_seconds_bucket{table="The \"Fish\"",le="0.05"} 1)"));
+  BOOST_REQUIRE(
+      text.contains(R"(metricstest_latency_seconds_bucket{table="The \"Fish\"",le="+Inf"} 1)"));
+  BOOST_REQUIRE(text.contains(R"(metricstest_latency_seconds_count{table="The \"Fish\""} 1)"));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -6,6 +6,7 @@
 #include "constants/ProgramInfos.hpp"
 #include "statistics/PlayerStatistics.hpp"
 #include "statistics/StatsProducer.hpp"
+#include "statistics/StatsStore.hpp"
 #include "statistics/TableStatistics.hpp"
 #include "threads/ThreadSafeQueue.hpp"
 
@@ -21,13 +22,14 @@ BOOST_AUTO_TEST_CASE(StatsProducerTest_parsingAnUpdatedHistoryShouldSucceed) {
       "Winamax/StatsProducerTest_parsingAnUpdatedHistoryShouldSucceed"))};
   BOOST_REQUIRE(nullptr != pSite);
   Database db;
+  StatsStore store {ProgramInfos::WINAMAX_SITE_NAME};
+  const auto observerId {db.addSiteObserver([&store](const Site& site) { store.add(site); })};
   db.save(*pSite);
+  db.removeSiteObserver(observerId);
   const auto& table {"Kill The Fish(152800689)#056"};
   /* create the timebomb after the database creation which can be slow */
-  const StatsProducer producer {{.reloadPeriod = SG_PERIOD,
-                                 .site = ProgramInfos::WINAMAX_SITE_NAME,
-                                 .tableWindowName = table,
-                                 .db = db}};
+  const StatsProducer producer {
+      {.reloadPeriod = SG_PERIOD, .tableWindowName = table, .store = store}};
   ThreadSafeQueue<TableStatistics> statsQueue;
   producer.start(statsQueue);
   auto _ {TimeBomb::create(COUNTDOWN_TO_EXPLOSION,
@@ -59,7 +61,8 @@ BOOST_AUTO_TEST_CASE(StatsProducerTest_parsingAnUpdatedHistoryShouldSucceed) {
   BOOST_REQUIRE(false == ps3->isHero());
   BOOST_REQUIRE(0 == ps3->getVoluntaryPutMoneyInPot());
   BOOST_REQUIRE(0 == ps3->getPreFlopRaise());
-  BOOST_REQUIRE(1 == ps3->getNbHands());
+  /* the hands are counted for the players dealt in only */
+  BOOST_REQUIRE(0 == ps3->getNbHands());
   const auto& ps4 {stats.extractPlayerStatistics(Seat::seatFour)};
   BOOST_REQUIRE("anyamfia88" == ps4->getPlayerName());
   BOOST_REQUIRE(ProgramInfos::WINAMAX_SITE_NAME == ps4->getSiteName());
@@ -0,0 +1,79 @@
+#include "TestInfrastructure.hpp"         // BOOST_* macros, phud::test::*
+#include "constants/ProgramInfos.hpp"     // ProgramInfos::WINAMAX_SITE_NAME
+#include "db/Database.hpp"                // Database
+#include "entities/Site.hpp"              // Site
+#include "history/PokerSiteHistory.hpp"   // PokerSiteHistory
+#include "statistics/PlayerStatistics.hpp"
+#include "statistics/StatsStore.hpp"      // StatsStore, HandStore
+#include "statistics/TableStatistics.hpp" // TableStatistics
+
+namespace pt = phud::test;
+
+namespace {
+  constexpr std::string_view TABLE {"Kill The Fish(152800689)#004"};
+} // anonymous namespace
+
+BOOST_AUTO_TEST_SUITE(StatsStoreTest)
+
+BOOST_AUTO_TEST_CASE(StatsStoreTest_addingASiteShouldGiveTheStatisticsOfItsTables) {
+  const auto pSite = PokerSiteHistory::load(pt::getDirFromTestResources("Winamax/simpleTHisto"));
+  StatsStore store {ProgramInfos::WINAMAX_SITE_NAME};
+  BOOST_REQUIRE(!store.getTableStatistics(TABLE).isValid());
+  BOOST_REQUIRE(216 == store.add(*pSite));
+  // the hands already counted are skipped
+  BOOST_REQUIRE(0 == store.add(*pSite));
+  BOOST_REQUIRE(216 == store.getNbHands());
+  auto stats {store.getTableStatistics(TABLE)};
+  BOOST_REQUIRE(Seat::seatSix == stats.getMaxSeat());
+  BOOST_REQUIRE(Seat::seatFive == stats.getHeroSeat());
+  BOOST_REQUIRE("StopCallFish" == stats.m_tableStats[0]->getPlayerName());
+  BOOST_REQUIRE("DelAmri" == stats.m_tableStats[1]->getPlayerName());
+  BOOST_REQUIRE("Herlock33" == stats.m_tableStats[2]->getPlayerName());
+  BOOST_REQUIRE(nullptr == stats.m_tableStats[3]);
+  const auto pHero {stats.extractPlayerStatistics(Seat::seatFive)};
+  BOOST_REQUIRE("sabre_laser" == pHero->getPlayerName());
+  BOOST_REQUIRE(ProgramInfos::WINAMAX_SITE_NAME == pHero->getSiteName());
+  BOOST_REQUIRE(213 == pHero->getNbHands());
+  BOOST_REQUIRE(21 == pHero->getVoluntaryPutMoneyInPot());
+  BOOST_REQUIRE(10 == pHero->getPreFlopRaise());
+  BOOST_REQUIRE_CLOSE(31.58, pHero->getStealAttempt(), 0.1);
+  BOOST_REQUIRE_CLOSE(77.78, pHero->getPercentage(Stat::stealAttempt, TablePosition::button), 0.1);
+  BOOST_REQUIRE_CLOSE(87.5, pHero->getPercentage(Stat::foldToSteal, TablePosition::bigBlind), 0.1);
+  BOOST_REQUIRE(!store.getTableStatistics("unknown table").isValid());
+}
+
+BOOST_AUTO_TEST_CASE(StatsStoreTest_loadingTheHandStoreShouldCountTheSavedHands) {
+  const pt::TmpDir tmpDir {"StatsStoreTest_loadingTheHandStoreShouldCountTheSavedHands"};
+  const auto pSite = PokerSiteHistory::load(pt::getDirFromTestResources("Winamax/simpleTHisto"));
+  Database db {tmpDir / "phud.db"};
+  db.save(*pSite);
+  StatsStore loaded {ProgramInfos::WINAMAX_SITE_NAME};
+  BOOST_REQUIRE(216 == loaded.load(HandStore::Reader {db.getHandStoreFile()}));
+  // the hand store doesn't know the tables
+  BOOST_REQUIRE(!loaded.getTableStatistics(TABLE).isValid());
+  BOOST_REQUIRE(0 == loaded.add(*pSite));
+  StatsStore added {ProgramInfos::WINAMAX_SITE_NAME};
+  BOOST_REQUIRE(216 == added.add(*pSite));
+  auto loadedStats {loaded.getTableStatistics(TABLE)};
+  auto addedStats {added.getTableStatistics(TABLE)};
+  // the table of the hands already counted is known once they are added
+  BOOST_REQUIRE(loadedStats.isValid());
+  BOOST_REQUIRE(Seat::seatSix == loadedStats.getMaxSeat());
+
+  for (const auto seat : loadedStats.getSeats()) {
+    const auto pLoaded {loadedStats.extractPlayerStatistics(seat)};
+    const auto pAdded {addedStats.extractPlayerStatistics(seat)};
+    BOOST_REQUIRE((nullptr == pLoaded) == (nullptr == pAdded));
+
+    if (nullptr != pLoaded) {
+      BOOST_REQUIRE(pLoaded->getNbHands() == pAdded->getNbHands());
+      BOOST_REQUIRE(pLoaded->getVoluntaryPutMoneyInPot() == pAdded->getVoluntaryPutMoneyInPot());
+      BOOST_REQUIRE(pLoaded->getAggressionFactor() == pAdded->getAggressionFactor());
+      BOOST_REQUIRE(pLoaded->getWentToShowDown() == pAdded->getWentToShowDown());
+      BOOST_REQUIRE(pLoaded->getPercentage(Stat::foldToSteal, TablePosition::bigBlind) ==
+                    pAdded->getPercentage(Stat::foldToSteal, TablePosition::bigBlind));
+    }
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -68,6 +68,11 @@ BOOST_AUTO_TEST_CASE(StringTest_replaceShouldWork) {
   BOOST_TEST("" == ps::replaceAll("", 'a', 'b'));
 }
 
+BOOST_AUTO_TEST_CASE(StringTest_replaceAllShouldNotReplaceTheInsertedStrings) {
+  BOOST_TEST("Player''s table" == ps::replaceAll("Player's table", "'", "''"));
+  BOOST_TEST("aaaa" == ps::replaceAll("aa", "a", "aa"));
+}
+
 namespace {
   struct [[nodiscard]] Params final {
     std::string_view value;
@@ -0,0 +1,56 @@
+#include "TestInfrastructure.hpp"      // BOOST_* macros
+#include "entities/Seat.hpp"          // Seat
+#include "entities/TablePosition.hpp" // TablePosition, tablePosition
+#include <ostream>
+
+/**
+ * To be able to use the boost unit_test API with the TablePosition enum, we have to provide this.
+ * Note: it has to be in the global scope, putting it in the anonymous namespace won't work
+ */
+static std::ostream& operator<<(std::ostream& os, TablePosition p) {
+  return os << tablePosition::toString(p);
+}
+
+namespace {
+  using IsSeated = std::array<bool, TableConstants::MAX_SEATS>;
+} // anonymous namespace
+
+BOOST_AUTO_TEST_SUITE(TablePositionTest)
+
+BOOST_AUTO_TEST_CASE(TablePositionTest_aFullSixMaxTableShouldHaveAllThePositions) {
+  const IsSeated isSeated {true, true, true, true, true, true};
+  const auto positions {tablePosition::fromSeats(isSeated, Seat::seatThree)};
+  BOOST_REQUIRE_EQUAL(TablePosition::button, positions[2]);
+  BOOST_REQUIRE_EQUAL(TablePosition::smallBlind, positions[3]);
+  BOOST_REQUIRE_EQUAL(TablePosition::bigBlind, positions[4]);
+  BOOST_REQUIRE_EQUAL(TablePosition::earlyPosition, positions[5]);
+  BOOST_REQUIRE_EQUAL(TablePosition::middlePosition, positions[0]);
+  BOOST_REQUIRE_EQUAL(TablePosition::cutOff, positions[1]);
+  BOOST_REQUIRE_EQUAL(TablePosition::none, positions[6]);
+}
+
+BOOST_AUTO_TEST_CASE(TablePositionTest_headsUpTheButtonShouldBeTheSmallBlind) {
+  IsSeated isSeated {};
+  isSeated[1] = true;
+  isSeated[4] = true;
+  const auto positions {tablePosition::fromSeats(isSeated, Seat::seatFive)};
+  BOOST_REQUIRE_EQUAL(TablePosition::smallBlind, positions[4]);
+  BOOST_REQUIRE_EQUAL(TablePosition::bigBlind, positions[1]);
+  BOOST_REQUIRE_EQUAL(TablePosition::none, positions[0]);
+}
+
+BOOST_AUTO_TEST_CASE(TablePositionTest_anEmptyButtonSeatShouldGiveTheButtonToThePreviousPlayer) {
+  IsSeated isSeated {};
+  isSeated[0] = true;
+  isSeated[2] = true;
+  isSeated[4] = true;
+  isSeated[5] = true;
+  const auto positions {tablePosition::fromSeats(isSeated, Seat::seatFour)};
+  BOOST_REQUIRE_EQUAL(TablePosition::button, positions[2]);
+  BOOST_REQUIRE_EQUAL(TablePosition::smallBlind, positions[4]);
+  BOOST_REQUIRE_EQUAL(TablePosition::bigBlind, positions[5]);
+  BOOST_REQUIRE_EQUAL(TablePosition::cutOff, positions[0]);
+  BOOST_REQUIRE_EQUAL("CO", tablePosition::toString(TablePosition::cutOff));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -1,9 +1,36 @@
 #include "TestInfrastructure.hpp"
+#include "constants/TableConstants.hpp"     // TableConstants
 #include "db/Database.hpp"
+#include "db/HandStore.hpp"                 // HandStore
+#include "entities/Seat.hpp"                // Seat, tableSeat
+#include "entities/Site.hpp"                // Site
+#include "filesystem/FileUtils.hpp"         // phud::filesystem
 #include "gui/TableService.hpp"
+#include "history/WinamaxHandGenerator.hpp" // WinamaxHandGenerator
+#include "history/WinamaxHistory.hpp"       // WinamaxHistory
+#include "log/Metrics.hpp"                  // Metrics
+#include "statistics/PlayerStatistics.hpp"  // PlayerStatistics
+#include "statistics/TableStatistics.hpp"   // TableStatistics
 
+namespace pf = phud::filesystem;
 namespace pt = phud::test;
 
+namespace {
+  // @returns the number of hands of the seated player who played the most
+  [[nodiscard]] int getMaxNbHands(TableStatistics& stats) {
+    int ret = 0;
+
+    for (auto seat {1}; seat <= TableConstants::MAX_SEATS; ++seat) {
+      if (const auto pStats {stats.extractPlayerStatistics(tableSeat::fromInt(seat))};
+          nullptr != pStats) {
+        ret = std::max(ret, pStats->getNbHands());
+      }
+    }
+
+    return ret;
+  }
+} // anonymous namespace
+
 BOOST_AUTO_TEST_SUITE(TableServiceTest)
 
 BOOST_AUTO_TEST_CASE(TableServiceTest_isPokerAppShouldSucceed) {
@@ -14,4 +41,125 @@ BOOST_AUTO_TEST_CASE(TableServiceTest_isPokerAppShouldSucceed) {
   BOOST_REQUIRE(false == ts.isPokerApp("Some unimplemented site stem"));
 }
 
+BOOST_AUTO_TEST_CASE(TableServiceTest_monitoringSeveralTablesShouldSucceed) {
+  const auto hands {WinamaxHandGenerator::splitHands(pf::readToString(pt::getFileFromTestResources(
+      "Winamax/simpleCGHisto/history/20150309_Colorado 1_real_holdem_no-limit.txt")))};
+  const pt::TmpDir root {"TableServiceTest_monitoringSeveralTablesShouldSucceed"};
+  const pt::TmpDir dir {root / "history"};
+  const pt::TmpFile file1 {dir / "20150309_Replay 1_real_holdem_no-limit.txt"};
+  const pt::TmpFile file2 {dir / "20150309_Replay 2_real_holdem_no-limit.txt"};
+  WinamaxHandGenerator generator1 {
+      {.hands = hands, .tableName = "Replay 1", .handIdPrefix = "r1-", .nbPlayerGroups = 1}};
+  WinamaxHandGenerator generator2 {
+      {.hands = hands, .tableName = "Replay 2", .handIdPrefix = "r2-", .nbPlayerGroups = 1}};
+  file1.print(generator1.next());
+  file2.print(generator2.next());
+  Database db;
+  TableService service {db};
+  service.setPokerSiteHistory(std::make_shared<WinamaxHistory>());
+  service.setHistoryDir(root.path());
+  pt::Notifications notifications {2};
+  const pt::LogDisabler _;
+  BOOST_REQUIRE(service
+                    .startProducingStats("Winamax Replay 1 / 0,01-0,02 NL Holdem",
+                                         [&notifications](TableStatistics&&) {
+                                           notifications.notify(0);
+                                         })
+                    .empty());
+  BOOST_REQUIRE(service
+                    .startProducingStats("Winamax Replay 2 / 0,01-0,02 NL Holdem",
+                                         [&notifications](TableStatistics&&) {
+                                           notifications.notify(1);
+                                         })
+                    .empty());
+  // the history file of a newly monitored table is reloaded at once
+  BOOST_REQUIRE(notifications.waitFor(0, 1));
+  BOOST_REQUIRE(notifications.waitFor(1, 1));
+  file1.print(generator1.next());
+  file2.print(generator2.next());
+  BOOST_REQUIRE(notifications.waitFor(0, 2));
+  BOOST_REQUIRE(notifications.waitFor(1, 2));
+  // the other table is still monitored
+  service.stopProducingStats("Winamax Replay 1 / 0,01-0,02 NL Holdem");
+  const auto nbNotifications {notifications.getNbNotifications(1)};
+  file2.print(generator2.next());
+  BOOST_REQUIRE(notifications.waitFor(1, nbNotifications + 1));
+  service.stopProducingStats();
+}
+
+BOOST_AUTO_TEST_CASE(TableServiceTest_changesWithinTheCoalescingWindowShouldMakeOneReload) {
+  const auto hands {WinamaxHandGenerator::splitHands(pf::readToString(pt::getFileFromTestResources(
+      "Winamax/simpleCGHisto/history/20150309_Colorado 1_real_holdem_no-limit.txt")))};
+  const pt::TmpDir root {"TableServiceTest_changesWithinTheCoalescingWindowShouldMakeOneReload"};
+  const pt::TmpDir dir {root / "history"};
+  const pt::TmpFile file {dir / "20150309_Replay 1_real_holdem_no-limit.txt"};
+  WinamaxHandGenerator generator {
+      {.hands = hands, .tableName = "Replay 1", .handIdPrefix = "r1-", .nbPlayerGroups = 1}};
+  file.print(generator.next());
+  Database db;
+  TableService service {db};
+  service.setPokerSiteHistory(std::make_shared<WinamaxHistory>());
+  service.setHistoryDir(root.path());
+  service.setCoalescingWindow(std::chrono::milliseconds(500));
+  pt::Notifications notifications {1};
+  const pt::LogDisabler _;
+  BOOST_REQUIRE(service
+                    .startProducingStats("Winamax Replay 1 / 0,01-0,02 NL Holdem",
+                                         [&notifications](TableStatistics&&) {
+                                           notifications.notify(0);
+                                         })
+                    .empty());
+  BOOST_REQUIRE(notifications.waitFor(0, 1));
+  const auto nbReloads {Metrics::getNbHistoryFileReloads().get()};
+  // a hand written in two chunks
+  const auto hand {generator.next()};
+  const auto summary {hand.find("*** SUMMARY ***")};
+  file.print(hand.substr(0, summary));
+  file.print(hand.substr(summary));
+  BOOST_REQUIRE(notifications.waitFor(0, 2));
+  service.stopProducingStats();
+  BOOST_REQUIRE(2 == notifications.getNbNotifications(0));
+  BOOST_REQUIRE(nbReloads + 1 == Metrics::getNbHistoryFileReloads().get());
+}
+
+BOOST_AUTO_TEST_CASE(TableServiceTest_aDatabaseWithoutHandStoreShouldKeepItsStatistics) {
+  const auto hands {WinamaxHandGenerator::splitHands(pf::readToString(pt::getFileFromTestResources(
+      "Winamax/simpleCGHisto/history/20150309_Colorado 1_real_holdem_no-limit.txt")))};
+  const pt::TmpDir root {"TableServiceTest_aDatabaseWithoutHandStoreShouldKeepItsStatistics"};
+  const pt::TmpDir dir {root / "history"};
+  const pt::TmpFile positioning {dir / "winamax_positioning_file.dat"};
+  const auto dbFile {root / "phud.db"};
+  WinamaxHandGenerator generator {
+      {.hands = hands, .tableName = "Replay 1", .handIdPrefix = "r1-", .nbPlayerGroups = 1}};
+  const pt::LogDisabler _;
+  {
+    // the hands of a previous session, saved in a database which predates the hand store
+    const pt::TmpFile previousFile {dir / "20150308_Replay 1_real_holdem_no-limit.txt"};
+    previousFile.print(generator.next());
+    previousFile.print(generator.next());
+    Database db {dbFile};
+    db.save(*WinamaxHistory::load(root.path()));
+    HandStore::remove(db.getHandStoreFile());
+  }
+  const pt::TmpFile file {dir / "20150309_Replay 1_real_holdem_no-limit.txt"};
+  file.print(generator.next());
+  Database db {dbFile};
+  TableService service {db};
+  service.setPokerSiteHistory(std::make_shared<WinamaxHistory>());
+  service.setHistoryDir(root.path());
+  pt::Notifications notifications {1};
+  int maxNbHands {0};
+  BOOST_REQUIRE(service
+                    .startProducingStats("Winamax Replay 1 / 0,01-0,02 NL Holdem",
+                                         [&](TableStatistics&& stats) {
+                                           maxNbHands = getMaxNbHands(stats);
+                                           notifications.notify(0);
+                                         })
+                    .empty());
+  BOOST_REQUIRE(notifications.waitFor(0, 1));
+  service.stopProducingStats();
+  // the hands of the previous session are counted, though only the last file is reloaded
+  BOOST_REQUIRE(3 == maxNbHands);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -212,3 +212,34 @@ pt::LogDisabler::LogDisabler()
 pt::LogDisabler::~LogDisabler() {
   Logger::setLoggingLevel(m_beforeDisabling);
 }
+
+pt::Notifications::Notifications(std::size_t nbChannels)
+  : m_nbNotifications(nbChannels) {}
+
+void pt::Notifications::notify(std::size_t channel) {
+  const std::scoped_lock lock {m_mutex};
+
+  if (m_onNotify) {
+    m_onNotify();
+  }
+
+  ++m_nbNotifications.at(channel);
+  m_cv.notify_all();
+}
+
+void pt::Notifications::setOnNotify(std::function<void()> onNotify) {
+  const std::scoped_lock lock {m_mutex};
+  m_onNotify = std::move(onNotify);
+}
+
+std::size_t pt::Notifications::getNbNotifications(std::size_t channel) {
+  const std::scoped_lock lock {m_mutex};
+  return m_nbNotifications.at(channel);
+}
+
+bool pt::Notifications::waitFor(std::size_t channel, std::size_t nbNotifications) {
+  constexpr std::chrono::seconds NOTIFICATION_TIMEOUT {5};
+  std::unique_lock lock {m_mutex};
+  return m_cv.wait_for(lock, NOTIFICATION_TIMEOUT,
+                       [&] { return nbNotifications <= m_nbNotifications.at(channel); });
+}
@@ -17,7 +17,11 @@
 #  pragma clang diagnostic pop
 #endif // _MSC_VER
 
+#include <condition_variable>
 #include <filesystem> // std::filesystem::path
+#include <functional> // std::function
+#include <mutex>
+#include <vector>
 
 /* forward declaration */
 enum class LoggingLevel : short;
@@ -91,8 +95,34 @@ namespace phud::test {
     ~LogDisabler();
   }; // class LogDisabler
 
-  [[nodiscard]] bool isSet(const auto& container) {
-    auto copy {container};
+  /**
+   * Counts the notifications of each channel, e.g. the statistics notified for each monitored
+   * table, so that a test can wait for the notifications sent by other threads.
+   */
+  class [[nodiscard]] Notifications final {
+  private:
+    // Memory layout optimized: largest to smallest to minimize padding
+    std::condition_variable m_cv {};
+    std::mutex m_mutex {};
+    std::function<void()> m_onNotify {};
+    std::vector<std::size_t> m_nbNotifications;
+
+  public:
+    explicit Notifications(std::size_t nbChannels);
+    void notify(std::size_t channel);
+    /**
+     * Sets the function called by the next notifications before they are counted.
+     */
+    void setOnNotify(std::function<void()> onNotify);
+    [[nodiscard]] std::size_t getNbNotifications(std::size_t channel);
+    /**
+     * @returns false if the given channel didn't get the given number of notifications in time
+     */
+    [[nodiscard]] bool waitFor(std::size_t channel, std::size_t nbNotifications);
+  }; // class Notifications
+
+  [[nodiscard]] bool isSet(const auto& range) {
+    std::vector copy(std::begin(range), std::end(range));
     std::sort(std::begin(copy), std::end(copy));
     return std::end(copy) == std::adjacent_find(std::begin(copy), std::end(copy));
   }
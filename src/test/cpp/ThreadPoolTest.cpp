@@ -1,11 +1,29 @@
 #include "TestInfrastructure.hpp"
 #include "threads/ThreadPool.hpp"
 #include <stlab/concurrency/utility.hpp> // stlab::await
+#include <chrono>
+#include <thread>                         // std::this_thread::sleep_for
 
 static constexpr double myFunction(double d) {
   return d / 2;
 }
 
+// the continuations of the other tests may still be running in the shared pool
+[[nodiscard]] static bool waitUntilIdle(ThreadPool::TaskCategory category) {
+  const auto deadline {std::chrono::steady_clock::now() + std::chrono::seconds(10)};
+
+  while (std::chrono::steady_clock::now() < deadline) {
+    if (const auto stats {ThreadPool::getTaskStatistics(category)};
+        0 == stats.m_nbQueued and 0 == stats.m_nbRunning) {
+      return true;
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+
+  return false;
+}
+
 BOOST_AUTO_TEST_SUITE(ThreadPoolTest)
 
 BOOST_AUTO_TEST_CASE(ThreadPoolTest_submitFunctionShouldWork) {
@@ -33,4 +51,22 @@ BOOST_AUTO_TEST_CASE(ThreadPoolTest_submitLambdaWithCapturedParametersShouldWork
   BOOST_REQUIRE(1.0 == futureResult.get_try().value());
 }
 
+BOOST_AUTO_TEST_CASE(ThreadPoolTest_submittedTaskShouldBeRecordedInItsCategory) {
+  using enum ThreadPool::TaskCategory;
+  const auto before {ThreadPool::getTaskStatistics(statsRead)};
+  // the running tasks seen by the task itself
+  auto futureResult = ThreadPool::submit(statsRead, [] {
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    return ThreadPool::getTaskStatistics(statsRead).m_nbRunning;
+  });
+  stlab::await(stlab::copy(futureResult));
+  BOOST_REQUIRE(1 <= futureResult.get_try().value());
+  BOOST_REQUIRE(waitUntilIdle(statsRead));
+  const auto after {ThreadPool::getTaskStatistics(statsRead)};
+  BOOST_REQUIRE(before.m_nbCompleted + 1 <= after.m_nbCompleted);
+  BOOST_REQUIRE(after.m_maxRunTime >= std::chrono::milliseconds(5));
+  BOOST_REQUIRE(after.m_totalRunTime - before.m_totalRunTime >= std::chrono::milliseconds(5));
+  BOOST_REQUIRE(ThreadPool::getTaskStatisticsAsString().contains("stats-read"));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,55 @@
+#include "TestInfrastructure.hpp"   // BOOST_* macros, phud::test::*
+#include "filesystem/FileUtils.hpp" // phud::filesystem
+#include "log/Tracer.hpp"           // Tracer, TraceSpan
+#include <thread>                   // std::jthread
+
+namespace fs = std::filesystem;
+namespace pf = phud::filesystem;
+namespace pt = phud::test;
+
+BOOST_AUTO_TEST_SUITE(TracerTest)
+
+BOOST_AUTO_TEST_CASE(TracerTest_spansShouldBeWrittenAsChromeTraceEvents) {
+  pt::TmpDir tmpDir {"TracerTest_spansShouldBeWrittenAsChromeTraceEvents"};
+  const auto traceFile {fs::path(tmpDir / "trace.json")};
+  Tracer::start();
+  BOOST_REQUIRE(Tracer::isEnabled());
+  {
+    const TraceSpan outer {"outerSpan"};
+    std::jthread {[] { const TraceSpan inner {"innerSpan"}; }}.join();
+  }
+  BOOST_REQUIRE(Tracer::stop(traceFile));
+  BOOST_REQUIRE(!Tracer::isEnabled());
+  const auto json {pf::readToString(traceFile)};
+  BOOST_REQUIRE(json.starts_with(R"({"displayTimeUnit":"ms","traceEvents":[)"));
+  BOOST_REQUIRE(json.contains(R"({"name":"outerSpan","cat":"phud","ph":"X","pid":1,"tid":)"));
+  BOOST_REQUIRE(json.contains(R"({"name":"innerSpan","cat":"phud","ph":"X","pid":1,"tid":)"));
+}
+
+BOOST_AUTO_TEST_CASE(TracerTest_spansShouldNotBeRecordedWhenTracingIsStopped) {
+  pt::TmpDir tmpDir {"TracerTest_spansShouldNotBeRecordedWhenTracingIsStopped"};
+  const auto traceFile {fs::path(tmpDir / "trace.json")};
+  { const TraceSpan span {"ignoredSpan"}; }
+  Tracer::start();
+  BOOST_REQUIRE(Tracer::stop(traceFile));
+  BOOST_REQUIRE(!pf::readToString(traceFile).contains("ignoredSpan"));
+}
+
+BOOST_AUTO_TEST_CASE(TracerTest_theOldestSpansOfAThreadShouldBeDroppedWhenItsBufferIsFull) {
+  pt::TmpDir tmpDir {"TracerTest_theOldestSpansOfAThreadShouldBeDroppedWhenItsBufferIsFull"};
+  const auto traceFile {fs::path(tmpDir / "trace.json")};
+  Tracer::start();
+  Tracer::record("oldestSpan", 0, 1);
+
+  for (std::size_t i = 0; i < Tracer::MAX_SPANS_PER_THREAD; ++i) {
+    Tracer::record("newerSpan", 1, 1);
+  }
+
+  BOOST_REQUIRE(Tracer::stop(traceFile));
+  BOOST_REQUIRE(1 == Tracer::getNbDroppedSpans());
+  const auto json {pf::readToString(traceFile)};
+  BOOST_REQUIRE(!json.contains("oldestSpan"));
+  BOOST_REQUIRE(json.contains("newerSpan"));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
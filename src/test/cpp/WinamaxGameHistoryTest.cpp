@@ -147,6 +147,28 @@ BOOST_AUTO_TEST_CASE(WinamaxGameHistoryTest_mergingSitesShouldSucceed) {
   BOOST_REQUIRE(pt::isSet(site->viewPlayers()));
 }
 
+BOOST_AUTO_TEST_CASE(WinamaxGameHistoryTest_siteHandsOfAPlayerShouldBeTheHandsOfAllItsGames) {
+  auto site {WinamaxGameHistory::parseGameHistory(pt::getFileFromTestResources(
+      "Winamax/tc1591/history/20150309_Colorado 2_real_holdem_no-limit.txt"))};
+  const auto pSiteToBeMerged {WinamaxGameHistory::parseGameHistory(pt::getFileFromTestResources(
+      "Winamax/tc1591/history/20150309_Colorado 1_real_holdem_no-limit.txt"))};
+  site->merge(*pSiteToBeMerged);
+  BOOST_REQUIRE(pSiteToBeMerged->viewHands("tc1591").empty());
+  BOOST_REQUIRE(site->viewHands("unknown player").empty());
+  std::ranges::for_each(site->viewPlayers(), [&site](const Player* pPlayer) {
+    std::vector<const Hand*> expected;
+    std::ranges::for_each(site->viewCashGames(), [&](const CashGame* pGame) {
+      std::ranges::copy_if(pGame->viewHands(), std::back_inserter(expected),
+                           [&](const Hand* pHand) {
+                             return pHand->isPlayerInvolved(pPlayer->getName());
+                           });
+    });
+    const auto hands {site->viewHands(pPlayer->getName())};
+    BOOST_REQUIRE(std::ranges::equal(expected, hands));
+  });
+  BOOST_REQUIRE(15 == site->viewHands("tc1591").size());
+}
+
 BOOST_AUTO_TEST_CASE(WinamaxGameHistoryTest_playerWithNoActionHaveActionNone) {
   const auto& file {pt::getFileFromTestResources(
       "Winamax/simpleCGHisto/history/20150309_Colorado 1_real_holdem_no-limit.txt")};
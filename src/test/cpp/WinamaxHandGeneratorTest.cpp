@@ -0,0 +1,67 @@
+#include "TestInfrastructure.hpp"            // BOOST_* macros, phud::test::*
+#include "entities/Game.hpp"                // CashGame
+#include "entities/Hand.hpp"                // Hand
+#include "entities/Player.hpp"              // Player
+#include "entities/Site.hpp"                // Site
+#include "filesystem/FileUtils.hpp"         // phud::filesystem
+#include "history/WinamaxHandGenerator.hpp" // WinamaxHandGenerator
+#include "history/WinamaxHistoryStream.hpp" // WinamaxHistoryStream
+#include <sstream>                          // std::stringstream
+#include <unordered_set>
+
+namespace pf = phud::filesystem;
+namespace pt = phud::test;
+
+namespace {
+  [[nodiscard]] std::vector<std::string> getColoradoHands() {
+    return WinamaxHandGenerator::splitHands(pf::readToString(pt::getFileFromTestResources(
+        "Winamax/simpleCGHisto/history/20150309_Colorado 1_real_holdem_no-limit.txt")));
+  }
+} // anonymous namespace
+
+BOOST_AUTO_TEST_SUITE(WinamaxHandGeneratorTest)
+
+BOOST_AUTO_TEST_CASE(WinamaxHandGeneratorTest_splittingAHistoryShouldSucceed) {
+  const auto hands {getColoradoHands()};
+  BOOST_REQUIRE(5 == hands.size());
+  BOOST_REQUIRE(std::ranges::all_of(hands, [](const auto& h) {
+    return h.starts_with("Winamax Poker - ");
+  }));
+  BOOST_REQUIRE("Colorado 1" == WinamaxHandGenerator::getTableName(hands[0]));
+  BOOST_REQUIRE(WinamaxHandGenerator::getTableName("Seat 1: Amntfs (4.91€)").empty());
+}
+
+BOOST_AUTO_TEST_CASE(WinamaxHandGeneratorTest_generatedHandsShouldBeDistinctAndParsable) {
+  const auto hands {getColoradoHands()};
+  WinamaxHandGenerator generator {{.hands = hands,
+                                   .tableName = "Replay 1",
+                                   .handIdPrefix = "r1-",
+                                   .nbPlayerGroups = 2}};
+  std::stringstream in;
+
+  for (int i = 0; i < 20; ++i) {
+    in << generator.next();
+  }
+
+  std::unordered_set<std::string> handIds;
+  std::unordered_set<std::string> tableNames;
+  std::unordered_set<std::string> playerNames;
+  const auto nbHands {WinamaxHistoryStream::parse(in, 100, [&](Site& batch) {
+    std::ranges::for_each(batch.viewCashGames(), [&](auto pGame) {
+      std::ranges::for_each(pGame->viewHands(), [&](auto pHand) {
+        handIds.insert(pHand->getId());
+        tableNames.insert(pHand->getTableName());
+      });
+    });
+    std::ranges::for_each(batch.viewPlayers(),
+                          [&](auto pPlayer) { playerNames.insert(pPlayer->getName()); });
+  })};
+  BOOST_REQUIRE(20 == nbHands);
+  BOOST_REQUIRE(20 == handIds.size());
+  BOOST_REQUIRE(std::unordered_set<std::string> {"Replay 1"} == tableNames);
+  BOOST_REQUIRE(playerNames.contains("tc1591_0"));
+  BOOST_REQUIRE(playerNames.contains("tc1591_1"));
+  BOOST_REQUIRE(!playerNames.contains("tc1591"));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,85 @@
+#include "TestInfrastructure.hpp" // BOOST_* macros, phud::test::*
+#include "entities/Game.hpp"      // CashGame, Tournament
+#include "entities/Player.hpp"
+#include "entities/Site.hpp"
+#include "filesystem/FileUtils.hpp"         // phud::filesystem
+#include "history/WinamaxHistoryStream.hpp" // WinamaxHistoryStream
+#include "strings/StringUtils.hpp"          // phud::strings
+#include <sstream>                          // std::stringstream
+#include <unordered_set>
+
+namespace pf = phud::filesystem;
+namespace ps = phud::strings;
+namespace pt = phud::test;
+
+BOOST_AUTO_TEST_SUITE(WinamaxHistoryStreamTest)
+
+BOOST_AUTO_TEST_CASE(WinamaxHistoryStreamTest_guessingTheFileStemShouldSucceed) {
+  BOOST_TEST("20160331_Kill The Fish(152800689)_real_holdem_no-limit" ==
+             WinamaxHistoryStream::toFileStem(
+                 "Winamax Poker - Tournament \"Kill The Fish\" buyIn: 0,45€ + 0,45€ + 0,10€ level: "
+                 "0 - HandId: #656273962061267001-10-1459450429 - Holdem no limit (25/50) - "
+                 "2016/03/31 18:53:49 UTC",
+                 "Table: 'Kill The Fish(152800689)#056' 6-max (real money) Seat #3 is the button")
+                 .value_or(""));
+  BOOST_TEST("20180304_Ferrare 04_play_omaha5_pot-limit" ==
+             WinamaxHistoryStream::toFileStem(
+                 "Winamax Poker - CashGame - HandId: #10911014-57-1520182169 - 5 Card Omaha pot "
+                 "limit (0.01€/0.02€) - 2018/03/04 16:49:29 UTC",
+                 "Table: 'Ferrare 04' 5-max (play money) Seat #1 is the button")
+                 .value_or(""));
+  BOOST_TEST(!WinamaxHistoryStream::toFileStem("Seat 1: lemonchelo69 (9900)", "").has_value());
+}
+
+BOOST_AUTO_TEST_CASE(WinamaxHistoryStreamTest_parsingConcatenatedHistoriesShouldSucceed) {
+  std::stringstream in;
+  in << pf::readToString(pt::getFileFromTestResources(
+            "Winamax/simpleCGHisto/history/20150309_Colorado 1_real_holdem_no-limit.txt"))
+     << pf::readToString(pt::getFileFromTestResources(
+            "Winamax/simpleTHisto/history/20160331_Kill The "
+            "Fish(152800689)_real_holdem_no-limit.txt"));
+  std::size_t nbBatches {0};
+  std::size_t nbHands {0};
+  std::unordered_set<std::string> gameIds;
+  std::unordered_set<std::string> playerNames;
+  const auto nbHandsRead {WinamaxHistoryStream::parse(in, 100, [&](Site& batch) {
+    ++nbBatches;
+    std::ranges::for_each(batch.viewCashGames(), [&](auto pGame) {
+      nbHands += pGame->viewHands().size();
+      gameIds.insert(pGame->getId());
+    });
+    std::ranges::for_each(batch.viewTournaments(), [&](auto pGame) {
+      nbHands += pGame->viewHands().size();
+      gameIds.insert(pGame->getId());
+    });
+    std::ranges::for_each(batch.viewPlayers(),
+                          [&](auto pPlayer) { playerNames.insert(pPlayer->getName()); });
+  })};
+  BOOST_REQUIRE(221 == nbHandsRead);
+  BOOST_REQUIRE(221 == nbHands);
+  BOOST_REQUIRE(3 == nbBatches);
+  BOOST_REQUIRE(2 == gameIds.size());
+  BOOST_REQUIRE(gameIds.contains("20150309_Colorado 1_real_holdem_no-limit"));
+  BOOST_REQUIRE(gameIds.contains("20160331_Kill The Fish(152800689)_real_holdem_no-limit"));
+  BOOST_REQUIRE(30 < playerNames.size());
+}
+
+BOOST_AUTO_TEST_CASE(WinamaxHistoryStreamTest_aGameGoingOnAfterMidnightShouldKeepItsFirstDate) {
+  const auto history {pf::readToString(pt::getFileFromTestResources(
+      "Winamax/simpleCGHisto/history/20150309_Colorado 1_real_holdem_no-limit.txt"))};
+  std::stringstream in;
+  // the last 2 hands are played after midnight, UTC
+  in << ps::replaceAll(ps::replaceAll(history, "2015/03/09 22:22", "2015/03/10 00:02"),
+                       "2015/03/09 22:23", "2015/03/10 00:03");
+  std::unordered_set<std::string> gameIds;
+  const auto nbHandsRead {WinamaxHistoryStream::parse(in, 100, [&](Site& batch) {
+    std::ranges::for_each(batch.viewCashGames(),
+                          [&](auto pGame) { gameIds.insert(pGame->getId()); });
+  })};
+  BOOST_REQUIRE(5 == nbHandsRead);
+  // the game id of the file based import
+  BOOST_REQUIRE((std::unordered_set<std::string> {"20150309_Colorado 1_real_holdem_no-limit"}) ==
+                gameIds);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -3,9 +3,11 @@
 #include "entities/Action.hpp"    // ActionType, Street
 #include "entities/Game.hpp"      // CashGame, Tournament
 #include "entities/Hand.hpp"
+#include "entities/Player.hpp"
 #include "entities/Site.hpp"
 #include "filesystem/FileUtils.hpp" // phud::filesystem
 #include "history/WinamaxHistory.hpp" // PokerSiteHistory, fs::*, std::*, buildTournament, buildCashGame
+#include <ranges> // std::views::take
 #include <unordered_set>
 
 namespace fs = std::filesystem;
@@ -84,8 +86,8 @@ BOOST_AUTO_TEST_CASE(WinamaxHistoryTest_parsingGoodCashGameFileShouldSucceed) {
   BOOST_REQUIRE(21 == players.size());
   std::vector<std::string> actualPlayerNames;
   actualPlayerNames.reserve(players.size());
-  std::transform(players.cbegin(), players.cend(), std::back_inserter(actualPlayerNames),
-                 [](const auto& p) { return p->getName(); });
+  std::ranges::transform(players, std::back_inserter(actualPlayerNames),
+                         [](const auto& p) { return p->getName(); });
   BOOST_REQUIRE(pt::isSet(actualPlayerNames));
   std::vector<std::string> expectedPlayerNames {
       "Akinos",       "Amntfs",      "Baroto",     "JOOL81",     "CtD Jeyje",   "KT-Laplume74",
@@ -116,20 +118,7 @@ BOOST_AUTO_TEST_CASE(WinamaxHistoryTest_parsingGoodCashGameFileShouldSucceed) {
   BOOST_REQUIRE(16 == hands[0]->viewActions().size());
   BOOST_REQUIRE(6 == hands[1]->viewActions().size());
   /* check that the 5 first players folded preflop */
-  const auto actions = hands[1]->viewActions();
-
-#ifdef __clang__
-#  pragma clang diagnostic push
-#  pragma clang diagnostic ignored "-Wunsafe-buffer-usage"
-#endif
-
-  const auto firstFive = std::span(&actions[0], &actions[5]);
-
-#ifdef __clang__
-#  pragma clang diagnostic pop
-#endif
-
-  std::ranges::for_each(firstFive, [](const auto& action) {
+  std::ranges::for_each(hands[1]->viewActions() | std::views::take(5), [](const auto& action) {
     BOOST_REQUIRE(Street::preflop == action->getStreet());
     BOOST_REQUIRE(ActionType::fold == action->getType());
   });
@@ -157,6 +146,27 @@ BOOST_AUTO_TEST_CASE(WinamaxHistoryTest_parsingGoodTournamentFileShouldSucceed)
   BOOST_REQUIRE(30 == pSite->viewPlayers().size());
 }
 
+BOOST_FIXTURE_TEST_CASE(WinamaxHistoryTest_loadingMostRecentFirstShouldHandOverEveryGame,
+                        SabreLaserFixture) {
+  const auto dir = pt::getDirFromTestResources("Winamax/sabre_laser");
+  WinamaxHistory wh;
+  std::size_t nbBatches {0};
+  std::size_t nbTournaments {0};
+  std::unordered_set<std::string> playerNames;
+  const auto pSite {wh.load(dir, nullptr, nullptr, ImportOrder::mostRecentFirst,
+                            [&](Site& batch) {
+                              ++nbBatches;
+                              nbTournaments += batch.viewTournaments().size();
+                              std::ranges::for_each(batch.viewPlayers(), [&](auto p) {
+                                playerNames.insert(p->getName());
+                              });
+                            })};
+  BOOST_REQUIRE(0 < nbBatches);
+  BOOST_REQUIRE(pSite->viewTournaments().empty());
+  BOOST_REQUIRE(pSabreLaserSite->viewTournaments().size() == nbTournaments);
+  BOOST_REQUIRE(pSabreLaserSite->viewPlayers().size() == playerNames.size());
+}
+
 BOOST_AUTO_TEST_CASE(WinamaxHistoryTest_shouldDetectInvalidHistoryDirectory) {
   pt::LogDisabler dummy;
   BOOST_REQUIRE(false == PokerSiteHistory::isValidHistory(pt::getTestResourcesDir()));